@@ -9,6 +9,7 @@ class Stream  // : public Print
 {
  public:
   virtual ~Stream() {}
+  virtual int available() = 0;
   virtual int read() = 0;
   virtual size_t readBytes(char* buffer, size_t length) = 0;
 };
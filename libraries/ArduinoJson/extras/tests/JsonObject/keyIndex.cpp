@@ -0,0 +1,186 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+
+using ArduinoJson::detail::ObjectIndex;
+using ArduinoJson::detail::SlotId;
+
+// Members are named "member0", "member1"... and hold their number
+static std::string memberKey(int i) {
+  return "member" + std::to_string(i);
+}
+
+static void fill(JsonObject obj, int from, int to) {
+  for (int i = from; i < to; i++)
+    obj[memberKey(i)] = i;
+}
+
+static void requireMembers(JsonObject obj, int from, int to) {
+  for (int i = from; i < to; i++)
+    REQUIRE(obj[memberKey(i)] == i);
+}
+
+static size_t sizeofIndexList() {
+  return 4 * sizeof(ObjectIndex);
+}
+
+static size_t sizeofKeyTable(size_t capacity) {
+  return capacity * sizeof(SlotId);
+}
+
+TEST_CASE("JsonObject key index") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+  JsonObject obj = doc.to<JsonObject>();
+
+  SECTION("Not created below the threshold") {
+    fill(obj, 0, ARDUINOJSON_OBJECT_INDEX_THRESHOLD - 1);
+    spy.clearLog();
+
+    REQUIRE(obj["missing"].isNull());
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("Created on the first lookup above the threshold") {
+    fill(obj, 0, ARDUINOJSON_OBJECT_INDEX_THRESHOLD);
+    spy.clearLog();
+
+    REQUIRE(obj["missing"].isNull());
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofIndexList()),
+                             Allocate(sizeofKeyTable(64)),
+                         });
+
+    spy.clearLog();
+    requireMembers(obj, 0, ARDUINOJSON_OBJECT_INDEX_THRESHOLD);
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("Follows the members added after its creation") {
+    fill(obj, 0, 40);
+    REQUIRE(obj["missing"].isNull());
+    fill(obj, 40, 300);
+
+    requireMembers(obj, 0, 300);
+    REQUIRE(obj["missing"].isNull());
+  }
+
+  SECTION("Dropped when a member is removed") {
+    fill(obj, 0, 40);
+    REQUIRE(obj["missing"].isNull());
+    spy.clearLog();
+
+    obj.remove(memberKey(10));
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofKeyTable(128)),
+                             Deallocate(sizeofIndexList()),
+                             Deallocate(sizeofString("member10")),
+                         });
+    REQUIRE(obj[memberKey(10)].isNull());
+    requireMembers(obj, 0, 10);
+    requireMembers(obj, 11, 40);
+  }
+
+  SECTION("Dropped when the object is cleared") {
+    fill(obj, 0, 40);
+    REQUIRE(obj["missing"].isNull());
+
+    obj.clear();
+    REQUIRE(obj["member0"].isNull());
+
+    fill(obj, 100, 140);
+    requireMembers(obj, 100, 140);
+  }
+
+  SECTION("Released with the document") {
+    fill(obj, 0, 40);
+    REQUIRE(obj["missing"].isNull());
+
+    doc.clear();
+    REQUIRE(spy.allocatedBytes() == 0);
+  }
+
+  SECTION("Indexes nested objects separately") {
+    JsonObject a = obj["a"].to<JsonObject>();
+    JsonObject b = obj["b"].to<JsonObject>();
+    fill(a, 0, 40);
+    fill(b, 20, 60);
+
+    REQUIRE(a[memberKey(50)].isNull());
+    REQUIRE(b[memberKey(10)].isNull());
+    requireMembers(a, 0, 40);
+    requireMembers(b, 20, 60);
+  }
+
+  SECTION("Keeps the first of duplicate keys") {
+    std::string input("\xDE\x00\x64", 3);  // map16 with 100 entries
+    for (int i = 0; i < 100; i++) {
+      auto key = memberKey(i < 99 ? i : 0);
+      input += char(0xA0 | key.size()) + key + char(i);  // fixstr, fixint
+    }
+    REQUIRE(deserializeMsgPack(doc, input) == DeserializationError::Ok);
+    obj = doc.as<JsonObject>();
+
+    REQUIRE(obj["member0"] == 0);  // builds the index
+    REQUIRE(obj["member0"] == 0);
+    requireMembers(obj, 0, 99);
+  }
+}
+
+TEST_CASE("JsonObject key index with deserializeJson()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  std::string input = "{";
+  for (int i = 0; i < 200; i++) {
+    auto key = memberKey(i);
+    input += "\"" + key + "\":" + std::to_string(i) + ",";
+  }
+  input += "\"member0\":0}";  // duplicate key
+  REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+
+  SECTION("Not created by the duplicate key check") {
+    JsonObject obj = doc.as<JsonObject>();
+    REQUIRE(obj.size() == 200);
+    spy.clearLog();
+
+    REQUIRE(obj["missing"].isNull());
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofIndexList()),
+                             Allocate(sizeofKeyTable(512)),
+                         });
+    requireMembers(obj, 0, 200);
+  }
+}
+
+TEST_CASE("JsonObject key index allocation fails") {
+  KillswitchAllocator killswitch;
+  JsonDocument doc(&killswitch);
+  JsonObject obj = doc.to<JsonObject>();
+
+  SECTION("When creating the index") {
+    fill(obj, 0, 40);
+    killswitch.on();
+
+    requireMembers(obj, 0, 40);
+    REQUIRE(obj["missing"].isNull());
+  }
+
+  SECTION("When growing the index") {
+    fill(obj, 0, 32);
+    REQUIRE(obj["missing"].isNull());
+    fill(obj, 32, 40);
+    killswitch.on();
+
+    requireMembers(obj, 0, 40);
+    REQUIRE(obj["missing"].isNull());
+  }
+}
@@ -0,0 +1,35 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_ENABLE_ARDUINO_STRING 1
+#define ARDUINOJSON_ENABLE_PROGMEM 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+#include <string>
+
+TEST_CASE("deserializeJson(struct, JsonSchema) with Arduino String") {
+  struct Label {
+    ::String text;
+  };
+  static const auto labelSchema =
+      jsonSchema<Label>(jsonField("text", &Label::text, "none"));
+  Label label;
+
+  SECTION("Default") {
+    REQUIRE(deserializeJson(label, labelSchema, "{}") ==
+            DeserializationError::Ok);
+    REQUIRE(label.text == "none");
+  }
+
+  SECTION("Long string") {
+    std::string text(200, 'x');
+    std::string input = "{\"text\":\"" + text + "\"}";
+
+    REQUIRE(deserializeJson(label, labelSchema, input) ==
+            DeserializationError::Ok);
+    REQUIRE(text == label.text);
+  }
+}
@@ -0,0 +1,33 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson.h>
+
+#include <string>
+
+struct Network {
+  char ssid[16];
+  uint16_t port;
+  bool dhcp;
+};
+
+struct Config {
+  Network network;
+  float gain;
+  int32_t offsets[3];
+  std::string name;
+  long long serial;
+};
+
+constexpr auto networkSchema = jsonSchema<Network>(
+    jsonField("ssid", &Network::ssid, "guest"),
+    jsonField("port", &Network::port, 80), jsonField("dhcp", &Network::dhcp));
+
+constexpr auto configSchema = jsonSchema<Config>(
+    jsonField("network", &Config::network, networkSchema),
+    jsonField("gain", &Config::gain, 1.5f),
+    jsonField("offsets", &Config::offsets), jsonField("name", &Config::name),
+    jsonField("serial", &Config::serial));
@@ -0,0 +1,167 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+#include "config.hpp"
+
+TEST_CASE("deserializeJson(struct, JsonSchema)") {
+  Config config = {};
+
+  SECTION("Fills every member") {
+    auto err = deserializeJson(config, configSchema,
+                               "{\"network\":{\"ssid\":\"home\",\"port\":8080,"
+                               "\"dhcp\":true},\"gain\":2.5,"
+                               "\"offsets\":[1,-2,3],\"name\":\"probe\","
+                               "\"serial\":123456789012}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(config.network.ssid == std::string("home"));
+    REQUIRE(config.network.port == 8080);
+    REQUIRE(config.network.dhcp == true);
+    REQUIRE(config.gain == 2.5f);
+    REQUIRE(config.offsets[0] == 1);
+    REQUIRE(config.offsets[1] == -2);
+    REQUIRE(config.offsets[2] == 3);
+    REQUIRE(config.name == "probe");
+    REQUIRE(config.serial == 123456789012);
+  }
+
+  SECTION("Applies the defaults of the missing keys") {
+    config.name = "unchanged";
+    config.network.dhcp = true;
+
+    auto err = deserializeJson(config, configSchema, "{}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(config.network.ssid == std::string("guest"));
+    REQUIRE(config.network.port == 80);
+    REQUIRE(config.network.dhcp == true);  // no default
+    REQUIRE(config.gain == 1.5f);
+    REQUIRE(config.name == "unchanged");  // no default
+  }
+
+  SECTION("Skips unknown keys, including nested values") {
+    auto err = deserializeJson(
+        config, configSchema,
+        "{\"x\":{\"gain\":9,\"y\":[{},[]]},\"gain\":3,\"z\":[1,{\"a\":2}]}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(config.gain == 3.0f);
+  }
+
+  SECTION("Skips values of the wrong type") {
+    auto err = deserializeJson(
+        config, configSchema,
+        "{\"gain\":\"high\",\"network\":[1],\"name\":42,\"offsets\":{\"a\":1},"
+        "\"serial\":null}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(config.gain == 1.5f);
+    REQUIRE(config.network.port == 80);
+    REQUIRE(config.name == "");
+    REQUIRE(config.serial == 0);
+  }
+
+  SECTION("Truncates strings to the size of the array") {
+    auto err = deserializeJson(
+        config, configSchema,
+        "{\"network\":{\"ssid\":\"0123456789ABCDEFGH\"}}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(config.network.ssid == std::string("0123456789ABCDE"));
+  }
+
+  SECTION("Ignores extra array elements") {
+    auto err =
+        deserializeJson(config, configSchema, "{\"offsets\":[1,2,3,[4],5]}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(config.offsets[2] == 3);
+  }
+
+  SECTION("Stops after the object") {
+    std::istringstream input("{\"gain\":4} {\"gain\":5}");
+
+    REQUIRE(deserializeJson(config, configSchema, input) ==
+            DeserializationError::Ok);
+    REQUIRE(config.gain == 4.0f);
+    REQUIRE(deserializeJson(config, configSchema, input) ==
+            DeserializationError::Ok);
+    REQUIRE(config.gain == 5.0f);
+  }
+
+  SECTION("Input with size") {
+    const char* input = "{\"gain\":6}xxx";
+
+    REQUIRE(deserializeJson(config, configSchema, input, 10) ==
+            DeserializationError::Ok);
+    REQUIRE(config.gain == 6.0f);
+  }
+
+  SECTION("std::string input") {
+    std::string input = "{\"gain\":7}";
+
+    REQUIRE(deserializeJson(config, configSchema, input) ==
+            DeserializationError::Ok);
+    REQUIRE(config.gain == 7.0f);
+  }
+
+  SECTION("Errors") {
+    REQUIRE(deserializeJson(config, configSchema, "") ==
+            DeserializationError::EmptyInput);
+    REQUIRE(deserializeJson(config, configSchema, "{\"gain\":") ==
+            DeserializationError::IncompleteInput);
+    REQUIRE(deserializeJson(config, configSchema, "[]") ==
+            DeserializationError::InvalidInput);
+    REQUIRE(deserializeJson(config, configSchema, "{\"gain\" 1}") ==
+            DeserializationError::InvalidInput);
+    REQUIRE(deserializeJson(config, configSchema,
+                            "{\"a\":[[[[[[[[[[[]]]]]]]]]]]}") ==
+            DeserializationError::TooDeep);
+  }
+
+  SECTION("Skips unknown keys with long strings") {
+    std::string input = "{\"gain\":5,\"comment\":\"" + std::string(100, 'x') +
+                        "\",\"name\":\"abc\"}";
+
+    REQUIRE(deserializeJson(config, configSchema, input) ==
+            DeserializationError::Ok);
+    REQUIRE(config.gain == 5.0f);
+    REQUIRE(config.name == "abc");
+  }
+
+  SECTION("Skips long strings of the wrong type") {
+    std::string input =
+        "{\"gain\":\"" + std::string(100, 'x') + "\",\"serial\":1}";
+
+    REQUIRE(deserializeJson(config, configSchema, input) ==
+            DeserializationError::Ok);
+    REQUIRE(config.gain == 1.5f);
+    REQUIRE(config.serial == 1);
+  }
+
+  SECTION("std::string members have no length limit") {
+    std::string name(300, 'x');
+    name[150] = 'y';
+    std::string input = "{\"name\":\"" + name + "\\u00e9\"}";
+
+    REQUIRE(deserializeJson(config, configSchema, input) ==
+            DeserializationError::Ok);
+    REQUIRE(config.name == name + "\xC3\xA9");
+  }
+
+  SECTION("Truncates long strings to the size of the array") {
+    std::string input =
+        "{\"network\":{\"ssid\":\"" + std::string(100, 'x') + "\"}}";
+
+    REQUIRE(deserializeJson(config, configSchema, input) ==
+            DeserializationError::Ok);
+    REQUIRE(config.network.ssid == std::string(15, 'x'));
+  }
+}
@@ -0,0 +1,63 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string.h>
+
+#include "config.hpp"
+
+struct Wide {
+  int a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, b0, b1, b2, b3, b4, b5, b6, b7,
+      b8, b9, c0, c1, c2, c3, c4, c5, c6, c7, c8, c9, d0, d1;
+};
+
+#define FIELD(name) jsonField(#name, &Wide::name)
+
+constexpr auto wideSchema = jsonSchema<Wide>(
+    FIELD(a0), FIELD(a1), FIELD(a2), FIELD(a3), FIELD(a4), FIELD(a5),
+    FIELD(a6), FIELD(a7), FIELD(a8), FIELD(a9), FIELD(b0), FIELD(b1),
+    FIELD(b2), FIELD(b3), FIELD(b4), FIELD(b5), FIELD(b6), FIELD(b7),
+    FIELD(b8), FIELD(b9), FIELD(c0), FIELD(c1), FIELD(c2), FIELD(c3),
+    FIELD(c4), FIELD(c5), FIELD(c6), FIELD(c7), FIELD(c8), FIELD(c9),
+    FIELD(d0), FIELD(d1));
+
+constexpr auto emptySchema = jsonSchema<Wide>();
+
+static int find(const char* key) {
+  return configSchema.find(key, strlen(key));
+}
+
+TEST_CASE("JsonSchema::find()") {
+  SECTION("Returns the index of each key") {
+    REQUIRE(find("network") == 0);
+    REQUIRE(find("gain") == 1);
+    REQUIRE(find("offsets") == 2);
+    REQUIRE(find("name") == 3);
+    REQUIRE(find("serial") == 4);
+  }
+
+  SECTION("Returns -1 for other keys") {
+    REQUIRE(find("") == -1);
+    REQUIRE(find("nam") == -1);
+    REQUIRE(find("names") == -1);
+    REQUIRE(find("Gain") == -1);
+    REQUIRE(configSchema.find("name\0x", 6) == -1);
+  }
+
+  SECTION("32 fields") {
+    const char* keys[] = {"a0", "a1", "a2", "a3", "a4", "a5", "a6", "a7",
+                          "a8", "a9", "b0", "b1", "b2", "b3", "b4", "b5",
+                          "b6", "b7", "b8", "b9", "c0", "c1", "c2", "c3",
+                          "c4", "c5", "c6", "c7", "c8", "c9", "d0", "d1"};
+    for (int i = 0; i < 32; i++)
+      REQUIRE(wideSchema.find(keys[i], 2) == i);
+    REQUIRE(wideSchema.find("d2", 2) == -1);
+  }
+
+  SECTION("No fields") {
+    REQUIRE(emptySchema.find("a0", 2) == -1);
+  }
+}
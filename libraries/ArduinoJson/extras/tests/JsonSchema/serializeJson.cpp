@@ -0,0 +1,68 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string.h>
+#include <string>
+
+#include "config.hpp"
+
+TEST_CASE("serializeJson(struct, JsonSchema)") {
+  Config config = {{"home", 8080, true}, 2.5f, {1, -2, 3}, "probe", -42};
+
+  SECTION("std::string") {
+    std::string output;
+
+    size_t n = serializeJson(config, configSchema, output);
+
+    REQUIRE(output ==
+            "{\"network\":{\"ssid\":\"home\",\"port\":8080,\"dhcp\":true},"
+            "\"gain\":2.5,\"offsets\":[1,-2,3],\"name\":\"probe\","
+            "\"serial\":-42}");
+    REQUIRE(n == output.size());
+  }
+
+  SECTION("char array") {
+    char output[64];
+
+    size_t n = serializeJson(config.network, networkSchema, output);
+
+    REQUIRE(output == std::string("{\"ssid\":\"home\",\"port\":8080,"
+                                  "\"dhcp\":true}"));
+    REQUIRE(n == 39);
+  }
+
+  SECTION("Truncated buffer") {
+    char output[8];
+
+    size_t n = serializeJson(config.network, networkSchema, output, 8);
+
+    REQUIRE(n == 8);
+  }
+
+  SECTION("Escapes strings") {
+    strcpy(config.network.ssid, "a\"b\\c\n");
+    std::string output;
+
+    serializeJson(config.network, networkSchema, output);
+
+    REQUIRE(output ==
+            "{\"ssid\":\"a\\\"b\\\\c\\n\",\"port\":8080,\"dhcp\":true}");
+  }
+
+  SECTION("Round trip") {
+    std::string json;
+    serializeJson(config, configSchema, json);
+
+    Config copy = {};
+    REQUIRE(deserializeJson(copy, configSchema, json) ==
+            DeserializationError::Ok);
+
+    std::string json2;
+    serializeJson(copy, configSchema, json2);
+    REQUIRE(json2 == json);
+  }
+}
@@ -0,0 +1,84 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <stdio.h>
+#include <string>
+
+#include "trace.hpp"
+
+TEST_CASE("JsonStreamParser with partial input") {
+  SECTION("Same events for any chunk size") {
+    std::string input =
+        "{\"name\":\"caf\\u00e9\",'tags':[true,false,null],"
+        " id:-12.5e-1,\"nested\":{\"a\":[[],{}]}}";
+    std::string expected = trace(input);
+    REQUIRE(expected ==
+            "{ K:name S:caf\xC3\xA9 K:tags [ true false null ] K:id N:-12.5e-1 "
+            "K:nested { K:a [ [ ] { } ] } }");
+
+    for (size_t chunkSize = 1; chunkSize < input.size(); chunkSize++) {
+      CAPTURE(chunkSize);
+      REQUIRE(trace(input, chunkSize) == expected);
+    }
+  }
+
+  SECTION("A number at the root needs finish()") {
+    JsonStreamParser<> parser;
+    parser.feed("12", 2);
+    REQUIRE(parser.next() == JsonEvent::None);
+    parser.feed("34", 2);
+    REQUIRE(parser.next() == JsonEvent::None);
+    REQUIRE(parser.error() == DeserializationError::Ok);
+
+    parser.finish();
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE(parser.as<int>() == 1234);
+    REQUIRE(parser.done() == true);
+  }
+
+  SECTION("Waits for more input without error") {
+    JsonStreamParser<> parser;
+    parser.feed("{\"ke", 4);
+
+    REQUIRE(parser.next() == JsonEvent::BeginObject);
+    REQUIRE(parser.next() == JsonEvent::None);
+    REQUIRE(parser.error() == DeserializationError::Ok);
+    REQUIRE(parser.done() == false);
+
+    parser.feed("y\":1}", 5);
+    REQUIRE(parser.next() == JsonEvent::Key);
+    REQUIRE(parser.text() == "key");
+  }
+
+  SECTION("Large document with a small fixed footprint") {
+    JsonStreamParser<16> parser;
+    size_t count = 0;
+    double sum = 0;
+    auto feed = [&](const char* data, size_t size) {
+      parser.feed(data, size);
+      JsonEvent event;
+      while ((event = parser.next()) != JsonEvent::None) {
+        if (event == JsonEvent::Number) {
+          sum += parser.as<double>();
+          count++;
+        }
+      }
+    };
+
+    feed("[", 1);
+    for (int i = 0; i < 10000; i++) {
+      char chunk[32];
+      int n = snprintf(chunk, sizeof(chunk), "{\"lat\":%d.5},", i);
+      feed(chunk, size_t(n));
+    }
+    feed("0]", 2);
+
+    REQUIRE(parser.done() == true);
+    REQUIRE(count == 10001);
+    REQUIRE(sum == Approx(10000 * 9999 / 2 + 5000));
+  }
+}
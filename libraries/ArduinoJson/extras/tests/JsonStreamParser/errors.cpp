@@ -0,0 +1,73 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "trace.hpp"
+
+TEST_CASE("JsonStreamParser errors") {
+  SECTION("EmptyInput") {
+    REQUIRE(trace("") == "!EmptyInput");
+    REQUIRE(trace("  ") == "!EmptyInput");
+  }
+
+  SECTION("IncompleteInput") {
+    REQUIRE(trace("[") == "[ !IncompleteInput");
+    REQUIRE(trace("{\"a\"") == "{ K:a !IncompleteInput");
+    REQUIRE(trace("\"hello") == "!IncompleteInput");
+    REQUIRE(trace("tru") == "!IncompleteInput");
+    REQUIRE(trace("[1") == "[ N:1 !IncompleteInput");
+  }
+
+  SECTION("InvalidInput") {
+    REQUIRE(trace("[1 2]") == "[ N:1 !InvalidInput");
+    REQUIRE(trace("[1,]") == "[ N:1 !InvalidInput");
+    REQUIRE(trace("{\"a\" 1}") == "{ K:a !InvalidInput");
+    REQUIRE(trace("{\"a\":1]") == "{ K:a N:1 !InvalidInput");
+    REQUIRE(trace("{,}") == "{ !InvalidInput");
+    REQUIRE(trace("[trux]") == "[ !InvalidInput");
+    REQUIRE(trace("[-]") == "[ !InvalidInput");
+    REQUIRE(trace("\"\\x\"") == "!InvalidInput");
+    REQUIRE(trace("\"\\u12G4\"") == "!InvalidInput");
+  }
+
+  SECTION("TooDeep") {
+    JsonStreamParser<64, 2> parser;
+    REQUIRE(trace(parser, "[[1]]") == "[ [ N:1 ] ]");
+    parser.reset();
+    REQUIRE(trace(parser, "[{\"a\":[]}]") == "[ { K:a !TooDeep");
+  }
+
+  SECTION("Default nesting limit") {
+    std::string input(ARDUINOJSON_DEFAULT_NESTING_LIMIT, '[');
+    input += std::string(ARDUINOJSON_DEFAULT_NESTING_LIMIT, ']');
+    JsonStreamParser<> parser;
+    REQUIRE(trace(parser, input).find('!') == std::string::npos);
+
+    parser.reset();
+    REQUIRE(trace(parser, "[" + input + "]").find("!TooDeep") !=
+            std::string::npos);
+  }
+
+  SECTION("NoMemory when a token is larger than TextSize") {
+    REQUIRE(trace<4>("[\"abcd\"]") == "[ S:abcd ]");
+    REQUIRE(trace<4>("[\"abcde\"]") == "[ !NoMemory");
+    REQUIRE(trace<4>("{\"abcde\":1}") == "{ !NoMemory");
+    REQUIRE(trace<4>("{abcde:1}") == "{ !NoMemory");
+    REQUIRE(trace<4>("[12345]") == "[ !NoMemory");
+    REQUIRE(trace<4>("[true,false,null]") == "[ true false null ]");
+  }
+
+  SECTION("Stops at the first error") {
+    JsonStreamParser<> parser;
+    parser.feed("[1,]", 4);
+    while (parser.next() != JsonEvent::None) {
+    }
+    REQUIRE(parser.error() == DeserializationError::InvalidInput);
+
+    parser.feed("[1]", 3);
+    REQUIRE(parser.next() == JsonEvent::None);
+  }
+}
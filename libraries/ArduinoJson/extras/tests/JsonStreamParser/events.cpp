@@ -0,0 +1,119 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "trace.hpp"
+
+TEST_CASE("JsonStreamParser events") {
+  SECTION("Values at the root") {
+    REQUIRE(trace("\"hello\"") == "S:hello");
+    REQUIRE(trace("'hello'") == "S:hello");
+    REQUIRE(trace("42") == "N:42");
+    REQUIRE(trace("-1.5e3") == "N:-1.5e3");
+    REQUIRE(trace("true") == "true");
+    REQUIRE(trace("false") == "false");
+    REQUIRE(trace("null") == "null");
+  }
+
+  SECTION("Empty containers") {
+    REQUIRE(trace("[]") == "[ ]");
+    REQUIRE(trace("{}") == "{ }");
+    REQUIRE(trace(" [ ] ") == "[ ]");
+    REQUIRE(trace(" { } ") == "{ }");
+  }
+
+  SECTION("Array") {
+    REQUIRE(trace("[1,\"a\",true,false,null]") ==
+            "[ N:1 S:a true false null ]");
+  }
+
+  SECTION("Object") {
+    REQUIRE(trace("{\"a\":1,\"b\":\"x\",\"c\":null}") ==
+            "{ K:a N:1 K:b S:x K:c null }");
+  }
+
+  SECTION("Keys without quotes or with single quotes") {
+    REQUIRE(trace("{a:1,'b':2}") == "{ K:a N:1 K:b N:2 }");
+  }
+
+  SECTION("Nested containers") {
+    REQUIRE(trace("{\"a\":[1,{\"b\":[]}],\"c\":{}}") ==
+            "{ K:a [ N:1 { K:b [ ] } ] K:c { } }");
+  }
+
+  SECTION("Whitespace") {
+    REQUIRE(trace(" \t\r\n{ \"a\" : [ 1 , 2 ] }\n") == "{ K:a [ N:1 N:2 ] }");
+  }
+
+  SECTION("Escape sequences") {
+    REQUIRE(trace("\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"") == "S:\"\\/\b\f\n\r\t");
+  }
+
+  SECTION("Unicode escape sequences") {
+    REQUIRE(trace("\"\\u00e9\\u20AC\"") == "S:\xC3\xA9\xE2\x82\xAC");
+    REQUIRE(trace("\"\\uD83D\\uDE00\"") == "S:\xF0\x9F\x98\x80");
+  }
+
+  SECTION("Escaped null in a string") {
+    JsonStreamParser<> parser;
+    parser.feed("\"a\\u0000b\"", 10);
+    REQUIRE(parser.next() == JsonEvent::String);
+    REQUIRE(parser.text().size() == 3);
+  }
+
+  SECTION("Stops after the root value") {
+    JsonStreamParser<> parser;
+    parser.feed("{}[]", 4);
+
+    REQUIRE(parser.next() == JsonEvent::BeginObject);
+    REQUIRE(parser.next() == JsonEvent::EndObject);
+    REQUIRE(parser.next() == JsonEvent::None);
+    REQUIRE(parser.done() == true);
+    REQUIRE(parser.error() == DeserializationError::Ok);
+    REQUIRE(parser.remaining() == 2);
+  }
+
+  SECTION("reset() starts a new document") {
+    JsonStreamParser<> parser;
+    parser.feed("[1]{}", 5);
+    while (parser.next() != JsonEvent::None) {
+    }
+    size_t offset = 5 - parser.remaining();
+
+    parser.reset();
+    REQUIRE(trace(parser, std::string("[1]{}").substr(offset)) == "{ }");
+  }
+
+  SECTION("depth()") {
+    JsonStreamParser<> parser;
+    parser.feed("[[1]]", 5);
+
+    REQUIRE(parser.next() == JsonEvent::BeginArray);
+    REQUIRE(parser.depth() == 1);
+    REQUIRE(parser.next() == JsonEvent::BeginArray);
+    REQUIRE(parser.depth() == 2);
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE(parser.depth() == 2);
+    REQUIRE(parser.next() == JsonEvent::EndArray);
+    REQUIRE(parser.depth() == 1);
+    REQUIRE(parser.next() == JsonEvent::EndArray);
+    REQUIRE(parser.depth() == 0);
+  }
+
+  SECTION("as<T>()") {
+    JsonStreamParser<> parser;
+    parser.feed("[42,-3.5,1e2]", 13);
+
+    REQUIRE(parser.next() == JsonEvent::BeginArray);
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE(parser.as<int>() == 42);
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE(parser.as<float>() == -3.5f);
+    REQUIRE(parser.as<int>() == -3);
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE(parser.as<double>() == 100.0);
+  }
+}
@@ -0,0 +1,101 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "trace.hpp"
+
+// Returns the events, calling skipValue() after the Key event of "skip"
+static std::string traceSkipping(const std::string& input,
+                                 size_t chunkSize = 0) {
+  JsonStreamParser<8> parser;
+  std::string result;
+  if (chunkSize == 0)
+    chunkSize = input.size();
+  for (size_t i = 0; i < input.size(); i += chunkSize) {
+    size_t n = input.size() - i < chunkSize ? input.size() - i : chunkSize;
+    parser.feed(input.data() + i, n);
+    JsonEvent event;
+    while ((event = parser.next()) != JsonEvent::None) {
+      if (event == JsonEvent::Key) {
+        std::string key(parser.text().c_str(), parser.text().size());
+        result += "K:" + key + ' ';
+        if (key == "skip")
+          parser.skipValue();
+      } else {
+        result += event == JsonEvent::Number ? "N " : "? ";
+      }
+    }
+  }
+  parser.finish();
+  while (parser.next() != JsonEvent::None) {
+  }
+  if (parser.error())
+    result += std::string("!") + parser.error().c_str();
+  return result;
+}
+
+TEST_CASE("JsonStreamParser::skipValue()") {
+  SECTION("Skips the value after a key") {
+    REQUIRE(traceSkipping("{\"skip\":1,\"a\":2}") == "? K:skip K:a N ? ");
+    REQUIRE(traceSkipping("{\"skip\":[1,{\"b\":2}],\"a\":2}") ==
+            "? K:skip K:a N ? ");
+    REQUIRE(traceSkipping("{\"a\":{\"skip\":{}},\"b\":2}") ==
+            "? K:a ? K:skip ? K:b N ? ");
+  }
+
+  SECTION("Doesn't store the text of the skipped value") {
+    std::string longString(100, 'x');
+    std::string input = "{\"skip\":{\"" + longString + "\":\"" + longString +
+                        "\",\"n\":" + std::string(100, '1') + "},\"a\":2}";
+
+    REQUIRE(traceSkipping(input) == "? K:skip K:a N ? ");
+    REQUIRE(traceSkipping(input, 3) == "? K:skip K:a N ? ");
+  }
+
+  SECTION("Still detects errors in the skipped value") {
+    REQUIRE(traceSkipping("{\"skip\":[1,}") == "? K:skip !InvalidInput");
+    REQUIRE(traceSkipping("{\"skip\":[[[[[[[[[[[]]]]]]]]]]]}") ==
+            "? K:skip !TooDeep");
+    REQUIRE(traceSkipping("{\"skip\":\"abc") == "? K:skip !IncompleteInput");
+  }
+
+  SECTION("Skips the rest of a container after its Begin event") {
+    JsonStreamParser<> parser;
+    parser.feed("[[1,[2]],3]", 11);
+
+    REQUIRE(parser.next() == JsonEvent::BeginArray);
+    REQUIRE(parser.next() == JsonEvent::BeginArray);
+    parser.skipValue();
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE(parser.as<int>() == 3);
+    REQUIRE(parser.next() == JsonEvent::EndArray);
+  }
+
+  SECTION("Skips the rest of a string after a StringPart event") {
+    JsonStreamParser<4> parser;
+    parser.splitStrings(true);
+    parser.feed("[\"abcdefghij\",3]", 16);
+
+    REQUIRE(parser.next() == JsonEvent::BeginArray);
+    REQUIRE(parser.next() == JsonEvent::StringPart);
+    parser.skipValue();
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE(parser.next() == JsonEvent::EndArray);
+  }
+
+  SECTION("Does nothing after a value") {
+    JsonStreamParser<> parser;
+    parser.feed("[1,2]", 5);
+
+    REQUIRE(parser.next() == JsonEvent::BeginArray);
+    REQUIRE(parser.next() == JsonEvent::Number);
+    parser.skipValue();
+    REQUIRE(parser.next() == JsonEvent::Number);
+    REQUIRE(parser.next() == JsonEvent::EndArray);
+  }
+}
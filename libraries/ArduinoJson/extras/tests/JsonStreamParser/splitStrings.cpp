@@ -0,0 +1,49 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "trace.hpp"
+
+static std::string traceSplit(const std::string& input, size_t chunkSize = 0) {
+  JsonStreamParser<8> parser;
+  parser.splitStrings(true);
+  return trace(parser, input, chunkSize);
+}
+
+TEST_CASE("JsonStreamParser::splitStrings()") {
+  SECTION("Short strings are not split") {
+    REQUIRE(traceSplit("[\"abcd\"]") == "[ S:abcd ]");
+  }
+
+  SECTION("Long strings are reported in pieces") {
+    REQUIRE(traceSplit("[\"abcdefghijklm\"]") == "[ P:abcde P:fghij S:klm ]");
+  }
+
+  SECTION("Same pieces for any chunk size") {
+    for (size_t chunkSize = 1; chunkSize < 6; chunkSize++)
+      REQUIRE(traceSplit("[\"abcdefghijklm\"]", chunkSize) ==
+              "[ P:abcde P:fghij S:klm ]");
+  }
+
+  SECTION("Escape sequences are not split") {
+    REQUIRE(traceSplit("[\"abcd\\u00e9\\ud83d\\ude00\"]") ==
+            "[ P:abcd\xC3\xA9 S:\xF0\x9F\x98\x80 ]");
+  }
+
+  SECTION("Object values") {
+    REQUIRE(traceSplit("{\"a\":\"abcdefgh\"}") == "{ K:a P:abcde S:fgh }");
+  }
+
+  SECTION("Keys are not split") {
+    REQUIRE(traceSplit("{\"abcdefghijklm\":1}") == "{ !NoMemory");
+  }
+
+  SECTION("Disabled by default") {
+    REQUIRE(trace<8>("[\"abcdefghijklm\"]") == "[ !NoMemory");
+  }
+}
@@ -0,0 +1,85 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson.h>
+
+#include <string>
+
+// Feeds the input in chunks of chunkSize bytes and returns the events as text,
+// followed by the error if any, for example "{ K:a N:1 }" or "[ N:1 !TooDeep"
+template <typename TParser>
+std::string trace(TParser& parser, const std::string& input,
+                  size_t chunkSize = 0) {
+  std::string result;
+  auto record = [&]() {
+    JsonEvent event;
+    while ((event = parser.next()) != JsonEvent::None) {
+      if (!result.empty())
+        result += ' ';
+      switch (event) {
+        case JsonEvent::BeginObject:
+          result += '{';
+          break;
+        case JsonEvent::EndObject:
+          result += '}';
+          break;
+        case JsonEvent::BeginArray:
+          result += '[';
+          break;
+        case JsonEvent::EndArray:
+          result += ']';
+          break;
+        case JsonEvent::Key:
+          result += "K:" + std::string(parser.text().c_str(),
+                                       parser.text().size());
+          break;
+        case JsonEvent::String:
+          result += "S:" + std::string(parser.text().c_str(),
+                                       parser.text().size());
+          break;
+        case JsonEvent::StringPart:
+          result += "P:" + std::string(parser.text().c_str(),
+                                       parser.text().size());
+          break;
+        case JsonEvent::Number:
+          result += "N:" + std::string(parser.text().c_str());
+          break;
+        case JsonEvent::True:
+          result += "true";
+          break;
+        case JsonEvent::False:
+          result += "false";
+          break;
+        case JsonEvent::Null:
+          result += "null";
+          break;
+        default:
+          result += '?';
+          break;
+      }
+    }
+  };
+
+  if (chunkSize == 0)
+    chunkSize = input.size() ? input.size() : 1;
+  for (size_t i = 0; i < input.size() && !parser.error(); i += chunkSize) {
+    size_t n = input.size() - i < chunkSize ? input.size() - i : chunkSize;
+    parser.feed(input.data() + i, n);
+    record();
+  }
+  parser.finish();
+  record();
+
+  if (parser.error())
+    result += std::string(result.empty() ? "!" : " !") + parser.error().c_str();
+  return result;
+}
+
+template <size_t TextSize = 64>
+std::string trace(const std::string& input, size_t chunkSize = 0) {
+  JsonStreamParser<TextSize> parser;
+  return trace(parser, input, chunkSize);
+}
@@ -0,0 +1,188 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+// A stream that replays a string, as a network client would receive it:
+// available() only reports the bytes of the current packet.
+class LoopbackStream : public Stream {
+ public:
+  LoopbackStream(std::string data, size_t packetSize = 1000)
+      : data_(data), packetSize_(packetSize), position_(0), calls_(0) {}
+
+  int available() {
+    size_t packetEnd = (position_ / packetSize_ + 1) * packetSize_;
+    if (packetEnd > data_.size())
+      packetEnd = data_.size();
+    return static_cast<int>(packetEnd - position_);
+  }
+
+  int read() {
+    calls_++;
+    return position_ < data_.size()
+               ? static_cast<unsigned char>(data_[position_++])
+               : -1;
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    calls_++;
+    size_t n = 0;
+    while (n < length && position_ < data_.size())
+      buffer[n++] = data_[position_++];
+    return n;
+  }
+
+  std::string remaining() const {
+    return data_.substr(position_);
+  }
+
+  size_t calls() const {
+    return calls_;
+  }
+
+ private:
+  std::string data_;
+  size_t packetSize_;
+  size_t position_;
+  size_t calls_;
+};
+
+static std::string readAll(BufferedStreamReader<8>& reader) {
+  std::string s;
+  int c;
+  while ((c = reader.read()) >= 0)
+    s += static_cast<char>(c);
+  return s;
+}
+
+TEST_CASE("BufferedStreamReader") {
+  SECTION("read() returns each byte, then -1") {
+    LoopbackStream stream("\x01\xFF");
+    BufferedStreamReader<8> reader(stream);
+
+    REQUIRE(reader.read() == 0x01);
+    REQUIRE(reader.read() == 0xFF);
+    REQUIRE(reader.read() == -1);
+  }
+
+  SECTION("peek() doesn't consume the byte") {
+    LoopbackStream stream("AB");
+    BufferedStreamReader<8> reader(stream);
+
+    REQUIRE(reader.peek() == 'A');
+    REQUIRE(reader.peek() == 'A');
+    REQUIRE(reader.read() == 'A');
+    REQUIRE(reader.peek() == 'B');
+  }
+
+  SECTION("Reads no more than what is available") {
+    LoopbackStream stream("ABCDEFGHIJ", 3);
+    BufferedStreamReader<8> reader(stream);
+
+    REQUIRE(reader.read() == 'A');
+    REQUIRE(reader.buffered() == 2);
+    REQUIRE(stream.remaining() == "DEFGHIJ");
+  }
+
+  SECTION("Reads no more than the buffer") {
+    LoopbackStream stream("ABCDEFGHIJ");
+    BufferedStreamReader<8> reader(stream);
+
+    REQUIRE(reader.read() == 'A');
+    REQUIRE(reader.buffered() == 7);
+    REQUIRE(stream.remaining() == "IJ");
+    REQUIRE(readAll(reader) == "BCDEFGHIJ");
+  }
+
+  SECTION("readBytes() takes the buffered bytes first") {
+    LoopbackStream stream("ABCDEFGHIJ", 4);
+    BufferedStreamReader<8> reader(stream);
+    char buffer[8] = "";
+
+    REQUIRE(reader.read() == 'A');
+    REQUIRE(reader.readBytes(buffer, 5) == 5);
+    REQUIRE(std::string(buffer, 5) == "BCDEF");
+    REQUIRE(readAll(reader) == "GHIJ");
+  }
+
+  SECTION("unread() never reads the stream") {
+    LoopbackStream stream("ABCDEFGHIJ", 4);
+    BufferedStreamReader<8> reader(stream);
+    char buffer[8] = "";
+
+    REQUIRE(reader.unread(buffer, 8) == 0);
+    REQUIRE(reader.read() == 'A');
+    REQUIRE(reader.unread(buffer, 8) == 3);
+    REQUIRE(std::string(buffer, 3) == "BCD");
+    REQUIRE(reader.buffered() == 0);
+    REQUIRE(stream.remaining() == "EFGHIJ");
+  }
+}
+
+TEST_CASE("deserializeJson(BufferedStreamReader)") {
+  JsonDocument doc;
+
+  SECTION("Leaves the bytes after the document") {
+    LoopbackStream stream("{\"a\":1}{\"b\":2}\r\nrest");
+    BufferedStreamReader<> reader(stream);
+
+    REQUIRE(deserializeJson(doc, reader) == DeserializationError::Ok);
+    REQUIRE(doc["a"] == 1);
+    REQUIRE(deserializeJson(doc, reader) == DeserializationError::Ok);
+    REQUIRE(doc["b"] == 2);
+
+    REQUIRE(reader.read() == '\r');
+    REQUIRE(reader.read() == '\n');
+    REQUIRE(reader.peek() == 'r');
+    REQUIRE(stream.remaining() == "");
+  }
+
+  SECTION("Consumes the same bytes as the stream") {
+    const char* inputs[] = {"[1,2]  ", "\"hello\"x", "42 43", "{}{}"};
+    for (auto input : inputs) {
+      LoopbackStream unbuffered(input);
+      LoopbackStream buffered(input);
+      BufferedStreamReader<> reader(buffered);
+
+      auto expected = deserializeJson(doc, unbuffered);
+      REQUIRE(deserializeJson(doc, reader) == expected);
+
+      char tail[16];
+      size_t n = reader.unread(tail, sizeof(tail));
+      REQUIRE(std::string(tail, n) + buffered.remaining() ==
+              unbuffered.remaining());
+    }
+  }
+
+  SECTION("Calls the stream once per packet instead of once per byte") {
+    std::string json = "[";
+    for (int i = 0; i < 500; i++)
+      json += "{\"id\":" + std::to_string(i) + ",\"name\":\"item\"},";
+    json += "0]";
+
+    LoopbackStream unbuffered(json, 1460);
+    REQUIRE(deserializeJson(doc, unbuffered) == DeserializationError::Ok);
+
+    LoopbackStream buffered(json, 1460);
+    BufferedStreamReader<128> reader(buffered);
+    REQUIRE(deserializeJson(doc, reader) == DeserializationError::Ok);
+
+    REQUIRE(unbuffered.calls() == json.size());
+    REQUIRE(buffered.calls() <= json.size() / 128 + json.size() / 1460 + 1);
+  }
+
+  SECTION("deserializeMsgPack()") {
+    LoopbackStream stream("\x92\x01\xA5hello\xC0", 4);
+    BufferedStreamReader<4> reader(stream);
+
+    REQUIRE(deserializeMsgPack(doc, reader) == DeserializationError::Ok);
+    REQUIRE(doc[0] == 1);
+    REQUIRE(doc[1] == "hello");
+    REQUIRE(reader.read() == 0xC0);
+  }
+}
@@ -172,6 +172,10 @@ class StreamStub : public Stream {
  public:
   StreamStub(const char* s) : stream_(s) {}
 
+  int available() {
+    return static_cast<int>(stream_.rdbuf()->in_avail());
+  }
+
   int read() {
     return stream_.get();
   }
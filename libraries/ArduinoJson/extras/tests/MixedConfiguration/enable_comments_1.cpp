@@ -6,6 +6,7 @@
 #include <ArduinoJson.h>
 
 #include <catch.hpp>
+#include <string>
 
 TEST_CASE("Comments in arrays") {
   JsonDocument doc;
@@ -409,3 +410,36 @@ TEST_CASE("Comments alone") {
     REQUIRE(err == DeserializationError::IncompleteInput);
   }
 }
+
+TEST_CASE("Comments in JsonStreamParser") {
+  const char* input = "/*a*/[1,// b\n2 /**/]//c\n";
+  JsonStreamParser<> parser;
+  std::string events;
+
+  for (const char* p = input; *p; p++) {  // one byte at a time
+    parser.feed(p, 1);
+    JsonEvent event;
+    while ((event = parser.next()) != JsonEvent::None)
+      events += event == JsonEvent::Number ? parser.text().c_str() : "*";
+  }
+
+  REQUIRE(parser.error() == DeserializationError::Ok);
+  REQUIRE(parser.done() == true);
+  REQUIRE(events == "*12*");
+
+  SECTION("Only comments") {
+    JsonStreamParser<> empty;
+    empty.feed("/* */", 5);
+    empty.finish();
+    REQUIRE(empty.next() == JsonEvent::None);
+    REQUIRE(empty.error() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("Premature end") {
+    JsonStreamParser<> incomplete;
+    incomplete.feed("/* comment", 10);
+    incomplete.finish();
+    REQUIRE(incomplete.next() == JsonEvent::None);
+    REQUIRE(incomplete.error() == DeserializationError::IncompleteInput);
+  }
+}
@@ -0,0 +1,161 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson/Memory/ResourceManager.hpp>
+#include <ArduinoJson/Memory/ResourceManagerImpl.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+#include <catch.hpp>
+
+#include <stdio.h>
+#include <vector>
+
+#include "Allocators.hpp"
+
+using namespace ArduinoJson::detail;
+
+static std::string key(int i) {
+  char buf[8];
+  snprintf(buf, sizeof(buf), "k%03d", i);
+  return buf;
+}
+
+static StringNode* saveKey(ResourceManager& resources, int i) {
+  auto s = key(i);
+  return resources.saveString(adaptString(s.c_str()));
+}
+
+static size_t sizeofIndex(size_t capacity) {
+  return capacity * sizeof(StringNode*);
+}
+
+TEST_CASE("StringPool index") {
+  SpyingAllocator spy;
+  ResourceManager resources(&spy);
+
+  SECTION("Allocated when the pool reaches the threshold") {
+    for (int i = 0; i < ARDUINOJSON_STRING_INDEX_THRESHOLD - 1; i++)
+      saveKey(resources, i);
+    REQUIRE(spy.log() ==
+            AllocatorLog{
+                Allocate(sizeofString("k000")) *
+                    (ARDUINOJSON_STRING_INDEX_THRESHOLD - 1),
+            });
+
+    spy.clearLog();
+    saveKey(resources, ARDUINOJSON_STRING_INDEX_THRESHOLD - 1);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofString("k000")),
+                             Allocate(sizeofIndex(32)),
+                         });
+  }
+
+  SECTION("Grows to keep half of the slots free") {
+    for (int i = 0; i < 33; i++)
+      saveKey(resources, i);
+    spy.clearLog();
+
+    saveKey(resources, 33);
+    REQUIRE(spy.log() == AllocatorLog{Allocate(sizeofString("k000"))});
+  }
+
+  SECTION("Deduplicates every string") {
+    std::vector<StringNode*> nodes;
+    for (int i = 0; i < 300; i++)
+      nodes.push_back(saveKey(resources, i));
+    size_t size = resources.size();
+
+    for (int i = 0; i < 300; i++) {
+      auto node = saveKey(resources, i);
+      REQUIRE(node == nodes[size_t(i)]);
+      REQUIRE(node->references == 2);
+    }
+    REQUIRE(resources.size() == size);
+  }
+
+  SECTION("Finds the remaining strings after removals") {
+    std::vector<StringNode*> nodes;
+    for (int i = 0; i < 100; i++)
+      nodes.push_back(saveKey(resources, i));
+    for (int i = 0; i < 100; i += 3)
+      resources.dereferenceString(nodes[size_t(i)]->data);
+
+    for (int i = 0; i < 100; i++) {
+      auto s = key(i);
+      auto node = resources.getString(adaptString(s.c_str()));
+      if (i % 3 == 0)
+        REQUIRE(node == nullptr);
+      else
+        REQUIRE(node == nodes[size_t(i)]);
+    }
+  }
+
+  SECTION("shrinkToFit() resizes the index") {
+    std::vector<StringNode*> nodes;
+    for (int i = 0; i < 100; i++)
+      nodes.push_back(saveKey(resources, i));
+    for (int i = 0; i < 60; i++)
+      resources.dereferenceString(nodes[size_t(i)]->data);
+    spy.clearLog();
+
+    resources.shrinkToFit();
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofIndex(256)),
+                             Allocate(sizeofIndex(128)),
+                         });
+    for (int i = 60; i < 100; i++)
+      REQUIRE(saveKey(resources, i) == nodes[size_t(i)]);
+  }
+
+  SECTION("shrinkToFit() releases the index below the threshold") {
+    std::vector<StringNode*> nodes;
+    for (int i = 0; i < 20; i++)
+      nodes.push_back(saveKey(resources, i));
+    for (int i = 0; i < 10; i++)
+      resources.dereferenceString(nodes[size_t(i)]->data);
+    spy.clearLog();
+
+    resources.shrinkToFit();
+
+    REQUIRE(spy.log() == AllocatorLog{Deallocate(sizeofIndex(64))});
+    REQUIRE(saveKey(resources, 15) == nodes[15]);
+  }
+
+  SECTION("clear() releases the index") {
+    for (int i = 0; i < 20; i++)
+      saveKey(resources, i);
+    spy.clearLog();
+
+    resources.clear();
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofString("k000")) * 20,
+                             Deallocate(sizeofIndex(64)),
+                         });
+  }
+}
+
+TEST_CASE("StringPool index allocation fails") {
+  struct NoIndexAllocator : ArduinoJson::Allocator {
+    virtual ~NoIndexAllocator() {}
+    void* allocate(size_t n) override {
+      return n >= sizeof(StringNode*) * 32 ? nullptr : malloc(n);
+    }
+    void deallocate(void* p) override {
+      free(p);
+    }
+    void* reallocate(void* p, size_t n) override {
+      return realloc(p, n);
+    }
+  } allocator;
+  ResourceManager resources(&allocator);
+
+  std::vector<StringNode*> nodes;
+  for (int i = 0; i < 100; i++)
+    nodes.push_back(saveKey(resources, i));
+  REQUIRE(resources.overflowed() == false);
+
+  for (int i = 0; i < 100; i++)
+    REQUIRE(saveKey(resources, i) == nodes[size_t(i)]);
+}
@@ -101,6 +101,8 @@ class CollectionData {
   void appendPair(Slot<VariantData> key, Slot<VariantData> value,
                   const ResourceManager* resources);
 
+  static iterator iteratorAt(SlotId id, const ResourceManager* resources);
+
   void removeOne(iterator it, ResourceManager* resources);
   void removePair(iterator it, ResourceManager* resources);
 
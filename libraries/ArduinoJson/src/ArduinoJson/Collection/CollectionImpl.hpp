@@ -30,6 +30,11 @@ inline CollectionData::iterator CollectionData::createIterator(
   return iterator(resources->getVariant(head_), head_);
 }
 
+inline CollectionData::iterator CollectionData::iteratorAt(
+    SlotId id, const ResourceManager* resources) {
+  return iterator(resources->getVariant(id), id);
+}
+
 inline void CollectionData::appendOne(Slot<VariantData> slot,
                                       const ResourceManager* resources) {
   if (tail_ != NULL_SLOT) {
@@ -135,6 +135,28 @@
 #  endif
 #endif
 
+// Number of strings from which the string pool maintains a hash index to
+// deduplicate strings in constant time instead of comparing with every string
+// 0 disables the index (smaller code for 8-bit platforms)
+#ifndef ARDUINOJSON_STRING_INDEX_THRESHOLD
+#  if ARDUINOJSON_SIZEOF_POINTER <= 2
+#    define ARDUINOJSON_STRING_INDEX_THRESHOLD 0
+#  else
+#    define ARDUINOJSON_STRING_INDEX_THRESHOLD 16
+#  endif
+#endif
+
+// Number of members from which an object gets a hash index of its keys on the
+// first lookup, making further lookups constant time
+// 0 disables the index (smaller code for 8-bit platforms)
+#ifndef ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+#  if ARDUINOJSON_SIZEOF_POINTER <= 2
+#    define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 0
+#  else
+#    define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 32
+#  endif
+#endif
+
 // Number of bytes to store the length of a string
 // https://arduinojson.org/v7/config/string_length_size/
 #ifndef ARDUINOJSON_STRING_LENGTH_SIZE
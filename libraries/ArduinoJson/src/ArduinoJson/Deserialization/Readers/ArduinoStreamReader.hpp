@@ -6,6 +6,8 @@
 
 #include <Arduino.h>
 
+#include <string.h>  // memcpy
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 template <typename TSource>
@@ -28,3 +30,71 @@ struct Reader<TSource, enable_if_t<is_base_of<Stream, TSource>::value>> {
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Reads a Stream in chunks of up to N bytes, instead of one byte per call.
+// Pass it to deserializeJson() or deserializeMsgPack() in place of the stream.
+// The deserializer consumes the same bytes as with the stream; the bytes read
+// ahead stay in the buffer and can be retrieved with read(), peek() or
+// unread() once the document is parsed.
+template <size_t N = 64>
+class BufferedStreamReader {
+  static_assert(N > 0, "the buffer must not be empty");
+
+ public:
+  explicit BufferedStreamReader(Stream& stream)
+      : stream_(&stream), begin_(0), end_(0) {}
+
+  // Returns the next byte, or -1 on timeout
+  int read() {
+    if (begin_ == end_ && !fill())
+      return -1;
+    return static_cast<unsigned char>(buffer_[begin_++]);
+  }
+
+  // Returns the next byte without consuming it, or -1 on timeout
+  int peek() {
+    if (begin_ == end_ && !fill())
+      return -1;
+    return static_cast<unsigned char>(buffer_[begin_]);
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    size_t n = unread(buffer, length);
+    if (n < length)
+      n += stream_->readBytes(buffer + n, length - n);
+    return n;
+  }
+
+  // Number of bytes read from the stream but not consumed yet
+  size_t buffered() const {
+    return end_ - begin_;
+  }
+
+  // Moves up to length of the buffered bytes to buffer; never reads the stream
+  size_t unread(char* buffer, size_t length) {
+    size_t n = buffered() < length ? buffered() : length;
+    memcpy(buffer, buffer_ + begin_, n);
+    begin_ += n;
+    return n;
+  }
+
+ private:
+  // Reads what the stream has available, or waits for one byte
+  bool fill() {
+    int available = stream_->available();
+    size_t n = 1;  // if nothing is available, readBytes() waits for one byte
+    if (available > 0)
+      n = size_t(available) < N ? size_t(available) : N;
+    begin_ = 0;
+    end_ = stream_->readBytes(buffer_, n);
+    return end_ > 0;
+  }
+
+  Stream* stream_;
+  size_t begin_, end_;
+  char buffer_[N];
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,531 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/JsonChars.hpp>
+#include <ArduinoJson/Json/Utf16.hpp>
+#include <ArduinoJson/Json/Utf8.hpp>
+#include <ArduinoJson/Numbers/parseNumber.hpp>
+#include <ArduinoJson/Strings/JsonString.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+enum class JsonEvent : uint8_t {
+  None,  // more input needed, end of document, or error
+  BeginObject,
+  EndObject,
+  BeginArray,
+  EndArray,
+  Key,
+  String,
+  StringPart,  // a piece of a long string, see splitStrings()
+  Number,
+  True,
+  False,
+  Null,
+};
+
+// Parses a JSON document fed in chunks of any size and reports it as a
+// sequence of events, without building a JsonDocument and without allocating.
+// TextSize is the length of the longest key, string, or number.
+// MaxDepth is the nesting limit, as DeserializationOption::NestingLimit.
+template <size_t TextSize = 64,
+          uint8_t MaxDepth = ARDUINOJSON_DEFAULT_NESTING_LIMIT>
+class JsonStreamParser {
+ public:
+  JsonStreamParser() : splitStrings_(false) {
+    reset();
+  }
+
+  // Prepares to parse a new document
+  void reset() {
+    input_ = end_ = nullptr;
+    error_ = DeserializationError::Ok;
+    expect_ = Expect::Value;
+    token_ = Token::None;
+    depth_ = 0;
+    finished_ = false;
+    foundSomething_ = false;
+    skipping_ = false;
+    partDone_ = false;
+    text_.clear();
+  }
+
+  // Reports the strings longer than TextSize as StringPart events followed by
+  // a String event with the last piece, instead of failing with NoMemory.
+  // Keys are never split.
+  void splitStrings(bool enable) {
+    splitStrings_ = enable;
+  }
+
+  // Skips, without storing its text, the value after a Key event, the rest of
+  // a container after its BeginObject or BeginArray event, or the rest of a
+  // string after a StringPart event. The skipped events are not reported.
+  void skipValue() {
+    if (token_ != Token::None || expect_ == Expect::Colon ||
+        expect_ == Expect::Value)
+      skipDepth_ = depth_;
+    else if (expect_ == Expect::KeyOrEnd || expect_ == Expect::ValueOrEnd)
+      skipDepth_ = uint8_t(depth_ - 1);
+    else
+      return;
+    skipping_ = true;
+  }
+
+  // Sets the next chunk of input.
+  // The parser doesn't copy it: it must stay valid until next() returns None.
+  void feed(const char* data, size_t size) {
+    input_ = data;
+    end_ = data + size;
+  }
+
+  // Tells that there is no more input.
+  // Required to end a number at the root, as in "42".
+  void finish() {
+    finished_ = true;
+  }
+
+  // Returns the next event, or None when the current chunk is consumed,
+  // when the document is complete, or when an error occurs.
+  JsonEvent next() {
+    if (partDone_) {
+      text_.clear();
+      partDone_ = false;
+    }
+    while (!error_ && expect_ != Expect::Done) {
+      if (input_ == end_)
+        return finished_ ? endOfInput() : JsonEvent::None;
+      auto event =
+          token_ == Token::None ? startToken(*input_) : continueToken(*input_);
+      if (event == JsonEvent::None)
+        continue;
+      if (!skipping_)
+        return event;
+      if (depth_ == skipDepth_)  // the skipped value is complete
+        skipping_ = false;
+    }
+    return JsonEvent::None;
+  }
+
+  DeserializationError error() const {
+    return error_;
+  }
+
+  // Returns true once the root value is complete
+  bool done() const {
+    return expect_ == Expect::Done;
+  }
+
+  // Number of objects and arrays that contain the current event
+  uint8_t depth() const {
+    return depth_;
+  }
+
+  // The text of a Key, String, or Number event
+  JsonString text() const {
+    return JsonString(text_.data, text_.size);
+  }
+
+  // The value of a Number event
+  template <typename T>
+  T as() const {
+    return detail::parseNumber<T>(text_.data);
+  }
+
+  // Number of bytes of the current chunk that were not consumed
+  size_t remaining() const {
+    return size_t(end_ - input_);
+  }
+
+ private:
+  enum class Expect : uint8_t {
+    Value,
+    ValueOrEnd,
+    Key,
+    KeyOrEnd,
+    Colon,
+    CommaOrEnd,
+    Done,
+  };
+
+  enum class Token : uint8_t {
+    None,
+    String,
+    Escape,
+    Unicode,
+    Number,
+    NonQuotedKey,
+    Keyword,
+#if ARDUINOJSON_ENABLE_COMMENTS
+    Slash,
+    BlockComment,
+    LineComment,
+#endif
+  };
+
+  struct Text {
+    void clear() {
+      size = 0;
+      overflowed = false;
+    }
+
+    void append(char c) {
+      if (size < TextSize)
+        data[size++] = c;
+      else
+        overflowed = true;
+    }
+
+    char data[TextSize + 1];
+    size_t size;
+    bool overflowed;
+  };
+
+  JsonEvent startToken(char c) {
+    switch (c) {
+      case ' ':
+      case '\t':
+      case '\r':
+      case '\n':
+        input_++;
+        return JsonEvent::None;
+
+#if ARDUINOJSON_ENABLE_COMMENTS
+      case '/':
+        input_++;
+        token_ = Token::Slash;
+        return JsonEvent::None;
+#endif
+    }
+
+    foundSomething_ = true;
+    switch (expect_) {
+      case Expect::ValueOrEnd:
+        if (c == ']') {
+          input_++;
+          return endContainer(JsonEvent::EndArray);
+        }
+        return startValue(c);
+
+      case Expect::Value:
+        return startValue(c);
+
+      case Expect::KeyOrEnd:
+        if (c == '}') {
+          input_++;
+          return endContainer(JsonEvent::EndObject);
+        }
+        return startKey(c);
+
+      case Expect::Key:
+        return startKey(c);
+
+      case Expect::Colon:
+        if (c != ':')
+          return fail(DeserializationError::InvalidInput);
+        input_++;
+        expect_ = Expect::Value;
+        return JsonEvent::None;
+
+      case Expect::CommaOrEnd:
+        if (c == ',') {
+          input_++;
+          expect_ = inObject() ? Expect::Key : Expect::Value;
+          return JsonEvent::None;
+        }
+        if (c != (inObject() ? '}' : ']'))
+          return fail(DeserializationError::InvalidInput);
+        input_++;
+        return endContainer(inObject() ? JsonEvent::EndObject
+                                       : JsonEvent::EndArray);
+
+      default:
+        return JsonEvent::None;
+    }
+  }
+
+  JsonEvent startValue(char c) {
+    switch (c) {
+      case '[':
+      case '{':
+        if (depth_ >= MaxDepth)
+          return fail(DeserializationError::TooDeep);
+        input_++;
+        setObject(depth_++, c == '{');
+        expect_ = c == '{' ? Expect::KeyOrEnd : Expect::ValueOrEnd;
+        return c == '{' ? JsonEvent::BeginObject : JsonEvent::BeginArray;
+
+      case '\"':
+      case '\'':
+        startString(c, false);
+        return JsonEvent::None;
+
+      case 't':
+        return startKeyword("true", JsonEvent::True);
+
+      case 'f':
+        return startKeyword("false", JsonEvent::False);
+
+      case 'n':
+        return startKeyword("null", JsonEvent::Null);
+
+      default:
+        if (!detail::canBeInNumber(c))
+          return fail(DeserializationError::InvalidInput);
+        text_.clear();
+        token_ = Token::Number;
+        return JsonEvent::None;
+    }
+  }
+
+  JsonEvent startKey(char c) {
+    if (detail::isQuote(c)) {
+      startString(c, true);
+      return JsonEvent::None;
+    }
+    if (!detail::canBeInNonQuotedString(c))
+      return fail(DeserializationError::InvalidInput);
+    text_.clear();
+    token_ = Token::NonQuotedKey;
+    return JsonEvent::None;
+  }
+
+  void startString(char quote, bool isKey) {
+    input_++;
+    text_.clear();
+    codepoint_ = detail::Utf16::Codepoint();
+    quote_ = quote;
+    isKey_ = isKey;
+    token_ = Token::String;
+  }
+
+  JsonEvent startKeyword(const char* keyword, JsonEvent event) {
+    text_.clear();
+    keyword_ = keyword;
+    keywordEvent_ = event;
+    token_ = Token::Keyword;
+    return JsonEvent::None;
+  }
+
+  JsonEvent continueToken(char c) {
+    if (text_.overflowed)
+      return fail(DeserializationError::NoMemory);
+
+    switch (token_) {
+      case Token::String:
+        if (c == '\0')
+          return fail(DeserializationError::IncompleteInput);
+        // keep room for the longest UTF-8 sequence
+        if (splitStrings_ && !isKey_ && !skipping_ && c != quote_ &&
+            text_.size > 0 && text_.size + 4 > TextSize)
+          return endStringPart();
+        input_++;
+        if (c == quote_)
+          return endString();
+        if (c == '\\')
+          token_ = Token::Escape;
+        else
+          append(c);
+        return JsonEvent::None;
+
+      case Token::Escape:
+        token_ = Token::String;
+        if (c == 'u') {
+#if ARDUINOJSON_DECODE_UNICODE
+          input_++;
+          codeunit_ = 0;
+          hexDigits_ = 0;
+          token_ = Token::Unicode;
+#else
+          append('\\');
+#endif
+          return JsonEvent::None;
+        }
+        c = detail::EscapeSequence::unescapeChar(c);
+        if (c == '\0')
+          return fail(DeserializationError::InvalidInput);
+        input_++;
+        append(c);
+        return JsonEvent::None;
+
+      case Token::Unicode: {
+        uint8_t value = detail::decodeHex(c);
+        if (value > 0x0F)
+          return fail(DeserializationError::InvalidInput);
+        input_++;
+        codeunit_ = uint16_t((codeunit_ << 4) | value);
+        if (++hexDigits_ == 4) {
+          if (codepoint_.append(codeunit_) && !skipping_)
+            detail::Utf8::encodeCodepoint(codepoint_.value(), text_);
+          token_ = Token::String;
+        }
+        return JsonEvent::None;
+      }
+
+      case Token::Number:
+        if (!detail::canBeInNumber(c))
+          return endNumber();
+        input_++;
+        append(c);
+        return JsonEvent::None;
+
+      case Token::NonQuotedKey:
+        if (!detail::canBeInNonQuotedString(c))
+          return endKey();
+        input_++;
+        append(c);
+        return JsonEvent::None;
+
+      case Token::Keyword:
+        if (c != *keyword_)
+          return fail(DeserializationError::InvalidInput);
+        input_++;
+        if (*++keyword_)
+          return JsonEvent::None;
+        token_ = Token::None;
+        text_.data[0] = 0;
+        endValue();
+        return keywordEvent_;
+
+#if ARDUINOJSON_ENABLE_COMMENTS
+      case Token::Slash:
+        if (c == '*')
+          token_ = Token::BlockComment;
+        else if (c == '/')
+          token_ = Token::LineComment;
+        else
+          return fail(DeserializationError::InvalidInput);
+        input_++;
+        wasStar_ = false;
+        return JsonEvent::None;
+
+      case Token::BlockComment:
+        input_++;
+        if (c == '/' && wasStar_)
+          token_ = Token::None;
+        wasStar_ = c == '*';
+        return JsonEvent::None;
+
+      case Token::LineComment:
+        input_++;
+        if (c == '\n')
+          token_ = Token::None;
+        return JsonEvent::None;
+#endif
+
+      default:
+        return JsonEvent::None;
+    }
+  }
+
+  // Text is not stored while skipping
+  void append(char c) {
+    if (!skipping_)
+      text_.append(c);
+  }
+
+  JsonEvent endStringPart() {
+    text_.data[text_.size] = 0;
+    partDone_ = true;  // the text is cleared by the next call to next()
+    return JsonEvent::StringPart;
+  }
+
+  JsonEvent endString() {
+    if (isKey_)
+      return endKey();
+    if (text_.overflowed)
+      return fail(DeserializationError::NoMemory);
+    token_ = Token::None;
+    text_.data[text_.size] = 0;
+    endValue();
+    return JsonEvent::String;
+  }
+
+  JsonEvent endKey() {
+    if (text_.overflowed)
+      return fail(DeserializationError::NoMemory);
+    token_ = Token::None;
+    text_.data[text_.size] = 0;
+    expect_ = Expect::Colon;
+    return JsonEvent::Key;
+  }
+
+  JsonEvent endNumber() {
+    if (text_.overflowed)
+      return fail(DeserializationError::NoMemory);
+    token_ = Token::None;
+    text_.data[text_.size] = 0;
+    // like JsonDeserializer::skipNumericValue(), don't validate skipped numbers
+    if (!skipping_ &&
+        detail::parseNumber(text_.data).type() == detail::NumberType::Invalid)
+      return fail(DeserializationError::InvalidInput);
+    endValue();
+    return JsonEvent::Number;
+  }
+
+  JsonEvent endContainer(JsonEvent event) {
+    depth_--;
+    endValue();
+    return event;
+  }
+
+  void endValue() {
+    expect_ = depth_ ? Expect::CommaOrEnd : Expect::Done;
+  }
+
+  JsonEvent endOfInput() {
+    if (token_ == Token::Number)
+      return endNumber();
+    if (token_ == Token::None && !foundSomething_)
+      return fail(DeserializationError::EmptyInput);
+    return fail(DeserializationError::IncompleteInput);
+  }
+
+  JsonEvent fail(DeserializationError::Code code) {
+    error_ = code;
+    return JsonEvent::None;
+  }
+
+  bool inObject() const {
+    return (stack_[(depth_ - 1) / 8] >> ((depth_ - 1) % 8)) & 1;
+  }
+
+  void setObject(uint8_t level, bool isObject) {
+    uint8_t mask = uint8_t(1 << (level % 8));
+    if (isObject)
+      stack_[level / 8] |= mask;
+    else
+      stack_[level / 8] &= uint8_t(~mask);
+  }
+
+  const char* input_;
+  const char* end_;
+  DeserializationError error_;
+  Expect expect_;
+  Token token_;
+  uint8_t depth_;
+  bool finished_;
+  bool foundSomething_;
+  bool splitStrings_;
+  bool skipping_;
+  uint8_t skipDepth_;
+  bool partDone_;
+  bool isKey_;
+  char quote_;
+#if ARDUINOJSON_ENABLE_COMMENTS
+  bool wasStar_;
+#endif
+  uint8_t hexDigits_;
+  uint16_t codeunit_;
+  detail::Utf16::Codepoint codepoint_;
+  const char* keyword_;  // remaining letters of true, false, or null
+  JsonEvent keywordEvent_;
+  uint8_t stack_[MaxDepth / 8u + 1u];  // one bit per level: object or array
+  Text text_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
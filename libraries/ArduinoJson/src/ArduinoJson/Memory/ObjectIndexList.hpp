@@ -0,0 +1,120 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/MemoryPool.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+
+#include <stddef.h>  // size_t
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Hash table of the keys of a large object (see ObjectData::findKey())
+struct ObjectIndex {
+  SlotId head;      // first key of the object, identifies it
+  SlotId last;      // last key in the table, NULL_SLOT if none
+  size_t count;     // keys in the table
+  size_t capacity;  // power of two, at least twice the count
+  SlotId* table;    // key slots, NULL_SLOT in empty entries
+};
+
+// The indexes of the objects of a document.
+// An index is a cache: it's dropped when one of the object's members is
+// removed or when its first key is released.
+class ObjectIndexList {
+ public:
+  ObjectIndexList() = default;
+
+  ~ObjectIndexList() {
+    ARDUINOJSON_ASSERT(count_ == 0);
+  }
+
+  friend void swap(ObjectIndexList& a, ObjectIndexList& b) {
+    swap_(a.items_, b.items_);
+    swap_(a.count_, b.count_);
+    swap_(a.capacity_, b.capacity_);
+  }
+
+  bool empty() const {
+    return count_ == 0;
+  }
+
+  ObjectIndex* find(SlotId head) const {
+    for (size_t i = 0; i < count_; i++) {
+      if (items_[i].head == head)
+        return &items_[i];
+    }
+    return nullptr;
+  }
+
+  // Returns nullptr if allocation fails
+  ObjectIndex* add(SlotId head, size_t capacity, Allocator* allocator) {
+    ARDUINOJSON_ASSERT(find(head) == nullptr);
+    if (count_ == capacity_) {
+      auto n = capacity_ ? capacity_ * 2 : 4;
+      auto size = n * sizeof(ObjectIndex);
+      auto items = reinterpret_cast<ObjectIndex*>(
+          items_ ? allocator->reallocate(items_, size)
+                 : allocator->allocate(size));
+      if (!items)
+        return nullptr;
+      items_ = items;
+      capacity_ = n;
+    }
+    auto table = allocTable(capacity, allocator);
+    if (!table)
+      return nullptr;
+    auto index = &items_[count_++];
+    index->head = head;
+    index->last = NULL_SLOT;
+    index->count = 0;
+    index->capacity = capacity;
+    index->table = table;
+    return index;
+  }
+
+  void remove(SlotId head, Allocator* allocator) {
+    auto index = find(head);
+    if (!index)
+      return;
+    allocator->deallocate(index->table);
+    *index = items_[--count_];
+    if (count_ == 0)
+      release(allocator);
+  }
+
+  void clear(Allocator* allocator) {
+    for (size_t i = 0; i < count_; i++)
+      allocator->deallocate(items_[i].table);
+    count_ = 0;
+    release(allocator);
+  }
+
+  static SlotId* allocTable(size_t capacity, Allocator* allocator) {
+    auto table =
+        reinterpret_cast<SlotId*>(allocator->allocate(capacity * sizeof(SlotId)));
+    if (table) {
+      for (size_t i = 0; i < capacity; i++)
+        table[i] = NULL_SLOT;
+    }
+    return table;
+  }
+
+ private:
+  void release(Allocator* allocator) {
+    if (items_)
+      allocator->deallocate(items_);
+    items_ = nullptr;
+    capacity_ = 0;
+  }
+
+  ObjectIndex* items_ = nullptr;
+  size_t count_ = 0;
+  size_t capacity_ = 0;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
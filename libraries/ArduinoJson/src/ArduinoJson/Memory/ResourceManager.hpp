@@ -6,6 +6,7 @@
 
 #include <ArduinoJson/Memory/Allocator.hpp>
 #include <ArduinoJson/Memory/MemoryPoolList.hpp>
+#include <ArduinoJson/Memory/ObjectIndexList.hpp>
 #include <ArduinoJson/Memory/StringPool.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
@@ -32,6 +33,9 @@ class ResourceManager {
       : allocator_(allocator), overflowed_(false) {}
 
   ~ResourceManager() {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    objectIndexes_.clear(allocator_);
+#endif
     stringPool_.clear(allocator_);
     variantPools_.clear(allocator_);
   }
@@ -42,6 +46,9 @@ class ResourceManager {
   friend void swap(ResourceManager& a, ResourceManager& b) {
     swap(a.stringPool_, b.stringPool_);
     swap(a.variantPools_, b.variantPools_);
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    swap(a.objectIndexes_, b.objectIndexes_);
+#endif
     swap_(a.allocator_, b.allocator_);
     swap_(a.overflowed_, b.overflowed_);
   }
@@ -81,7 +88,7 @@ class ResourceManager {
   }
 
   void saveString(StringNode* node) {
-    stringPool_.add(node);
+    stringPool_.add(node, allocator_);
   }
 
   template <typename TAdaptedString>
@@ -111,7 +118,25 @@ class ResourceManager {
     stringPool_.dereference(s, allocator_);
   }
 
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  // The indexes are caches, so they can be updated through a const pointer
+  ObjectIndex* getObjectIndex(SlotId head) const {
+    return objectIndexes_.find(head);
+  }
+
+  ObjectIndex* createObjectIndex(SlotId head, size_t capacity) const {
+    return objectIndexes_.add(head, capacity, allocator_);
+  }
+
+  void releaseObjectIndex(SlotId head) const {
+    objectIndexes_.remove(head, allocator_);
+  }
+#endif
+
   void clear() {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    objectIndexes_.clear(allocator_);
+#endif
     variantPools_.clear(allocator_);
     overflowed_ = false;
     stringPool_.clear(allocator_);
@@ -119,6 +144,7 @@ class ResourceManager {
 
   void shrinkToFit() {
     variantPools_.shrinkToFit(allocator_);
+    stringPool_.shrinkToFit(allocator_);
   }
 
  private:
@@ -126,6 +152,9 @@ class ResourceManager {
   bool overflowed_;
   StringPool stringPool_;
   MemoryPoolList<SlotData> variantPools_;
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  mutable ObjectIndexList objectIndexes_;
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
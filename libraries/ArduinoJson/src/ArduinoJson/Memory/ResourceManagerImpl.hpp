@@ -21,6 +21,11 @@ inline Slot<VariantData> ResourceManager::allocVariant() {
 }
 
 inline void ResourceManager::freeVariant(Slot<VariantData> variant) {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  // the first key of an object is released with the object
+  if (!objectIndexes_.empty())
+    objectIndexes_.remove(variant.id(), allocator_);
+#endif
   variant->clear(this);
   variantPools_.freeSlot({alias_cast<SlotData*>(variant.ptr()), variant.id()});
 }
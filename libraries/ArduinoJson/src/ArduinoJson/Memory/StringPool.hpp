@@ -24,6 +24,11 @@ class StringPool {
 
   friend void swap(StringPool& a, StringPool& b) {
     swap_(a.strings_, b.strings_);
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    swap_(a.index_, b.index_);
+    swap_(a.indexCapacity_, b.indexCapacity_);
+    swap_(a.count_, b.count_);
+#endif
   }
 
   void clear(Allocator* allocator) {
@@ -32,6 +37,22 @@ class StringPool {
       strings_ = node->next;
       StringNode::destroy(node, allocator);
     }
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    freeIndex(allocator);
+    count_ = 0;
+#endif
+  }
+
+  // Resizes the index to the current number of strings
+  void shrinkToFit(Allocator* allocator) {
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    if (count_ < ARDUINOJSON_STRING_INDEX_THRESHOLD)
+      freeIndex(allocator);
+    else if (indexCapacityFor(count_) != indexCapacity_ || !index_)
+      rebuildIndex(indexCapacityFor(count_), allocator);
+#else
+    (void)allocator;
+#endif
   }
 
   size_t size() const {
@@ -59,18 +80,40 @@ class StringPool {
 
     stringGetChars(str, node->data, n);
     node->data[n] = 0;  // force NUL terminator
-    add(node);
+    add(node, allocator);
     return node;
   }
 
-  void add(StringNode* node) {
+  void add(StringNode* node, Allocator* allocator) {
     ARDUINOJSON_ASSERT(node != nullptr);
     node->next = strings_;
     strings_ = node;
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    count_++;
+    if (count_ * 2 > indexCapacity_) {
+      if (count_ >= ARDUINOJSON_STRING_INDEX_THRESHOLD)
+        rebuildIndex(indexCapacityFor(count_), allocator);
+    } else if (index_) {
+      indexInsert(node);
+    }
+#else
+    (void)allocator;
+#endif
   }
 
   template <typename TAdaptedString>
   StringNode* get(const TAdaptedString& str) const {
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    if (index_) {
+      size_t mask = indexCapacity_ - 1;
+      for (size_t i = stringHash(str) & mask; index_[i]; i = (i + 1) & mask) {
+        auto node = index_[i];
+        if (stringEquals(str, adaptString(node->data, node->length)))
+          return node;
+      }
+      return nullptr;
+    }
+#endif
     for (auto node = strings_; node; node = node->next) {
       if (stringEquals(str, adaptString(node->data, node->length)))
         return node;
@@ -87,6 +130,11 @@ class StringPool {
             prev->next = node->next;
           else
             strings_ = node->next;
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+          count_--;
+          if (index_)
+            indexRemove(node);
+#endif
           StringNode::destroy(node, allocator);
         }
         return;
@@ -96,6 +144,72 @@ class StringPool {
   }
 
  private:
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+  // The index is an open-addressing hash table of the nodes (linear probing),
+  // never more than half full. It's an accelerator only: when it can't be
+  // allocated, get() falls back to the list and the next growth tries again.
+
+  static size_t indexCapacityFor(size_t count) {
+    size_t capacity = 16;
+    while (capacity < count * 2)
+      capacity *= 2;
+    return capacity;
+  }
+
+  static size_t homeSlot(const StringNode* node, size_t mask) {
+    return stringHash(adaptString(node->data, node->length)) & mask;
+  }
+
+  void indexInsert(StringNode* node) {
+    size_t mask = indexCapacity_ - 1;
+    size_t i = homeSlot(node, mask);
+    while (index_[i])
+      i = (i + 1) & mask;
+    index_[i] = node;
+  }
+
+  void indexRemove(StringNode* node) {
+    size_t mask = indexCapacity_ - 1;
+    size_t i = homeSlot(node, mask);
+    while (index_[i] != node)
+      i = (i + 1) & mask;
+    // shift back the following entries that would become unreachable
+    for (size_t j = (i + 1) & mask; index_[j]; j = (j + 1) & mask) {
+      size_t home = homeSlot(index_[j], mask);
+      bool reachable = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+      if (!reachable) {
+        index_[i] = index_[j];
+        i = j;
+      }
+    }
+    index_[i] = nullptr;
+  }
+
+  void rebuildIndex(size_t capacity, Allocator* allocator) {
+    freeIndex(allocator);
+    indexCapacity_ = capacity;
+    index_ = reinterpret_cast<StringNode**>(
+        allocator->allocate(capacity * sizeof(StringNode*)));
+    if (!index_)
+      return;
+    for (size_t i = 0; i < capacity; i++)
+      index_[i] = nullptr;
+    for (auto node = strings_; node; node = node->next)
+      indexInsert(node);
+  }
+
+  void freeIndex(Allocator* allocator) {
+    if (index_)
+      allocator->deallocate(index_);
+    index_ = nullptr;
+    indexCapacity_ = 0;
+  }
+
+  StringNode** index_ = nullptr;
+  size_t indexCapacity_ = 0;  // power of two
+  size_t count_ = 0;
+#endif
+
   StringNode* strings_ = nullptr;
 };
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Collection/CollectionData.hpp>
+#include <ArduinoJson/Memory/ObjectIndexList.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
@@ -22,6 +23,12 @@ class ObjectData : public CollectionData {
   VariantData* getMember(TAdaptedString key,
                          const ResourceManager* resources) const;
 
+  // Same as getMember(), but never creates or updates the index of the keys.
+  // The deserializer calls it on every key to detect duplicates.
+  template <typename TAdaptedString>
+  VariantData* getMemberWithoutIndex(TAdaptedString key,
+                                     const ResourceManager* resources) const;
+
   template <typename TAdaptedString>
   static VariantData* getMember(const ObjectData* object, TAdaptedString key,
                                 const ResourceManager* resources) {
@@ -41,9 +48,7 @@ class ObjectData : public CollectionData {
     obj->removeMember(key, resources);
   }
 
-  void remove(iterator it, ResourceManager* resources) {
-    CollectionData::removePair(it, resources);
-  }
+  void remove(iterator it, ResourceManager* resources);
 
   static void remove(ObjectData* obj, ObjectData::iterator it,
                      ResourceManager* resources) {
@@ -64,7 +69,20 @@ class ObjectData : public CollectionData {
 
  private:
   template <typename TAdaptedString>
-  iterator findKey(TAdaptedString key, const ResourceManager* resources) const;
+  iterator findKey(TAdaptedString key, const ResourceManager* resources,
+                   bool useIndex = true) const;
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  template <typename TAdaptedString>
+  iterator findKey(TAdaptedString key, ObjectIndex* index,
+                   const ResourceManager* resources) const;
+
+  void createIndex(size_t keys, const ResourceManager* resources) const;
+  bool updateIndex(ObjectIndex* index, const ResourceManager* resources) const;
+  bool growIndex(ObjectIndex* index, const ResourceManager* resources) const;
+  SlotId nextKey(SlotId key, const ResourceManager* resources) const;
+  static void insertKey(ObjectIndex* index, SlotId id, JsonString key);
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
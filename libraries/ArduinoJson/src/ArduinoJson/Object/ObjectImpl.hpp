@@ -20,6 +20,16 @@ inline VariantData* ObjectData::getMember(
   return it.data();
 }
 
+template <typename TAdaptedString>
+inline VariantData* ObjectData::getMemberWithoutIndex(
+    TAdaptedString key, const ResourceManager* resources) const {
+  auto it = findKey(key, resources, false);
+  if (it.done())
+    return nullptr;
+  it.next(resources);
+  return it.data();
+}
+
 template <typename TAdaptedString>
 VariantData* ObjectData::getOrAddMember(TAdaptedString key,
                                         ResourceManager* resources) {
@@ -31,18 +41,145 @@ VariantData* ObjectData::getOrAddMember(TAdaptedString key,
 
 template <typename TAdaptedString>
 inline ObjectData::iterator ObjectData::findKey(
-    TAdaptedString key, const ResourceManager* resources) const {
+    TAdaptedString key, const ResourceManager* resources, bool useIndex) const {
   if (key.isNull())
     return iterator();
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  auto index = useIndex ? resources->getObjectIndex(head()) : nullptr;
+  if (index)
+    return findKey(key, index, resources);
+  size_t keys = 0;
+#else
+  (void)useIndex;
+#endif
   bool isKey = true;
   for (auto it = createIterator(resources); !it.done(); it.next(resources)) {
-    if (isKey && stringEquals(key, adaptString(it->asString())))
-      return it;
+    if (isKey) {
+      if (stringEquals(key, adaptString(it->asString()))) {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+        if (useIndex && keys >= ARDUINOJSON_OBJECT_INDEX_THRESHOLD)
+          createIndex(keys, resources);
+#endif
+        return it;
+      }
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+      keys++;
+#endif
+    }
     isKey = !isKey;
   }
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  if (useIndex && keys >= ARDUINOJSON_OBJECT_INDEX_THRESHOLD)
+    createIndex(keys, resources);
+#endif
   return iterator();
 }
 
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+template <typename TAdaptedString>
+inline ObjectData::iterator ObjectData::findKey(
+    TAdaptedString key, ObjectIndex* index,
+    const ResourceManager* resources) const {
+  if (!updateIndex(index, resources)) {
+    resources->releaseObjectIndex(head());
+    return findKey(key, resources);
+  }
+
+  size_t mask = index->capacity - 1;
+  for (size_t i = stringHash(key) & mask; index->table[i] != NULL_SLOT;
+       i = (i + 1) & mask) {
+    auto it = iteratorAt(index->table[i], resources);
+    if (stringEquals(key, adaptString(it->asString())))
+      return it;
+  }
+
+  // keys that are being added aren't in the table yet
+  for (auto id = nextKey(index->last, resources); id != NULL_SLOT;
+       id = nextKey(id, resources)) {
+    auto it = iteratorAt(id, resources);
+    auto s = it->asString();
+    if (!s.isNull() && stringEquals(key, adaptString(s)))
+      return it;
+  }
+  return iterator();
+}
+
+inline void ObjectData::createIndex(size_t keys,
+                                    const ResourceManager* resources) const {
+  size_t capacity = 16;
+  while (capacity < keys * 2)
+    capacity *= 2;
+  auto index = resources->createObjectIndex(head(), capacity);
+  if (index && !updateIndex(index, resources))
+    resources->releaseObjectIndex(head());
+}
+
+// Adds the keys appended since the last update
+inline bool ObjectData::updateIndex(ObjectIndex* index,
+                                    const ResourceManager* resources) const {
+  for (auto id = nextKey(index->last, resources); id != NULL_SLOT;
+       id = nextKey(id, resources)) {
+    auto key = resources->getVariant(id)->asString();
+    if (key.isNull())  // the key of a pair that is being added
+      break;
+    if ((index->count + 1) * 2 > index->capacity &&
+        !growIndex(index, resources))
+      return false;
+    insertKey(index, id, key);
+    index->last = id;
+  }
+  return true;
+}
+
+inline bool ObjectData::growIndex(ObjectIndex* index,
+                                  const ResourceManager* resources) const {
+  auto table = ObjectIndexList::allocTable(index->capacity * 2,
+                                           resources->allocator());
+  if (!table)
+    return false;
+  resources->allocator()->deallocate(index->table);
+  index->table = table;
+  index->capacity *= 2;
+  index->count = 0;
+
+  // insert in member order, so the first of duplicate keys is found first
+  if (index->last != NULL_SLOT) {
+    for (auto id = head();; id = nextKey(id, resources)) {
+      insertKey(index, id, resources->getVariant(id)->asString());
+      if (id == index->last)
+        break;
+    }
+  }
+  return true;
+}
+
+inline SlotId ObjectData::nextKey(SlotId key,
+                                  const ResourceManager* resources) const {
+  if (key == NULL_SLOT)
+    return head();
+  auto value = resources->getVariant(resources->getVariant(key)->next());
+  return value->next();
+}
+
+inline void ObjectData::insertKey(ObjectIndex* index, SlotId id,
+                                  JsonString key) {
+  size_t mask = index->capacity - 1;
+  size_t i = stringHash(adaptString(key)) & mask;
+  while (index->table[i] != NULL_SLOT)
+    i = (i + 1) & mask;
+  index->table[i] = id;
+  index->count++;
+}
+#endif
+
+inline void ObjectData::remove(iterator it, ResourceManager* resources) {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  if (!it.done())
+    resources->releaseObjectIndex(head());
+#endif
+  CollectionData::removePair(it, resources);
+}
+
 template <typename TAdaptedString>
 inline void ObjectData::removeMember(TAdaptedString key,
                                      ResourceManager* resources) {
@@ -6,6 +6,8 @@
 
 #include "type_traits.hpp"
 
+#include <stddef.h>  // size_t
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 using nullptr_t = decltype(nullptr);
@@ -30,4 +32,19 @@ void swap_(T& a, T& b) {
   b = move(tmp);
 }
 
+// Polyfill for std::index_sequence
+template <size_t...>
+struct index_sequence {};
+
+template <size_t N, size_t... Is>
+struct make_index_sequence_ : make_index_sequence_<N - 1, N - 1, Is...> {};
+
+template <size_t... Is>
+struct make_index_sequence_<0, Is...> {
+  using type = index_sequence<Is...>;
+};
+
+template <size_t N>
+using make_index_sequence = typename make_index_sequence_<N>::type;
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,308 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Polyfills/integer.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+
+#if ARDUINOJSON_ENABLE_STD_STRING
+#  include <string>
+#endif
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The type of the default value of a member
+template <typename T, typename Enable = void>
+struct SchemaDefault {
+  using type = nullptr_t;  // no default
+};
+
+template <typename T>
+struct SchemaDefault<T, enable_if_t<is_integral<T>::value ||
+                                    is_floating_point<T>::value>> {
+  using type = T;
+};
+
+template <size_t N>
+struct SchemaDefault<char[N]> {
+  using type = const char*;
+};
+
+#if ARDUINOJSON_ENABLE_STD_STRING
+template <>
+struct SchemaDefault<std::string> {
+  using type = const char*;
+};
+#endif
+
+#if ARDUINOJSON_ENABLE_ARDUINO_STRING
+template <>
+struct SchemaDefault<::String> {
+  using type = const char*;
+};
+#endif
+
+// A member that holds a value, a string, or an array of values
+template <typename TObject, typename TMember>
+struct JsonField {
+  using default_type = typename SchemaDefault<TMember>::type;
+
+  const char* key;
+  TMember TObject::*member;
+  bool hasDefault;
+  default_type defaultValue;
+};
+
+// A member that holds a struct with its own schema
+template <typename TObject, typename TMember, typename TSchema>
+struct JsonNestedField {
+  const char* key;
+  TMember TObject::*member;
+  const TSchema* schema;
+};
+
+template <typename... TFields>
+struct SchemaFields {
+  template <typename TVisitor>
+  void visit(size_t, TVisitor&) const {}
+
+  template <typename TVisitor>
+  void forEach(TVisitor&) const {}
+};
+
+template <typename TField, typename... TRest>
+struct SchemaFields<TField, TRest...> {
+  constexpr SchemaFields(TField f, TRest... rest) : head(f), tail(rest...) {}
+
+  template <typename TVisitor>
+  void visit(size_t index, TVisitor& visitor) const {
+    if (index == 0)
+      visitor(head);
+    else
+      tail.visit(index - 1, visitor);
+  }
+
+  template <typename TVisitor>
+  void forEach(TVisitor& visitor) const {
+    visitor(head);
+    tail.forEach(visitor);
+  }
+
+  TField head;
+  SchemaFields<TRest...> tail;
+};
+
+template <size_t N>
+struct SchemaKeys {
+  const char* data[N ? N : 1];
+};
+
+// FNV-1a, starting from the seed; the constexpr and the runtime versions
+// must return the same values
+constexpr uint32_t schemaHashFinal(uint32_t h) {
+  return h ^ (h >> 15);
+}
+
+constexpr uint32_t schemaHash(const char* s, uint32_t h) {
+  return *s ? schemaHash(s + 1, (h ^ uint8_t(*s)) * 16777619u)
+            : schemaHashFinal(h);
+}
+
+inline uint32_t schemaHash(const char* s, size_t n, uint32_t h) {
+  for (size_t i = 0; i < n; i++)
+    h = (h ^ uint8_t(s[i])) * 16777619u;
+  return schemaHashFinal(h);
+}
+
+constexpr uint32_t schemaSeedBasis(uint32_t seed) {
+  return 2166136261u + seed * 0x9E3779B9u;
+}
+
+// The hash table has at least four slots per key, at most 128 slots
+constexpr size_t schemaTableSize(size_t keys, size_t size = 4) {
+  return size >= 4 * keys ? size : schemaTableSize(keys, size * 2);
+}
+
+template <size_t N>
+constexpr size_t schemaSlot(SchemaKeys<N> keys, size_t i, uint32_t seed) {
+  return schemaHash(keys.data[i], schemaSeedBasis(seed)) &
+         (schemaTableSize(N) - 1);
+}
+
+// Returns true if the keys from i go to distinct slots; lo and hi are the
+// slots taken by the keys before i
+template <size_t N>
+constexpr bool schemaSeedWorks(SchemaKeys<N> keys, size_t i, uint32_t seed,
+                               uint64_t lo, uint64_t hi);
+
+template <size_t N>
+constexpr bool schemaSeedWorks(SchemaKeys<N> keys, size_t i, uint32_t seed,
+                               uint64_t lo, uint64_t hi, size_t slot) {
+  return slot < 64 ? !((lo >> slot) & 1) &&
+                         schemaSeedWorks(keys, i + 1, seed,
+                                         lo | (uint64_t(1) << slot), hi)
+                   : !((hi >> (slot - 64)) & 1) &&
+                         schemaSeedWorks(keys, i + 1, seed, lo,
+                                         hi | (uint64_t(1) << (slot - 64)));
+}
+
+template <size_t N>
+constexpr bool schemaSeedWorks(SchemaKeys<N> keys, size_t i, uint32_t seed,
+                               uint64_t lo, uint64_t hi) {
+  return i == N || schemaSeedWorks(keys, i, seed, lo, hi,
+                                   schemaSlot(keys, i, seed));
+}
+
+const uint32_t schemaNoSeed = 0xFFFFFFFF;
+
+// Searches the first seed in [first, last) without collision.
+// Splits the range in two to keep the recursion shallow.
+template <size_t N>
+constexpr uint32_t schemaFindSeed(SchemaKeys<N> keys, uint32_t first,
+                                  uint32_t last);
+
+template <size_t N>
+constexpr uint32_t schemaFindSeedOr(uint32_t seed, SchemaKeys<N> keys,
+                                    uint32_t first, uint32_t last) {
+  return seed != schemaNoSeed ? seed : schemaFindSeed(keys, first, last);
+}
+
+template <size_t N>
+constexpr uint32_t schemaFindSeed(SchemaKeys<N> keys, uint32_t first,
+                                  uint32_t last) {
+  return last - first == 1
+             ? (schemaSeedWorks(keys, 0, first, 0, 0) ? first : schemaNoSeed)
+             : schemaFindSeedOr(
+                   schemaFindSeed(keys, first, first + (last - first) / 2),
+                   keys, first + (last - first) / 2, last);
+}
+
+// Not constexpr: reaching it at compile time stops the compilation
+inline uint32_t schemaKeysMustBeUnique() {
+  return 0;
+}
+
+constexpr uint32_t schemaCheckSeed(uint32_t seed) {
+  return seed != schemaNoSeed ? seed : schemaKeysMustBeUnique();
+}
+
+template <size_t N>
+constexpr uint32_t schemaSeed(SchemaKeys<N> keys) {
+  return schemaCheckSeed(schemaFindSeed(keys, 0, 0x10000));
+}
+
+// Returns the index of the key that goes to the slot, or 0xFF
+template <size_t N>
+constexpr uint8_t schemaSlotOwner(SchemaKeys<N> keys, uint32_t seed,
+                                  size_t slot, size_t i = 0) {
+  return i == N                                 ? uint8_t(0xFF)
+         : schemaSlot(keys, i, seed) == slot ? uint8_t(i)
+                                                : schemaSlotOwner(keys, seed,
+                                                                  slot, i + 1);
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A constexpr table of the members of TObject, with their keys, defaults, and
+// nested schemas. deserializeJson() and serializeJson() use it to read and
+// write the struct directly, without a JsonDocument. The keys are dispatched
+// with a perfect hash computed at compile time.
+template <typename TObject, typename... TFields>
+class JsonSchema {
+ public:
+  static_assert(sizeof...(TFields) <= 32, "a schema supports up to 32 fields");
+
+  constexpr JsonSchema(TFields... fields)
+      : JsonSchema(keys_type{{fields.key...}}, fields...) {}
+
+  // Returns the index of the field with this key, or -1
+  int find(const char* key, size_t length) const {
+    if (sizeof...(TFields) == 0)
+      return -1;
+    auto hash = detail::schemaHash(key, length,
+                                   detail::schemaSeedBasis(seed_));
+    uint8_t index = slots_[hash & (sizeof(slots_) - 1)];
+    if (index == 0xFF || !keyEquals(keys_.data[index], key, length))
+      return -1;
+    return index;
+  }
+
+  template <typename TVisitor>
+  void visit(size_t index, TVisitor& visitor) const {
+    fields_.visit(index, visitor);
+  }
+
+  template <typename TVisitor>
+  void forEach(TVisitor& visitor) const {
+    fields_.forEach(visitor);
+  }
+
+ private:
+  using keys_type = detail::SchemaKeys<sizeof...(TFields)>;
+  using slots_sequence = detail::make_index_sequence<detail::schemaTableSize(
+      sizeof...(TFields))>;
+
+  constexpr JsonSchema(keys_type keys, TFields... fields)
+      : JsonSchema(keys, detail::schemaSeed(keys), slots_sequence(),
+                   fields...) {}
+
+  template <size_t... Slots>
+  constexpr JsonSchema(keys_type keys, uint32_t seed,
+                       detail::index_sequence<Slots...>, TFields... fields)
+      : fields_(fields...),
+        keys_(keys),
+        seed_(seed),
+        slots_{detail::schemaSlotOwner(keys, seed, Slots)...} {}
+
+  static bool keyEquals(const char* expected, const char* key,
+                        size_t length) {
+    for (size_t i = 0; i < length; i++) {
+      if (!expected[i] || expected[i] != key[i])
+        return false;
+    }
+    return expected[length] == 0;
+  }
+
+  detail::SchemaFields<TFields...> fields_;
+  keys_type keys_;
+  uint32_t seed_;
+  uint8_t slots_[detail::schemaTableSize(sizeof...(TFields))];
+};
+
+// Creates the schema of TObject
+template <typename TObject, typename... TFields>
+constexpr JsonSchema<TObject, TFields...> jsonSchema(TFields... fields) {
+  return JsonSchema<TObject, TFields...>(fields...);
+}
+
+// Declares a member without default value
+template <typename TObject, typename TMember>
+constexpr detail::JsonField<TObject, TMember> jsonField(
+    const char* key, TMember TObject::*member) {
+  return {key, member, false,
+          typename detail::JsonField<TObject, TMember>::default_type()};
+}
+
+// Declares a member with the value it takes when the key is missing
+template <typename TObject, typename TMember>
+constexpr detail::JsonField<TObject, TMember> jsonField(
+    const char* key, TMember TObject::*member,
+    typename detail::SchemaDefault<TMember>::type defaultValue) {
+  return {key, member, true, defaultValue};
+}
+
+// Declares a member that is a struct with its own schema
+template <typename TObject, typename TMember, typename... TFields>
+constexpr detail::JsonNestedField<TObject, TMember,
+                                  JsonSchema<TMember, TFields...>>
+jsonField(const char* key, TMember TObject::*member,
+          const JsonSchema<TMember, TFields...>& schema) {
+  return {key, member, &schema};
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
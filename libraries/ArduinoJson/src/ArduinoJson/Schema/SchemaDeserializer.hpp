@@ -0,0 +1,257 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Json/JsonStreamParser.hpp>
+#include <ArduinoJson/Schema/JsonSchema.hpp>
+#include <ArduinoJson/Serialization/Writer.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Parses a JSON object into a struct, following the events of
+// JsonStreamParser. Unknown keys and values of the wrong type are skipped.
+template <typename TReader>
+class SchemaDeserializer {
+ public:
+  SchemaDeserializer(TReader reader) : reader_(reader) {
+    parser_.splitStrings(true);
+  }
+
+  template <typename TObject, typename... TFields>
+  DeserializationError parse(TObject& object,
+                             const JsonSchema<TObject, TFields...>& schema) {
+    applyDefaults(object, schema);
+    auto event = nextEvent();
+    if (event != JsonEvent::BeginObject && event != JsonEvent::None)
+      return DeserializationError::InvalidInput;
+    parseObject(object, schema, event);
+    return parser_.error();
+  }
+
+ private:
+  JsonEvent nextEvent() {
+    for (;;) {
+      auto event = parser_.next();
+      if (event != JsonEvent::None || parser_.error() || parser_.done())
+        return event;
+      int c = reader_.read();
+      if (c > 0) {
+        c_ = char(c);
+        parser_.feed(&c_, 1);
+      } else {
+        parser_.finish();
+      }
+    }
+  }
+
+  // Skips the rest of a value whose first event was read; the parser discards
+  // it during the next call to nextEvent()
+  void skip(JsonEvent event) {
+    if (event == JsonEvent::BeginObject || event == JsonEvent::BeginArray ||
+        event == JsonEvent::StringPart)
+      parser_.skipValue();
+  }
+
+  template <typename TObject, typename... TFields>
+  void parseObject(TObject& object,
+                   const JsonSchema<TObject, TFields...>& schema,
+                   JsonEvent event) {
+    if (event != JsonEvent::BeginObject)
+      return skip(event);
+
+    while (nextEvent() == JsonEvent::Key) {
+      JsonString key = parser_.text();
+      int index = schema.find(key.c_str(), key.size());
+      if (index < 0) {
+        parser_.skipValue();
+      } else {
+        FieldParser<TObject> fieldParser = {this, &object, nextEvent()};
+        schema.visit(size_t(index), fieldParser);
+      }
+    }
+  }
+
+  template <typename TObject>
+  struct FieldParser {
+    SchemaDeserializer* self;
+    TObject* object;
+    JsonEvent event;
+
+    template <typename TMember>
+    void operator()(const JsonField<TObject, TMember>& field) {
+      self->parseValue(object->*field.member, event);
+    }
+
+    template <typename TMember, typename TSchema>
+    void operator()(const JsonNestedField<TObject, TMember, TSchema>& field) {
+      self->parseObject(object->*field.member, *field.schema, event);
+    }
+  };
+
+  void parseValue(bool& value, JsonEvent event) {
+    if (event == JsonEvent::True || event == JsonEvent::False)
+      value = event == JsonEvent::True;
+    else
+      skip(event);
+  }
+
+  template <typename T>
+  enable_if_t<(is_integral<T>::value && !is_same<T, bool>::value) ||
+              is_floating_point<T>::value>
+  parseValue(T& value, JsonEvent event) {
+    if (event == JsonEvent::Number)
+      value = parser_.template as<T>();
+    else
+      skip(event);
+  }
+
+  static bool isString(JsonEvent event) {
+    return event == JsonEvent::String || event == JsonEvent::StringPart;
+  }
+
+  // Writes the pieces of a long string one after the other
+  template <typename TWriter>
+  size_t parseString(TWriter& writer, JsonEvent event) {
+    size_t size = 0;
+    while (isString(event)) {
+      JsonString piece = parser_.text();
+      size += writer.write(reinterpret_cast<const uint8_t*>(piece.c_str()),
+                           piece.size());
+      if (event == JsonEvent::String)
+        break;
+      event = nextEvent();
+    }
+    return size;
+  }
+
+  template <size_t N>
+  void parseValue(char (&value)[N], JsonEvent event) {
+    if (!isString(event))
+      return skip(event);
+    StaticStringWriter writer(value, N - 1);  // truncates
+    value[parseString(writer, event)] = 0;
+  }
+
+#if ARDUINOJSON_ENABLE_STD_STRING
+  void parseValue(std::string& value, JsonEvent event) {
+    if (!isString(event))
+      return skip(event);
+    Writer<std::string> writer(value);
+    parseString(writer, event);
+  }
+#endif
+
+#if ARDUINOJSON_ENABLE_ARDUINO_STRING
+  void parseValue(::String& value, JsonEvent event) {
+    if (!isString(event))
+      return skip(event);
+    Writer<::String> writer(value);
+    parseString(writer, event);
+  }
+#endif
+
+  // Fills the elements in order; extra elements are skipped
+  template <typename T, size_t N>
+  void parseValue(T (&array)[N], JsonEvent event) {
+    if (event != JsonEvent::BeginArray)
+      return skip(event);
+    size_t i = 0;
+    for (;;) {
+      event = nextEvent();
+      if (event == JsonEvent::EndArray || event == JsonEvent::None)
+        return;
+      if (i < N)
+        parseValue(array[i++], event);
+      else
+        skip(event);
+    }
+  }
+
+  template <typename TObject>
+  struct DefaultsApplier {
+    TObject* object;
+
+    template <typename TMember>
+    void operator()(const JsonField<TObject, TMember>& field) {
+      if (field.hasDefault)
+        assign(object->*field.member, field.defaultValue);
+    }
+
+    template <typename TMember, typename TSchema>
+    void operator()(const JsonNestedField<TObject, TMember, TSchema>& field) {
+      applyDefaults(object->*field.member, *field.schema);
+    }
+  };
+
+  template <typename TObject, typename... TFields>
+  static void applyDefaults(TObject& object,
+                            const JsonSchema<TObject, TFields...>& schema) {
+    DefaultsApplier<TObject> applier = {&object};
+    schema.forEach(applier);
+  }
+
+  template <typename T>
+  static void assign(T& member, T value) {
+    member = value;
+  }
+
+  template <size_t N>
+  static void assign(char (&member)[N], const char* value) {
+    size_t n = 0;
+    while (value && value[n] && n < N - 1) {
+      member[n] = value[n];
+      n++;
+    }
+    member[n] = 0;
+  }
+
+  template <typename T>
+  static void assign(T& member, const char* value) {  // String, std::string
+    member = value ? value : "";
+  }
+
+  template <typename T>
+  static void assign(T&, nullptr_t) {}
+
+  TReader reader_;
+  JsonStreamParser<> parser_;
+  char c_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Parses a JSON object into a struct described by a JsonSchema.
+// Strings have no length limit, but keys are limited to 64 characters.
+template <typename TObject, typename... TFields, typename TInput>
+DeserializationError deserializeJson(
+    TObject& dst, const JsonSchema<TObject, TFields...>& schema,
+    TInput&& input) {
+  using namespace detail;
+  using TReader = decltype(makeReader(detail::forward<TInput>(input)));
+  return SchemaDeserializer<TReader>(makeReader(detail::forward<TInput>(input)))
+      .parse(dst, schema);
+}
+
+template <typename TObject, typename... TFields, typename TChar>
+DeserializationError deserializeJson(
+    TObject& dst, const JsonSchema<TObject, TFields...>& schema, TChar* input) {
+  using namespace detail;
+  return SchemaDeserializer<Reader<TChar*>>(makeReader(input))
+      .parse(dst, schema);
+}
+
+template <typename TObject, typename... TFields, typename TChar>
+DeserializationError deserializeJson(
+    TObject& dst, const JsonSchema<TObject, TFields...>& schema, TChar* input,
+    size_t inputSize) {
+  using namespace detail;
+  return SchemaDeserializer<BoundedReader<TChar*>>(makeReader(input, inputSize))
+      .parse(dst, schema);
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,146 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/TextFormatter.hpp>
+#include <ArduinoJson/Schema/JsonSchema.hpp>
+#include <ArduinoJson/Serialization/Writer.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Writes a struct as a JSON object, with the members in the schema's order
+template <typename TWriter>
+class SchemaSerializer {
+ public:
+  SchemaSerializer(TWriter writer) : formatter_(writer) {}
+
+  template <typename TObject, typename... TFields>
+  size_t write(const TObject& object,
+               const JsonSchema<TObject, TFields...>& schema) {
+    writeObject(object, schema);
+    return formatter_.bytesWritten();
+  }
+
+ private:
+  template <typename TObject, typename... TFields>
+  void writeObject(const TObject& object,
+                   const JsonSchema<TObject, TFields...>& schema) {
+    formatter_.writeRaw('{');
+    FieldWriter<TObject> fieldWriter = {this, &object, true};
+    schema.forEach(fieldWriter);
+    formatter_.writeRaw('}');
+  }
+
+  template <typename TObject>
+  struct FieldWriter {
+    SchemaSerializer* self;
+    const TObject* object;
+    bool first;
+
+    template <typename TMember>
+    void operator()(const JsonField<TObject, TMember>& field) {
+      writeKey(field.key);
+      self->writeValue(object->*field.member);
+    }
+
+    template <typename TMember, typename TSchema>
+    void operator()(const JsonNestedField<TObject, TMember, TSchema>& field) {
+      writeKey(field.key);
+      self->writeObject(object->*field.member, *field.schema);
+    }
+
+    void writeKey(const char* key) {
+      if (!first)
+        self->formatter_.writeRaw(',');
+      first = false;
+      self->formatter_.writeString(key);
+      self->formatter_.writeRaw(':');
+    }
+  };
+
+  void writeValue(bool value) {
+    formatter_.writeBoolean(value);
+  }
+
+  template <typename T>
+  enable_if_t<is_integral<T>::value && !is_same<T, bool>::value> writeValue(
+      T value) {
+    formatter_.writeInteger(value);
+  }
+
+  template <typename T>
+  enable_if_t<is_floating_point<T>::value> writeValue(T value) {
+    formatter_.writeFloat(value);
+  }
+
+  template <size_t N>
+  void writeValue(const char (&value)[N]) {
+    size_t n = 0;
+    while (n < N && value[n])
+      n++;
+    formatter_.writeString(value, n);
+  }
+
+#if ARDUINOJSON_ENABLE_STD_STRING
+  void writeValue(const std::string& value) {
+    formatter_.writeString(value.c_str(), value.size());
+  }
+#endif
+
+#if ARDUINOJSON_ENABLE_ARDUINO_STRING
+  void writeValue(const ::String& value) {
+    formatter_.writeString(value.c_str(), value.length());
+  }
+#endif
+
+  template <typename T, size_t N>
+  void writeValue(const T (&array)[N]) {
+    formatter_.writeRaw('[');
+    for (size_t i = 0; i < N; i++) {
+      if (i)
+        formatter_.writeRaw(',');
+      writeValue(array[i]);
+    }
+    formatter_.writeRaw(']');
+  }
+
+  TextFormatter<TWriter> formatter_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Writes a struct described by a JsonSchema as a minified JSON object.
+template <typename TObject, typename... TFields, typename TDestination>
+size_t serializeJson(const TObject& src,
+                     const JsonSchema<TObject, TFields...>& schema,
+                     TDestination& destination) {
+  using namespace detail;
+  Writer<TDestination> writer(destination);
+  return SchemaSerializer<Writer<TDestination>>(writer).write(src, schema);
+}
+
+template <typename TObject, typename... TFields>
+size_t serializeJson(const TObject& src,
+                     const JsonSchema<TObject, TFields...>& schema,
+                     void* buffer, size_t bufferSize) {
+  using namespace detail;
+  StaticStringWriter writer(reinterpret_cast<char*>(buffer), bufferSize);
+  size_t n = SchemaSerializer<StaticStringWriter>(writer).write(src, schema);
+  // add null-terminator for text output (not counted in the size)
+  if (n < bufferSize)
+    reinterpret_cast<char*>(buffer)[n] = 0;
+  return n;
+}
+
+template <typename TObject, typename... TFields, typename TChar, size_t N>
+detail::enable_if_t<detail::IsChar<TChar>::value, size_t> serializeJson(
+    const TObject& src, const JsonSchema<TObject, TFields...>& schema,
+    TChar (&buffer)[N]) {
+  return serializeJson(src, schema, buffer, N);
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,325 @@
+#ifndef CAN_ID_FILTER_HPP
+#define CAN_ID_FILTER_HPP
+
+/**
+ * @file CanIdFilter.hpp
+ * @brief Hardware acceptance filter synthesis from a set of wanted IDs.
+ *
+ * Give it the IDs you care about and it computes:
+ *  - the best TWAI (SJA1000 style) acceptance code / mask, choosing between single and
+ *    dual filter mode by whichever lets the fewest unwanted IDs through,
+ *  - MCP2515 mask and filter values ready for MCP_CAN::init_Mask() / init_Filt(),
+ *  - an exact software match (bitmap for 11 bit IDs, sorted table for 29 bit IDs) to
+ *    throw away whatever the hardware filter could not.
+ *
+ *   const uint32_t ids[] = { 864, 320, 2024 };
+ *   CanIdFilter<> filter;
+ *   filter.begin(ids, 3);
+ *   twai_filter_config_t f;
+ *   filter.twai().toConfig(f);
+ *   ESP32Can.begin(speed, tx, rx, 10, 100, &f);
+ *   ...
+ *   if(filter.accepts(rxFrame.identifier, rxFrame.extd)) ...
+ *
+ * Header only and free of driver dependencies.
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+struct TwaiFilterSettings {
+    uint32_t acceptanceCode = 0;
+    uint32_t acceptanceMask = 0xFFFFFFFF;   // 1 = don't care
+    bool singleFilter = true;
+    uint32_t acceptedIds = 0;               // IDs passing the hardware filter
+    float falseAcceptRatio = 1.0f;          // fraction of unwanted IDs passing
+
+    template <typename Config>
+    void toConfig(Config& config) const {
+        config.acceptance_code = acceptanceCode;
+        config.acceptance_mask = acceptanceMask;
+        config.single_filter = singleFilter;
+    }
+};
+
+struct McpFilterSettings {
+    bool extended = false;
+    uint32_t mask[2] = { 0, 0 };            // 1 = must match, MCP_CAN layout
+    uint32_t filter[6] = { 0, 0, 0, 0, 0, 0 };
+    uint32_t acceptedIds = 0;
+    float falseAcceptRatio = 1.0f;
+
+    // Works with MCP_CAN or anything with the same init_Mask / init_Filt signature
+    template <typename Mcp>
+    bool apply(Mcp& can) const {
+        bool ret = true;
+        for(uint8_t i = 0; i < 2; ++i) ret &= can.init_Mask(i, extended, mask[i]) == 0;
+        for(uint8_t i = 0; i < 6; ++i) ret &= can.init_Filt(i, extended, filter[i]) == 0;
+        return ret;
+    }
+};
+
+template <size_t MaxIds = 32>
+class CanIdFilter {
+    static_assert(MaxIds > 0 && MaxIds <= 64, "CanIdFilter supports 1..64 IDs");
+
+ public:
+    CanIdFilter() {}
+
+    // Computes all filter settings; IDs must be all standard or all extended
+    bool begin(const uint32_t* wanted, size_t count, bool extended = false) {
+        if(!wanted || count == 0 || count > MaxIds) return false;
+
+        isExtended = extended;
+        idBits = extended ? 29 : 11;
+        const uint32_t limit = extended ? 0x1FFFFFFFU : 0x7FFU;
+
+        for(size_t i = 0; i < BITMAP_WORDS; ++i) bitmap[i] = 0;
+        idCount = 0;
+        for(size_t i = 0; i < count; ++i) {
+            uint32_t id = wanted[i] & limit;
+            // insertion sort keeps the table ready for binary search and drops duplicates
+            size_t pos = idCount;
+            while(pos > 0 && ids[pos - 1] > id) --pos;
+            if(pos > 0 && ids[pos - 1] == id) continue;
+            for(size_t j = idCount; j > pos; --j) ids[j] = ids[j - 1];
+            ids[pos] = id;
+            ++idCount;
+            if(!extended) bitmap[id >> 5] |= 1U << (id & 31);
+        }
+
+        synthesizeTwai();
+        synthesizeMcp();
+        return true;
+    }
+
+    // Exact software match against the wanted set
+    inline bool accepts(uint32_t id, bool extended = false) const {
+        if(extended != isExtended) return false;
+        if(!extended) return id < 2048 && (bitmap[id >> 5] & (1U << (id & 31)));
+        size_t lo = 0, hi = idCount;
+        while(lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if(ids[mid] < id) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo < idCount && ids[lo] == id;
+    }
+
+    template <typename Frame>
+    inline bool accepts(const Frame& frame) const { return accepts(frame.identifier, frame.extd); }
+
+    inline const TwaiFilterSettings& twai() const { return twaiSettings; }
+    inline const McpFilterSettings& mcp() const { return mcpSettings; }
+    inline size_t size() const { return idCount; }
+
+ private:
+    static constexpr size_t BITMAP_WORDS = 2048 / 32;
+
+    // A set of IDs as one code with don't-care bits, i.e. a sub-cube of the ID space
+    struct Cube {
+        uint32_t code;
+        uint32_t dontCare;
+    };
+
+    inline uint32_t idMask() const { return (idBits == 32) ? 0xFFFFFFFFU : ((1U << idBits) - 1); }
+
+    static inline uint8_t popCount(uint32_t v) {
+        uint8_t n = 0;
+        for(; v; v &= v - 1) ++n;
+        return n;
+    }
+
+    inline uint64_t cubeSize(const Cube& c) const { return 1ULL << popCount(c.dontCare & idMask()); }
+
+    inline uint64_t unionSize(const Cube& a, const Cube& b) const {
+        uint64_t size = cubeSize(a) + cubeSize(b);
+        uint32_t care = ~(a.dontCare | b.dontCare) & idMask();
+        if(((a.code ^ b.code) & care) == 0) size -= 1ULL << popCount(a.dontCare & b.dontCare & idMask());
+        return size;
+    }
+
+    // Smallest cube holding every ID selected by the bitmask 'members' (or all IDs if members == ~0)
+    Cube cover(uint64_t members, uint32_t forcedDontCare = 0) const {
+        uint32_t all = 0, any = 0;
+        bool first = true;
+        for(size_t i = 0; i < idCount; ++i) {
+            if(!(members & (1ULL << i))) continue;
+            if(first) { all = any = ids[i]; first = false; }
+            all &= ids[i];
+            any |= ids[i];
+        }
+        Cube c;
+        c.dontCare = ((all ^ any) | forcedDontCare) & idMask();
+        c.code = all & ~c.dontCare;
+        return c;
+    }
+
+    inline float falseAccepts(uint64_t accepted) const {
+        uint64_t space = 1ULL << idBits;
+        if(accepted <= idCount || space <= idCount) return 0.0f;
+        return (float)(accepted - idCount) / (float)(space - idCount);
+    }
+
+    void synthesizeTwai() {
+        const uint64_t all = (idCount >= 64) ? ~0ULL : ((1ULL << idCount) - 1);
+
+        // Dual filter mode on extended frames only compares ID[28:13]
+        const uint32_t dualDontCare = isExtended ? 0x1FFFU : 0;
+
+        Cube single = cover(all);
+        uint64_t bestSize = cubeSize(single);
+        Cube best[2] = { single, single };
+        bool useSingle = true;
+
+        if(idCount > 1) {
+            auto tryPartition = [&](uint64_t first) {
+                Cube a = cover(first, dualDontCare);
+                Cube b = cover(all & ~first, dualDontCare);
+                uint64_t size = unionSize(a, b);
+                if(size < bestSize) {
+                    bestSize = size;
+                    best[0] = a;
+                    best[1] = b;
+                    useSingle = false;
+                }
+            };
+
+            if(idCount <= 16) {
+                // Exhaustive, the highest ID always sits in the second filter to skip mirrored splits
+                for(uint64_t first = 1; first < (1ULL << (idCount - 1)); ++first) tryPartition(first);
+            } else {
+                // Split on each ID bit, then on each position of the sorted ID list
+                for(uint8_t bit = 0; bit < idBits; ++bit) {
+                    uint64_t first = 0;
+                    for(size_t i = 0; i < idCount; ++i) if(!(ids[i] & (1U << bit))) first |= 1ULL << i;
+                    if(first && first != all) tryPartition(first);
+                }
+                for(size_t i = 1; i < idCount; ++i) tryPartition((1ULL << i) - 1);
+            }
+        }
+
+        TwaiFilterSettings& s = twaiSettings;
+        s.singleFilter = useSingle;
+        if(useSingle) {
+            if(isExtended) {
+                s.acceptanceCode = single.code << 3;
+                s.acceptanceMask = (single.dontCare << 3) | 0x7;            // RTR + unused
+            } else {
+                s.acceptanceCode = single.code << 21;
+                s.acceptanceMask = (single.dontCare << 21) | 0x1FFFFF;      // RTR + data bytes
+            }
+        } else if(isExtended) {
+            s.acceptanceCode = ((best[0].code >> 13) << 16) | (best[1].code >> 13);
+            s.acceptanceMask = ((best[0].dontCare >> 13) << 16) | (best[1].dontCare >> 13);
+        } else {
+            s.acceptanceCode = (best[0].code << 21) | (best[1].code << 5);
+            s.acceptanceMask = (best[0].dontCare << 21) | 0x1F000F          // RTR + data byte 1
+                             | (best[1].dontCare << 5) | 0x1F;              // RTR + unused
+        }
+        s.acceptedIds = bestSize > 0xFFFFFFFFULL ? 0xFFFFFFFFU : (uint32_t)bestSize;
+        s.falseAcceptRatio = falseAccepts(bestSize);
+    }
+
+    // Greedily clears mask bits (1 = must match) until the selected IDs fall into at most 'slots' patterns
+    uint32_t reduceMask(uint64_t members, size_t slots) const {
+        uint32_t mask = idMask();
+        while(distinct(members, mask) > slots) {
+            uint32_t bestMask = 0;
+            size_t bestCount = SIZE_MAX;
+            for(uint8_t bit = 0; bit < idBits; ++bit) {
+                if(!(mask & (1U << bit))) continue;
+                uint32_t m = mask & ~(1U << bit);
+                size_t n = distinct(members, m);
+                if(n < bestCount) { bestCount = n; bestMask = m; }
+            }
+            mask = bestMask;
+        }
+        return mask;
+    }
+
+    size_t patterns(uint64_t members, uint32_t mask, uint32_t* out) const {
+        size_t n = 0;
+        for(size_t i = 0; i < idCount; ++i) {
+            if(!(members & (1ULL << i))) continue;
+            uint32_t p = ids[i] & mask;
+            size_t j = 0;
+            while(j < n && out[j] != p) ++j;
+            if(j == n) out[n++] = p;
+        }
+        return n;
+    }
+
+    inline size_t distinct(uint64_t members, uint32_t mask) const {
+        uint32_t tmp[MaxIds];
+        return patterns(members, mask, tmp);
+    }
+
+    // Fills one receive buffer (mask + its filters); returns number of IDs it accepts
+    uint64_t fillMcpBuffer(uint64_t members, uint8_t buffer, McpFilterSettings& s) const {
+        const uint8_t first = buffer ? 2 : 0;
+        const size_t slots = buffer ? 4 : 2;
+        uint32_t mask = members ? reduceMask(members, slots) : idMask();
+        uint32_t p[MaxIds];
+        size_t n = patterns(members, mask, p);
+        // An unused buffer repeats the first wanted ID so it doesn't open up anything new
+        if(n == 0) { p[0] = ids[0]; n = 1; }
+        // n <= MaxIds, but spelled out so the indices are provably in range
+        const size_t last = (n < MaxIds ? n : MaxIds) - 1;
+        for(size_t i = 0; i < slots && first + i < 6; ++i) {
+            uint32_t f = p[i < last ? i : last];
+            s.filter[first + i] = isExtended ? f : (f << 16);
+        }
+        s.mask[buffer] = isExtended ? mask : (mask << 16);
+        return members ? (uint64_t)n << popCount(~mask & idMask()) : 0;
+    }
+
+    void synthesizeMcp() {
+        const uint64_t all = (idCount >= 64) ? ~0ULL : ((1ULL << idCount) - 1);
+        McpFilterSettings candidate;
+        candidate.extended = isExtended;
+
+        McpFilterSettings& s = mcpSettings;
+        uint64_t bestSize;
+
+        {
+            // Baseline: one mask shared by both buffers gives six pattern slots
+            uint32_t mask = reduceMask(all, 6);
+            uint32_t p[MaxIds];
+            size_t n = patterns(all, mask, p);
+            if(n == 0) { p[0] = ids[0]; n = 1; }    // begin() keeps at least one ID
+            const size_t last = (n < MaxIds ? n : MaxIds) - 1;
+            for(size_t i = 0; i < 6; ++i) {
+                uint32_t f = p[i < last ? i : last];
+                candidate.filter[i] = isExtended ? f : (f << 16);
+            }
+            candidate.mask[0] = candidate.mask[1] = isExtended ? mask : (mask << 16);
+            bestSize = (uint64_t)n << popCount(~mask & idMask());
+            s = candidate;
+        }
+
+        if(idCount <= 8) {
+            // Small sets: try every split between the two receive buffers
+            for(uint64_t first = 0; first <= all; ++first) {
+                uint64_t size = fillMcpBuffer(first, 0, candidate) + fillMcpBuffer(all & ~first, 1, candidate);
+                if(size < bestSize) {
+                    bestSize = size;
+                    s = candidate;
+                }
+            }
+        }
+
+        s.acceptedIds = bestSize > 0xFFFFFFFFULL ? 0xFFFFFFFFU : (uint32_t)bestSize;
+        s.falseAcceptRatio = falseAccepts(bestSize);
+    }
+
+    uint32_t ids[MaxIds];
+    size_t idCount = 0;
+    uint8_t idBits = 11;
+    bool isExtended = false;
+    uint32_t bitmap[BITMAP_WORDS] = { 0 };
+
+    TwaiFilterSettings twaiSettings;
+    McpFilterSettings mcpSettings;
+};
+
+#endif//CAN_ID_FILTER_HPP
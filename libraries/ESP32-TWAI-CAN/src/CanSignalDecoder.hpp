@@ -0,0 +1,271 @@
+#ifndef CAN_SIGNAL_DECODER_HPP
+#define CAN_SIGNAL_DECODER_HPP
+
+/**
+ * @file CanSignalDecoder.hpp
+ * @brief Table driven CAN signal decoder.
+ *
+ * Describe every signal once in a 'CanSignal' table (start bit, length, byte order,
+ * scale and offset, DBC style) and let the decoder do the byte math. Message IDs are
+ * looked up through a collision free hash built in begin(), and all signals of a frame
+ * are extracted in a single pass from one 64-bit load, so the cost per frame stays
+ * constant no matter how many IDs the table holds.
+ *
+ * Signals are addressed by their index in the table, so an enum listing the table rows
+ * in the same order gives readable names:
+ *
+ *   enum { OIL_TEMP, WATER_TEMP };
+ *   const CanSignal signals[] = {
+ *       { 864, 16, 8, CAN_LITTLE_ENDIAN, false, 1.0f, -40.0f },
+ *       { 864, 24, 8, CAN_LITTLE_ENDIAN, false, 1.0f, -40.0f },
+ *   };
+ *   CanSignalDecoder<2> decoder;
+ *   decoder.begin(signals);
+ *   if(decoder.decode(rxFrame) > 0 && decoder.consumeChanged(OIL_TEMP)) ...
+ *
+ * Header only and free of driver dependencies, anything with 'identifier', 'extd',
+ * 'data_length_code' and 'data' members (like 'CanFrame') can be passed to decode().
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+enum CanByteOrder : uint8_t {
+    CAN_LITTLE_ENDIAN,  // Intel, start bit is the LSB
+    CAN_BIG_ENDIAN      // Motorola, start bit is the MSB (DBC numbering)
+};
+
+// OR into CanSignal::id for 29 bit identifiers
+#define CAN_SIGNAL_EXTENDED 0x80000000U
+
+struct CanSignal {
+    uint32_t id;
+    uint8_t startBit;
+    uint8_t length;         // 1..32
+    CanByteOrder order;
+    bool isSigned;
+    float scale;
+    float offset;
+};
+
+template <size_t N>
+class CanSignalDecoder {
+    static_assert(N > 0 && N < 255, "CanSignalDecoder supports 1..254 signals");
+
+ public:
+    CanSignalDecoder() { for(size_t i = 0; i < HASH_SLOTS; ++i) hash[i] = EMPTY; }
+
+    // Builds the ID hash and extraction plan; returns false on malformed table entries
+    bool begin(const CanSignal (&table)[N]) {
+        signals = table;
+        messageCount = 0;
+        for(size_t i = 0; i < N; ++i) {
+            const CanSignal& s = table[i];
+            if(s.length == 0 || s.length > 32) return false;
+
+            Extract& e = extract[i];
+            e.signal = i;
+            e.isSigned = s.isSigned;
+            e.mask = (s.length == 32) ? 0xFFFFFFFFU : ((1U << s.length) - 1);
+            uint16_t msb;
+            if(s.order == CAN_LITTLE_ENDIAN) {
+                msb = s.startBit + s.length - 1;
+                if(msb > 63) return false;
+                e.bigEndian = false;
+                e.shift = s.startBit;
+                e.minLength = msb / 8 + 1;
+            } else {
+                // DBC sawtooth numbering -> position counted from the MSB of a big-endian word
+                msb = (s.startBit / 8) * 8 + (7 - s.startBit % 8);
+                if(msb + s.length > 64) return false;
+                e.bigEndian = true;
+                e.shift = 64 - (msb + s.length);
+                e.minLength = (msb + s.length - 1) / 8 + 1;
+            }
+            values[i] = 0;
+        }
+        for(size_t i = 0; i < CHANGE_WORDS; ++i) changedBits[i] = 0;
+        for(size_t i = 0; i < CHANGE_WORDS; ++i) validBits[i] = 0;
+
+        // Group signals per message, keeping table order inside a message
+        for(size_t i = 0; i < N; ++i) {
+            size_t m = 0;
+            while(m < messageCount && messages[m].id != table[i].id) ++m;
+            if(m == messageCount) {
+                messages[m].id = table[i].id;
+                messages[m].count = 0;
+                ++messageCount;
+            }
+            ++messages[m].count;
+        }
+        uint8_t first = 0;
+        for(size_t m = 0; m < messageCount; ++m) {
+            messages[m].first = first;
+            first += messages[m].count;
+            messages[m].count = 0;
+        }
+        Extract sorted[N];
+        for(size_t i = 0; i < N; ++i) {
+            size_t m = 0;
+            while(messages[m].id != table[i].id) ++m;
+            sorted[messages[m].first + messages[m].count++] = extract[i];
+        }
+        for(size_t i = 0; i < N; ++i) extract[i] = sorted[i];
+
+        return buildHash();
+    }
+
+    // Decodes every known signal of the frame; returns the number of changed signals or -1 for unknown IDs
+    int decode(uint32_t id, uint8_t length, const uint8_t* data) {
+        const Message* msg = find(id);
+        if(!msg) return -1;
+
+        uint8_t buf[8] = { 0 };
+        if(length > 8) length = 8;
+        for(uint8_t i = 0; i < length; ++i) buf[i] = data[i];
+        uint64_t le = 0, be = 0;
+        for(int i = 7; i >= 0; --i) le = (le << 8) | buf[i];
+        for(int i = 0; i < 8; ++i)  be = (be << 8) | buf[i];
+
+        int changes = 0;
+        const Extract* e = &extract[msg->first];
+        const Extract* end = e + msg->count;
+        for(; e < end; ++e) {
+            if(e->minLength > length) continue;
+            uint32_t raw = (uint32_t)((e->bigEndian ? be : le) >> e->shift) & e->mask;
+            int32_t val = (int32_t)raw;
+            if(e->isSigned && (raw & ~(e->mask >> 1))) val = (int32_t)(raw | ~e->mask);
+
+            uint32_t bit = 1U << (e->signal & 31);
+            uint32_t& changed = changedBits[e->signal >> 5];
+            uint32_t& valid = validBits[e->signal >> 5];
+            if(values[e->signal] != val || !(valid & bit)) {
+                values[e->signal] = val;
+                changed |= bit;
+                valid |= bit;
+                ++changes;
+            }
+        }
+        return changes;
+    }
+
+    template <typename Frame>
+    inline int decode(const Frame& frame) {
+        return decode(frame.extd ? (frame.identifier | CAN_SIGNAL_EXTENDED) : frame.identifier,
+                      frame.data_length_code, frame.data);
+    }
+
+    // True if the table holds signals for this ID
+    inline bool knows(uint32_t id) const { return find(id) != nullptr; }
+
+    // Raw (unscaled) and physical value of a signal
+    inline int32_t raw(size_t signal) const { return values[signal]; }
+    inline float value(size_t signal) const {
+        return values[signal] * signals[signal].scale + signals[signal].offset;
+    }
+    inline int32_t valueInt(size_t signal) const {
+        float v = value(signal);
+        return (int32_t)(v < 0 ? v - 0.5f : v + 0.5f);
+    }
+
+    // Has the signal been received at least once since begin()
+    inline bool valid(size_t signal) const { return validBits[signal >> 5] & (1U << (signal & 31)); }
+
+    // Change bits are set by decode() and cleared by the consumer
+    inline bool changed(size_t signal) const { return changedBits[signal >> 5] & (1U << (signal & 31)); }
+    inline bool consumeChanged(size_t signal) {
+        uint32_t bit = 1U << (signal & 31);
+        bool ret = changedBits[signal >> 5] & bit;
+        changedBits[signal >> 5] &= ~bit;
+        return ret;
+    }
+    inline bool anyChanged() const {
+        for(size_t i = 0; i < CHANGE_WORDS; ++i) if(changedBits[i]) return true;
+        return false;
+    }
+    inline void clearChanged() { for(size_t i = 0; i < CHANGE_WORDS; ++i) changedBits[i] = 0; }
+
+    inline size_t signalCount() const { return N; }
+    inline size_t messagesKnown() const { return messageCount; }
+
+ private:
+    static constexpr size_t CHANGE_WORDS = (N + 31) / 32;
+    static constexpr size_t hashSlots(size_t n, size_t s = 8) { return s >= 4 * n ? s : hashSlots(n, s * 2); }
+    static constexpr size_t HASH_SLOTS = hashSlots(N);
+    static constexpr uint8_t EMPTY = 0xFF;
+
+    struct Extract {
+        uint32_t mask;
+        uint8_t signal;
+        uint8_t shift;
+        uint8_t minLength;
+        bool bigEndian;
+        bool isSigned;
+    };
+
+    struct Message {
+        uint32_t id;
+        uint8_t first;
+        uint8_t count;
+    };
+
+    inline uint32_t slotOf(uint32_t id) const { return (id * multiplier) >> hashShift; }
+
+    inline const Message* find(uint32_t id) const {
+        uint32_t slot = slotOf(id);
+        // With a perfect multiplier this loop runs once, probing only covers the fallback case
+        for(size_t probe = 0; probe < HASH_SLOTS; ++probe) {
+            uint8_t m = hash[slot];
+            if(m == EMPTY) return nullptr;
+            if(messages[m].id == id) return &messages[m];
+            slot = (slot + 1) & (HASH_SLOTS - 1);
+        }
+        return nullptr;
+    }
+
+    // Searches for a multiplier that maps every ID to its own slot, falls back to linear probing
+    bool buildHash() {
+        uint8_t bits = 0;
+        while((1U << bits) < HASH_SLOTS) ++bits;
+        hashShift = 32 - bits;
+
+        uint32_t best = 0x9E3779B1U;
+        size_t bestCollisions = SIZE_MAX;
+        for(uint32_t k = 0; k < 512 && bestCollisions; ++k) {
+            multiplier = 0x9E3779B1U + 2 * k;
+            for(size_t i = 0; i < HASH_SLOTS; ++i) hash[i] = EMPTY;
+            size_t collisions = 0;
+            for(size_t m = 0; m < messageCount; ++m) {
+                uint32_t slot = slotOf(messages[m].id);
+                if(hash[slot] != EMPTY) ++collisions;
+                else hash[slot] = m;
+            }
+            if(collisions < bestCollisions) {
+                bestCollisions = collisions;
+                best = multiplier;
+            }
+        }
+
+        multiplier = best;
+        for(size_t i = 0; i < HASH_SLOTS; ++i) hash[i] = EMPTY;
+        for(size_t m = 0; m < messageCount; ++m) {
+            uint32_t slot = slotOf(messages[m].id);
+            while(hash[slot] != EMPTY) slot = (slot + 1) & (HASH_SLOTS - 1);
+            hash[slot] = m;
+        }
+        return true;
+    }
+
+    const CanSignal* signals = nullptr;
+    Extract extract[N];
+    Message messages[N];
+    size_t messageCount = 0;
+    uint8_t hash[HASH_SLOTS];
+    uint32_t multiplier = 0x9E3779B1U;
+    uint8_t hashShift = 32;
+
+    int32_t values[N];
+    uint32_t changedBits[CHANGE_WORDS] = { 0 };
+    uint32_t validBits[CHANGE_WORDS] = { 0 };
+};
+
+#endif//CAN_SIGNAL_DECODER_HPP
@@ -53,6 +53,29 @@ uint32_t TwaiCAN::inRxQueue() {
     return ret;
 };
 
+size_t IRAM_ATTR TwaiCAN::readFrames(CanFrame* out, size_t max, uint32_t timeoutFirst, uint32_t* dropped) {
+    size_t count = 0;
+    if(out && max) {
+        if(twai_receive(&out[0], pdMS_TO_TICKS(timeoutFirst)) == ESP_OK) {
+            count = 1;
+            while(count < max && twai_receive(&out[count], 0) == ESP_OK) ++count;
+            LOG_TWAI_RX("Frames received %u", count);
+        }
+    }
+    if(dropped) {
+        uint32_t missed = droppedFrames();
+        *dropped = missed - rxMissedRead;
+        rxMissedRead = missed;
+    }
+    return count;
+}
+
+uint32_t TwaiCAN::droppedFrames() {
+    if(getStatusInfo()) {
+        rxMissed = status.rx_missed_count;
+    }
+    return rxMissed;
+}
 
 bool TwaiCAN::setPins(int8_t txPin, int8_t rxPin) {
     bool ret = !init;
@@ -81,6 +104,8 @@ bool TwaiCAN::begin(TwaiSpeed twaiSpeed,
         setPins(txPin, rxPin);
         setTxQueueSize(txQueue);
         setRxQueueSize(rxQueue);
+        rxMissed = 0;
+        rxMissedRead = 0;
 
         twai_general_config_t g_config = {.mode = TWAI_MODE_NORMAL, .tx_io = (gpio_num_t) tx, .rx_io = (gpio_num_t) rx, \
                                                 .clkout_io = TWAI_IO_UNUSED, .bus_off_io = TWAI_IO_UNUSED,      \
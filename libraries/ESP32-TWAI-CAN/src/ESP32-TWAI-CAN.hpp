@@ -105,6 +105,14 @@ class TwaiCAN {
         return ret;
     }
 
+    // Drains up to max frames into out; only waits (timeoutFirst ms) for the first one,
+    // everything queued after that is read without blocking. Returns number of frames read,
+    // frames the driver lost since the previous call are reported in dropped (if not null).
+    size_t readFrames(CanFrame* out, size_t max, uint32_t timeoutFirst = 1000, uint32_t* dropped = nullptr);
+
+    // Total frames lost by the driver due to a full RX queue since begin()
+    uint32_t droppedFrames();
+
     // Pass frame either by reference or pointer; timeout in ms, you can pass 0 for non blocking
     inline bool IRAM_ATTR writeFrame(CanFrame& frame, uint32_t timeout = 1) { return writeFrame(&frame, timeout); }
     inline bool IRAM_ATTR writeFrame(CanFrame* frame, uint32_t timeout = 1) {
@@ -128,6 +136,8 @@ class TwaiCAN {
     int8_t rx = 4;
     uint16_t txQueueSize = 5;
     uint16_t rxQueueSize = 5;
+    uint32_t rxMissed = 0;
+    uint32_t rxMissedRead = 0;     // rxMissed at the last readFrames(), droppedFrames() leaves it
     TwaiSpeed speed = TWAI_SPEED_500KBPS;
 };
 
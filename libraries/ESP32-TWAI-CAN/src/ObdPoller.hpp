@@ -0,0 +1,333 @@
+#ifndef OBD_POLLER_HPP
+#define OBD_POLLER_HPP
+
+/**
+ * @file ObdPoller.hpp
+ * @brief OBD-II PID polling over ISO-TP (ISO 15765-4, 11 bit identifiers).
+ *
+ * Every PID in the table gets a period and a priority. poll() sends whatever is due,
+ * highest priority (lowest number) first and most overdue first among equals. Each ECU
+ * is asked one thing at a time, but requests to different ECUs go out back to back so
+ * the engine and transmission answer in parallel. Multi frame answers are reassembled
+ * (flow control is sent for you), late answers time out, and the rate each PID actually
+ * achieves is measured so you can see when the bus or an ECU can't keep up.
+ *
+ *   enum { RPM, STFT };
+ *   const ObdPid pids[] = {
+ *       // ecu mode  pid   prio period
+ *       { 0,  0x01, 0x0C, 0,   50   },  // 20 Hz
+ *       { 0,  0x01, 0x06, 5,   1000 },  // 1 Hz
+ *   };
+ *   ObdPoller<2> obd;
+ *   obd.begin(ESP32Can, pids, 2, onPid);
+ *   ...
+ *   if(ESP32Can.readFrame(rxFrame, 5)) obd.onFrame(rxFrame, millis());
+ *   obd.poll(millis());
+ *
+ * onFrame() and poll() must be called from the same task, the one that owns the bus.
+ * ECU n is requested on 0x7E0 + n and answers on 0x7E8 + n, OBD_ANY_ECU uses the
+ * functional address 0x7DF and waits for all ECUs to be idle first.
+ */
+#include "ESP32-TWAI-CAN.hpp"
+
+#define OBD_FUNCTIONAL_ID   0x7DF
+#define OBD_REQUEST_ID      0x7E0
+#define OBD_RESPONSE_ID     0x7E8
+#define OBD_ANY_ECU         0xFF
+#define OBD_MAX_ECUS        8
+
+#ifndef OBD_PADDING
+#define OBD_PADDING         0x55
+#endif
+
+// ISO 15765-4 P2 max after 'response pending' (NRC 0x78)
+#ifndef OBD_PENDING_TIMEOUT
+#define OBD_PENDING_TIMEOUT 5000
+#endif
+
+struct ObdPid {
+    uint8_t ecu;            // 0..7, or OBD_ANY_ECU
+    uint8_t mode;           // service, 0x01 current data, 0x22 read by identifier
+    uint16_t pid;           // two bytes on the wire for mode 0x22, one otherwise
+    uint8_t priority;       // lower is more important
+    uint16_t periodMs;
+};
+
+template <size_t MaxPids = 16, size_t MaxPayload = 64>
+class ObdPoller {
+    static_assert(MaxPids > 0 && MaxPids < 128, "ObdPoller supports 1..127 PIDs");
+    static_assert(MaxPayload >= 8 && MaxPayload <= 4095, "MaxPayload must be 8..4095");
+
+ public:
+    // index is the row in the table, data starts after the echoed PID
+    typedef void (*ResponseCallback)(size_t index, const uint8_t* data, size_t length, void* arg);
+
+    ObdPoller() {}
+
+    // timeoutMs is P2 (50 ms per ISO 15765-4), gapMs the minimum time between requests to one ECU
+    bool begin(TwaiCAN& twai, const ObdPid* table, size_t count, ResponseCallback callback,
+               void* arg = nullptr, uint16_t timeoutMs = 50, uint16_t gapMs = 0) {
+        if(!table || !count || count > MaxPids || !callback) return false;
+        can = &twai;
+        pids = table;
+        pidCount = count;
+        onResponse = callback;
+        callbackArg = arg;
+        timeout = timeoutMs;
+        gap = gapMs;
+        for(size_t i = 0; i < count; ++i) {
+            if(table[i].ecu >= OBD_MAX_ECUS && table[i].ecu != OBD_ANY_ECU) return false;
+            stats[i] = Stats();
+        }
+        for(size_t n = 0; n < OBD_MAX_ECUS; ++n) channels[n] = Channel();
+        functional = Channel();
+        started = false;
+        return true;
+    }
+
+    // Feed every received frame; returns true if it was an OBD response
+    bool onFrame(const CanFrame& frame, uint32_t now) {
+        if(frame.extd || frame.rtr) return false;
+        if(frame.identifier < OBD_RESPONSE_ID || frame.identifier >= OBD_RESPONSE_ID + OBD_MAX_ECUS) return false;
+        uint8_t ecu = frame.identifier - OBD_RESPONSE_ID;
+        Channel& ch = channels[ecu];
+        const uint8_t* d = frame.data;
+        uint8_t length = frame.data_length_code;
+        if(length < 1) return true;
+
+        switch(d[0] >> 4) {
+            case 0: {   // single frame
+                uint8_t size = d[0] & 0x0F;
+                if(size == 0 || size + 1 > length) break;
+                ch.receiving = false;
+                complete(ecu, d + 1, size, now);
+                break;
+            }
+            case 1: {   // first frame, ask for the rest without block limit or separation time
+                if(length < 8) break;
+                ch.expected = ((d[0] & 0x0F) << 8) | d[1];
+                if(ch.expected < 8) break;
+                ch.received = 0;
+                append(ch, d + 2, 6);
+                ch.sequence = 1;
+                ch.receiving = true;
+                extendTimeout(ecu, now, timeout);
+                uint8_t fc[3] = { 0x30, 0x00, 0x00 };
+                send(OBD_REQUEST_ID + ecu, fc, 3);
+                break;
+            }
+            case 2: {   // consecutive frame
+                if(!ch.receiving) break;
+                if((d[0] & 0x0F) != ch.sequence) {
+                    ch.receiving = false;
+                    ++sequenceErrors;
+                    break;
+                }
+                ch.sequence = (ch.sequence + 1) & 0x0F;
+                append(ch, d + 1, length - 1);
+                extendTimeout(ecu, now, timeout);
+                if(ch.received >= ch.expected) {
+                    ch.receiving = false;
+                    complete(ecu, ch.buffer, ch.expected < MaxPayload ? ch.expected : MaxPayload, now);
+                }
+                break;
+            }
+            default:    // flow control addressed to us never happens on the response ID
+                break;
+        }
+        return true;
+    }
+
+    // Expires late answers and sends every request that is due and has a free ECU
+    void poll(uint32_t now) {
+        if(!can) return;
+        if(!started) {
+            for(size_t i = 0; i < pidCount; ++i) stats[i].nextDue = now;
+            started = true;
+        }
+
+        for(size_t n = 0; n < OBD_MAX_ECUS; ++n) expire(channels[n], now);
+        expire(functional, now);
+
+        for(;;) {
+            int best = -1;
+            int32_t bestLate = 0;
+            for(size_t i = 0; i < pidCount; ++i) {
+                int32_t late = (int32_t)(now - stats[i].nextDue);
+                if(late < 0 || !idle(pids[i].ecu, now)) continue;
+                if(best < 0 || pids[i].priority < pids[best].priority
+                   || (pids[i].priority == pids[best].priority && late > bestLate)) {
+                    best = i;
+                    bestLate = late;
+                }
+            }
+            if(best < 0 || !request(best, now)) return;
+
+            Stats& s = stats[best];
+            s.nextDue += pids[best].periodMs;
+            // Don't burst to catch up after a stall, just restart the period
+            if((int32_t)(now - s.nextDue) >= 0) s.nextDue = now + pids[best].periodMs;
+            ++s.requests;
+        }
+    }
+
+    // Measured response rate in Hz, smoothed over roughly the last 8 answers
+    inline float achievedRate(size_t index) const {
+        return stats[index].interval > 0.0f ? 1000.0f / stats[index].interval : 0.0f;
+    }
+    inline uint32_t requests(size_t index) const { return stats[index].requests; }
+    inline uint32_t responses(size_t index) const { return stats[index].responses; }
+    inline uint32_t timeouts(size_t index) const { return stats[index].timeouts; }
+    inline uint32_t negativeResponses(size_t index) const { return stats[index].negatives; }
+    inline uint32_t lastResponse(size_t index) const { return stats[index].lastResponse; }
+    inline uint32_t sequenceErrorCount() const { return sequenceErrors; }
+
+ private:
+    struct Channel {
+        int16_t pending = -1;       // table row in flight
+        uint32_t deadline = 0;
+        uint32_t lastSent = 0;
+        bool sentOnce = false;
+        bool receiving = false;
+        uint8_t sequence = 0;
+        uint16_t expected = 0;
+        uint16_t received = 0;
+        uint8_t buffer[MaxPayload];
+    };
+
+    struct Stats {
+        uint32_t nextDue = 0;
+        uint32_t lastResponse = 0;
+        float interval = 0.0f;
+        uint32_t requests = 0;
+        uint32_t responses = 0;
+        uint32_t timeouts = 0;
+        uint32_t negatives = 0;
+    };
+
+    inline void append(Channel& ch, const uint8_t* data, size_t length) {
+        for(size_t i = 0; i < length && ch.received < ch.expected; ++i, ++ch.received) {
+            if(ch.received < MaxPayload) ch.buffer[ch.received] = data[i];
+        }
+    }
+
+    inline bool idle(uint8_t ecu, uint32_t now) const {
+        if(functional.pending >= 0) return false;
+        if(ecu == OBD_ANY_ECU) {
+            for(size_t n = 0; n < OBD_MAX_ECUS; ++n) if(!idle(channels[n], now)) return false;
+            return idle(functional, now);
+        }
+        return idle(channels[ecu], now);
+    }
+
+    inline bool idle(const Channel& ch, uint32_t now) const {
+        return ch.pending < 0 && (!ch.sentOnce || now - ch.lastSent >= gap);
+    }
+
+    void expire(Channel& ch, uint32_t now) {
+        if(ch.pending < 0 || (int32_t)(now - ch.deadline) < 0) return;
+        ++stats[ch.pending].timeouts;
+        ch.pending = -1;
+        ch.receiving = false;
+    }
+
+    inline void extendTimeout(uint8_t ecu, uint32_t now, uint32_t ms) {
+        if(channels[ecu].pending >= 0) channels[ecu].deadline = now + ms;
+        if(functional.pending >= 0) functional.deadline = now + ms;
+    }
+
+    bool request(size_t index, uint32_t now) {
+        const ObdPid& p = pids[index];
+        uint8_t payload[4] = { 0 };
+        uint8_t length = 0;
+        payload[length++] = p.mode;
+        if(p.mode == 0x22) payload[length++] = p.pid >> 8;
+        payload[length++] = p.pid & 0xFF;
+
+        uint32_t id = (p.ecu == OBD_ANY_ECU) ? OBD_FUNCTIONAL_ID : OBD_REQUEST_ID + p.ecu;
+        uint8_t sf[5] = { length, payload[0], payload[1], payload[2], payload[3] };
+        if(!send(id, sf, length + 1)) return false;
+
+        Channel& ch = (p.ecu == OBD_ANY_ECU) ? functional : channels[p.ecu];
+        ch.pending = index;
+        ch.deadline = now + timeout;
+        ch.lastSent = now;
+        ch.sentOnce = true;
+        ch.receiving = false;
+        return true;
+    }
+
+    bool send(uint32_t id, const uint8_t* data, uint8_t length) {
+        CanFrame frame = {};
+        frame.identifier = id;
+        frame.extd = 0;
+        frame.data_length_code = 8;
+        for(uint8_t i = 0; i < 8; ++i) frame.data[i] = i < length ? data[i] : OBD_PADDING;
+        return can->writeFrame(frame, 0);
+    }
+
+    // payload starts at the response service ID
+    void complete(uint8_t ecu, const uint8_t* payload, size_t size, uint32_t now) {
+        Channel& ch = channels[ecu];
+        if(payload[0] == 0x7F) {
+            if(size < 3) return;
+            if(payload[2] == 0x78) {    // response pending, keep waiting
+                extendTimeout(ecu, now, OBD_PENDING_TIMEOUT);
+                return;
+            }
+            int16_t index = match(ch, payload[1], -1);
+            if(index < 0) index = match(functional, payload[1], -1);
+            if(index < 0) return;
+            ++stats[index].negatives;
+            release(ecu, index);
+            return;
+        }
+
+        uint8_t mode = payload[0] - 0x40;
+        size_t pidBytes = (mode == 0x22) ? 2 : 1;
+        if(size < 1 + pidBytes) return;
+        int32_t pid = (pidBytes == 2) ? ((payload[1] << 8) | payload[2]) : payload[1];
+
+        int16_t index = match(ch, mode, pid);
+        if(index < 0) index = match(functional, mode, pid);
+        if(index < 0) return;
+
+        Stats& s = stats[index];
+        if(s.responses) {
+            float dt = (float)(now - s.lastResponse);
+            s.interval = (s.interval > 0.0f) ? s.interval + (dt - s.interval) * 0.125f : dt;
+        }
+        s.lastResponse = now;
+        ++s.responses;
+        release(ecu, index);
+        onResponse(index, payload + 1 + pidBytes, size - 1 - pidBytes, callbackArg);
+    }
+
+    // pid < 0 matches on the mode alone (negative responses don't echo the PID)
+    inline int16_t match(const Channel& ch, uint8_t mode, int32_t pid) const {
+        if(ch.pending < 0 || pids[ch.pending].mode != mode) return -1;
+        if(pid >= 0 && pids[ch.pending].pid != pid) return -1;
+        return ch.pending;
+    }
+
+    inline void release(uint8_t ecu, int16_t index) {
+        if(channels[ecu].pending == index) channels[ecu].pending = -1;
+        if(functional.pending == index) functional.pending = -1;
+    }
+
+    TwaiCAN* can = nullptr;
+    const ObdPid* pids = nullptr;
+    size_t pidCount = 0;
+    ResponseCallback onResponse = nullptr;
+    void* callbackArg = nullptr;
+    uint16_t timeout = 50;
+    uint16_t gap = 0;
+    bool started = false;
+
+    Channel channels[OBD_MAX_ECUS];
+    Channel functional;
+    Stats stats[MaxPids];
+    uint32_t sequenceErrors = 0;
+};
+
+#endif//OBD_POLLER_HPP
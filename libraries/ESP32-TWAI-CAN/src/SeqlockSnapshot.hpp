@@ -0,0 +1,58 @@
+#ifndef SEQLOCK_SNAPSHOT_HPP
+#define SEQLOCK_SNAPSHOT_HPP
+
+/**
+ * @file SeqlockSnapshot.hpp
+ * @brief Single writer, many reader snapshot of a plain struct without locks.
+ *
+ * The writer never waits. Readers copy the struct and retry if the writer was in the
+ * middle of an update, so a reader always ends up with one consistent version and the
+ * version counter tells it whether anything changed since its last read.
+ *
+ * T must be trivially copyable (plain numbers, no pointers to owned memory).
+ */
+#include <stdint.h>
+#include <stddef.h>
+
+#include <atomic>
+
+template <typename T>
+class SeqlockSnapshot {
+ public:
+    SeqlockSnapshot() : seq(0) { for(size_t i = 0; i < sizeof(T); ++i) data[i] = 0; }
+
+    // Writer side, only ever call from one task
+    void write(const T& value) {
+        uint32_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);        // odd: update in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        const uint8_t* src = (const uint8_t*)&value;
+        for(size_t i = 0; i < sizeof(T); ++i) data[i] = src[i];
+        seq.store(s + 2, std::memory_order_release);        // even: stable
+    }
+
+    // Reader side; returns the version read (even, 0 = never written)
+    uint32_t read(T& out) const {
+        uint32_t before, after;
+        do {
+            before = seq.load(std::memory_order_acquire);
+            if(before & 1) continue;
+            uint8_t* dst = (uint8_t*)&out;
+            for(size_t i = 0; i < sizeof(T); ++i) dst[i] = data[i];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = seq.load(std::memory_order_relaxed);
+            if(before == after) break;
+        } while(true);
+        return before;
+    }
+
+    // Cheap check before paying for a copy
+    inline uint32_t version() const { return seq.load(std::memory_order_acquire) & ~1U; }
+
+ private:
+    std::atomic<uint32_t> seq;
+    // Copied bytewise through volatile so the compiler can't move the copy across the fences
+    alignas(T) volatile uint8_t data[sizeof(T)];
+};
+
+#endif//SEQLOCK_SNAPSHOT_HPP
@@ -0,0 +1,131 @@
+#ifndef TWAI_TELEMETRY_HPP
+#define TWAI_TELEMETRY_HPP
+
+/**
+ * @file TwaiTelemetry.hpp
+ * @brief Dual core CAN ingest / render pipeline around a seqlock protected snapshot.
+ *
+ * An ingest task pinned to one core drains the TWAI queue in batches and hands the frames
+ * to your callback, which updates a plain 'State' struct. Whenever the callback reports a
+ * change the struct is published as a new snapshot version. The render side (either the
+ * optional render task or your own loop() through read()) always gets one consistent
+ * version without taking a lock, and a slow display push can never hold up CAN intake.
+ *
+ *   struct Telemetry { int32_t oilTemp; int32_t rpm; };
+ *
+ *   bool ingest(const CanFrame* frames, size_t count, Telemetry& t, void*) {
+ *       bool changed = false;
+ *       for(size_t i = 0; i < count; ++i) changed |= decoder.decode(frames[i]) > 0;
+ *       if(changed) t.rpm = decoder.valueInt(RPM);
+ *       return changed;
+ *   }
+ *
+ *   TwaiTelemetry<Telemetry> telemetry;
+ *   telemetry.begin(ESP32Can, ingest);      // core 0
+ *   ...
+ *   Telemetry t;
+ *   if(telemetry.version() != lastVersion) lastVersion = telemetry.read(t);
+ */
+#include "ESP32-TWAI-CAN.hpp"
+#include "SeqlockSnapshot.hpp"
+
+template <typename State, size_t Batch = 16>
+class TwaiTelemetry {
+ public:
+    // Ingest core: frames drained this round (count is 0 after an idle timeout, handy for
+    // timed work). Update state in place and return true to publish it.
+    typedef bool (*IngestCallback)(const CanFrame* frames, size_t count, State& state, void* arg);
+
+    // Render core: called with every snapshot version newer than the one rendered last
+    typedef void (*RenderCallback)(const State& state, uint32_t version, void* arg);
+
+    TwaiTelemetry() {}
+    ~TwaiTelemetry() { end(); }
+
+    // Starts the ingest task; initial is published right away so readers never see zeros
+    bool begin(TwaiCAN& twai, IngestCallback ingest, const State& initial = State(), void* arg = nullptr,
+               BaseType_t core = 0, UBaseType_t priority = 5, uint32_t idleMs = 10) {
+        if(ingestTask || !ingest) return false;
+        can = &twai;
+        ingestFn = ingest;
+        ingestArg = arg;
+        idleTimeout = idleMs;
+        working = initial;
+        snapshot.write(working);
+        return xTaskCreatePinnedToCore(ingestLoop, "can_ingest", 4096, this, priority, &ingestTask, core) == pdPASS;
+    }
+
+    // Optional render task, woken every periodMs; skips the callback if nothing changed
+    bool startRender(RenderCallback render, uint32_t periodMs, void* arg = nullptr,
+                     BaseType_t core = 1, UBaseType_t priority = 1, uint32_t stack = 8192) {
+        if(renderTask || !render || !periodMs) return false;
+        renderFn = render;
+        renderArg = arg;
+        renderPeriod = periodMs;
+        return xTaskCreatePinnedToCore(renderLoop, "can_render", stack, this, priority, &renderTask, core) == pdPASS;
+    }
+
+    void end() {
+        if(renderTask) { vTaskDelete(renderTask); renderTask = nullptr; }
+        if(ingestTask) { vTaskDelete(ingestTask); ingestTask = nullptr; }
+    }
+
+    // Lock free, safe from any task or core
+    inline uint32_t read(State& out) const { return snapshot.read(out); }
+    inline uint32_t version() const { return snapshot.version(); }
+
+    // Ingest statistics, updated by the ingest task only
+    inline uint32_t framesIngested() const { return frames; }
+    inline uint32_t framesDropped() const { return dropped; }
+    inline uint32_t publishes() const { return published; }
+
+ private:
+    static void ingestLoop(void* arg) {
+        TwaiTelemetry* self = (TwaiTelemetry*)arg;
+        CanFrame batch[Batch];
+        for(;;) {
+            uint32_t lost = 0;
+            size_t count = self->can->readFrames(batch, Batch, self->idleTimeout, &lost);
+            self->frames = self->frames + count;
+            self->dropped = self->dropped + lost;
+            if(self->ingestFn(batch, count, self->working, self->ingestArg)) {
+                self->snapshot.write(self->working);
+                self->published = self->published + 1;
+            }
+        }
+    }
+
+    static void renderLoop(void* arg) {
+        TwaiTelemetry* self = (TwaiTelemetry*)arg;
+        State local;
+        uint32_t rendered = 0xFFFFFFFF;
+        TickType_t wake = xTaskGetTickCount();
+        for(;;) {
+            if(self->snapshot.version() != rendered) {
+                rendered = self->snapshot.read(local);
+                self->renderFn(local, rendered, self->renderArg);
+            }
+            vTaskDelayUntil(&wake, pdMS_TO_TICKS(self->renderPeriod));
+        }
+    }
+
+    SeqlockSnapshot<State> snapshot;
+    State working;                          // owned by the ingest task
+
+    TwaiCAN* can = nullptr;
+    IngestCallback ingestFn = nullptr;
+    void* ingestArg = nullptr;
+    uint32_t idleTimeout = 10;
+    TaskHandle_t ingestTask = nullptr;
+
+    RenderCallback renderFn = nullptr;
+    void* renderArg = nullptr;
+    uint32_t renderPeriod = 50;
+    TaskHandle_t renderTask = nullptr;
+
+    volatile uint32_t frames = 0;
+    volatile uint32_t dropped = 0;
+    volatile uint32_t published = 0;
+};
+
+#endif//TWAI_TELEMETRY_HPP
@@ -0,0 +1,116 @@
+// Single-threaded behaviour plus a two-thread producer/consumer stress run.
+
+#include <assert.h>
+#include <stdio.h>
+
+#include <thread>
+
+#include "CanMsgRingbuffer.h"
+
+using arduino::BasicCanMsgRingbuffer;
+using arduino::CanMsg;
+using arduino::CanStandardId;
+
+static CanMsg makeMsg(uint32_t seq) {
+  uint8_t data[8];
+  for (int i = 0; i < 8; i++)
+    data[i] = static_cast<uint8_t>(seq >> (8 * (i & 3)));
+  return CanMsg(CanStandardId(seq & 0x7FF), 8, data);
+}
+
+static bool checkMsg(CanMsg const &msg, uint32_t seq) {
+  CanMsg const expected = makeMsg(seq);
+  return msg.id == expected.id && msg.data_length == 8 &&
+         memcmp(msg.data, expected.data, 8) == 0;
+}
+
+static void testBasics() {
+  BasicCanMsgRingbuffer<4> rb;
+  CanMsg msg;
+
+  assert(rb.isEmpty());
+  // the ring buffer calls run outside assert(), which NDEBUG removes
+  bool ok = rb.peek(msg);
+  assert(!ok);
+  CanMsg const empty = rb.dequeue();
+  assert(empty.data_length == 0);
+
+  for (uint32_t i = 0; i < 4; i++) {
+    ok = rb.enqueue(makeMsg(i));
+    assert(ok);
+  }
+  assert(rb.isFull());
+  ok = rb.enqueue(makeMsg(99));
+  assert(!ok);
+  assert(rb.overflows() == 1);
+  assert(rb.highWater() == 4);
+
+  ok = rb.peek(msg);
+  assert(ok && checkMsg(msg, 0));
+  msg = rb.dequeue();
+  assert(checkMsg(msg, 0));
+
+  CanMsg out[8];
+  size_t n = rb.dequeue(out, 2);
+  assert(n == 2);
+  assert(checkMsg(out[0], 1) && checkMsg(out[1], 2));
+  assert(rb.available() == 1);
+
+  // wrap around
+  for (uint32_t i = 4; i < 7; i++) {
+    ok = rb.enqueue(makeMsg(i));
+    assert(ok);
+  }
+  n = rb.dequeue(out, 8);
+  assert(n == 4);
+  for (uint32_t i = 0; i < 4; i++)
+    assert(checkMsg(out[i], i + 3));
+  assert(rb.isEmpty());
+
+  rb.resetStats();
+  assert(rb.overflows() == 0 && rb.highWater() == 0);
+  (void)empty;
+  (void)ok;
+  (void)n;
+}
+
+static void testStress() {
+  static BasicCanMsgRingbuffer<32> rb;
+  uint32_t const count = 500000;
+  uint32_t retries = 0;
+
+  std::thread producer([&] {
+    for (uint32_t seq = 0; seq < count; seq++) {
+      while (!rb.enqueue(makeMsg(seq))) {
+        retries++;
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint32_t next = 0;
+  bool ordered = true;
+  CanMsg out[16];
+  while (next < count) {
+    size_t n = rb.dequeue(out, 1 + (next % 16));
+    if (n == 0)
+      std::this_thread::yield();
+    for (size_t i = 0; i < n; i++, next++)
+      ordered &= checkMsg(out[i], next);
+  }
+  producer.join();
+
+  assert(ordered);
+  assert(rb.isEmpty());
+  assert(rb.overflows() == retries);
+  assert(rb.highWater() <= 32);
+  printf("stress: %u frames, %u full-buffer rejections, high water %u\n",
+         count, retries, static_cast<unsigned>(rb.highWater()));
+}
+
+int main() {
+  testBasics();
+  testStress();
+  printf("CanMsgRingbuffer: all tests passed\n");
+  return 0;
+}
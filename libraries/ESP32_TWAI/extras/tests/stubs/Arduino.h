@@ -0,0 +1,14 @@
+// Minimal host stand-in for the Arduino core, just enough for src/api
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Print.h"
+#include "Printable.h"
+
+template <typename T>
+inline T min(T a, T b) {
+  return a < b ? a : b;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const char *buf, size_t len) {
+    size_t n = 0;
+    while (len--)
+      n += write(static_cast<uint8_t>(*buf++));
+    return n;
+  }
+};
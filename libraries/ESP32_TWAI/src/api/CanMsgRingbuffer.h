@@ -0,0 +1,178 @@
+/*
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of either the GNU General Public License version 2
+ * or the GNU Lesser General Public License version 2.1, both as
+ * published by the Free Software Foundation.
+ */
+
+#ifndef ARDUINOCORE_API_CAN_MSG_RING_BUFFER_H_
+#define ARDUINOCORE_API_CAN_MSG_RING_BUFFER_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "CanMsg.h"
+
+/**************************************************************************************
+ * DEFINE
+ **************************************************************************************/
+
+#ifndef CAN_MSG_RINGBUFFER_CACHE_LINE
+#define CAN_MSG_RINGBUFFER_CACHE_LINE 64
+#endif
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace arduino
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/**
+ * Lock-free single-producer / single-consumer queue of CanMsg.
+ *
+ * Exactly one context (typically the driver ISR or RX task) may call enqueue(),
+ * and exactly one other context may call dequeue()/peek(). Neither side ever
+ * blocks or waits on the other: a push into a full buffer fails immediately and
+ * is counted in overflows(), so frames are never lost silently.
+ *
+ * The producer and consumer indices live on separate cache lines so the two
+ * cores do not invalidate each other's line on every frame.
+ */
+template <size_t N>
+class BasicCanMsgRingbuffer
+{
+public:
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "ring buffer size must be a power of two");
+
+  static size_t constexpr RING_BUFFER_SIZE = N;
+
+  BasicCanMsgRingbuffer()
+  : _head{0}
+  , _tail{0}
+  , _overflows{0}
+  , _high_water{0}
+  { }
+
+  /**
+   * Producer side. Wait-free, safe to call from an ISR.
+   *
+   * @return true if the message was stored, false (and overflows() incremented) if the buffer was full
+   */
+  bool enqueue(CanMsg const & msg)
+  {
+    size_t const tail = _tail.load(std::memory_order_relaxed);
+    size_t const head = _head.load(std::memory_order_acquire);
+    size_t const used = tail - head;
+
+    if (used >= N)
+    {
+      _overflows.store(_overflows.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    _buf[tail & MASK] = msg;
+    _tail.store(tail + 1, std::memory_order_release);
+
+    if (used + 1 > _high_water.load(std::memory_order_relaxed))
+      _high_water.store(used + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * Consumer side. Returns an empty message if the buffer is empty.
+   */
+  CanMsg dequeue()
+  {
+    CanMsg msg;
+    dequeue(&msg, 1);
+    return msg;
+  }
+
+  /**
+   * Consumer side. Moves up to max messages into out with a single index update.
+   *
+   * @return the number of messages copied
+   */
+  size_t dequeue(CanMsg * out, size_t const max)
+  {
+    size_t const head = _head.load(std::memory_order_relaxed);
+    size_t const tail = _tail.load(std::memory_order_acquire);
+    size_t n = tail - head;
+    if (n > max)
+      n = max;
+
+    for (size_t i = 0; i < n; i++)
+      out[i] = _buf[(head + i) & MASK];
+
+    _head.store(head + n, std::memory_order_release);
+    return n;
+  }
+
+  /**
+   * Consumer side. Copies the oldest message without removing it.
+   *
+   * @return false if the buffer is empty
+   */
+  bool peek(CanMsg & msg) const
+  {
+    size_t const head = _head.load(std::memory_order_relaxed);
+    if (_tail.load(std::memory_order_acquire) == head)
+      return false;
+    msg = _buf[head & MASK];
+    return true;
+  }
+
+  inline size_t available() const
+  {
+    return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+  }
+  inline bool isEmpty() const { return available() == 0; }
+  inline bool isFull() const { return available() >= N; }
+
+  /* Number of messages rejected because the buffer was full. */
+  inline uint32_t overflows() const { return _overflows.load(std::memory_order_relaxed); }
+  /* Highest fill level seen since construction or the last resetStats(). */
+  inline size_t highWater() const { return _high_water.load(std::memory_order_relaxed); }
+  /* Only call while the producer is idle. */
+  inline void resetStats()
+  {
+    _overflows.store(0, std::memory_order_relaxed);
+    _high_water.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  static size_t constexpr MASK = N - 1;
+
+  /* Consumer owned. */
+  alignas(CAN_MSG_RINGBUFFER_CACHE_LINE) std::atomic<size_t> _head;
+  /* Producer owned. */
+  alignas(CAN_MSG_RINGBUFFER_CACHE_LINE) std::atomic<size_t> _tail;
+  std::atomic<uint32_t> _overflows;
+  std::atomic<size_t> _high_water;
+
+  alignas(CAN_MSG_RINGBUFFER_CACHE_LINE) CanMsg _buf[N];
+};
+
+template <size_t N>
+size_t constexpr BasicCanMsgRingbuffer<N>::RING_BUFFER_SIZE;
+
+typedef BasicCanMsgRingbuffer<32> CanMsgRingbuffer;
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+} /* arduino */
+
+#endif /* ARDUINOCORE_API_CAN_MSG_RING_BUFFER_H_ */
@@ -196,3 +196,223 @@ bool ADS1115::readCalibration(ads1115_gain_t gain, int16_t* hope,
     *actual = (buff[3] << 8) | buff[4];
     return true;
 }
+
+static_assert(ADS1115_FIFO_SIZE >= 2 && ADS1115_FIFO_SIZE <= 128 &&
+                  (ADS1115_FIFO_SIZE & (ADS1115_FIFO_SIZE - 1)) == 0,
+              "ADS1115_FIFO_SIZE must be a power of two up to 128");
+
+// Nominal conversion time per data rate, single shot adds ~25us wake up
+static const uint32_t conversion_us[] = {125000, 62500, 31250, 15625,
+                                         7813,   4000,  2106,  1163};
+
+/*! @brief Start converting in the background
+    @param channels Inputs to convert round robin, NULL keeps the current mux
+    @param rdy_pin GPIO wired to ALERT/RDY, -1 to time conversions instead
+    @return true if the acquisition task is running */
+bool ADS1115::startAcquisition(const ads1115_mux_t* channels, uint8_t count,
+                               int8_t rdy_pin, BaseType_t core,
+                               UBaseType_t priority) {
+    if (_acq_task != NULL) {
+        return false;
+    }
+
+    uint16_t reg_value = 0;
+    if (_i2c.readU16(_addr, ADS1115_REG_CONFIG, &reg_value) == false) {
+        return false;
+    }
+    _acq_saved_config = reg_value & ~(0b0001 << 15);
+
+    if (channels == NULL || count == 0) {
+        _channels[0] = (ads1115_mux_t)((reg_value >> 12) & 0b0111);
+        count        = 1;
+    } else {
+        if (count > ADS1115_MAX_CHANNELS) {
+            count = ADS1115_MAX_CHANNELS;
+        }
+        memcpy(_channels, channels, count * sizeof(ads1115_mux_t));
+    }
+    _channel_count = count;
+    _rdy_pin       = rdy_pin;
+    _acq_period_us = conversion_us[(reg_value >> 5) & 0b0111] + 25;
+
+    // keep PGA and data rate, the loop fills in OS, MUX and MODE
+    _acq_config = reg_value & ((0b0111 << 9) | (0b0111 << 5));
+    if (rdy_pin >= 0) {
+        // ALERT/RDY turns into a conversion ready signal with Hi_thresh MSB
+        // set, Lo_thresh MSB clear and the comparator asserting after one
+        // conversion
+        _i2c.writeU16(_addr, ADS1115_REG_LO_THRESH, 0x0000);
+        _i2c.writeU16(_addr, ADS1115_REG_HI_THRESH, 0x8000);
+    } else {
+        _acq_config |= 0b0011;  // comparator off
+    }
+
+    _fifo_head.store(0);
+    _fifo_tail.store(0);
+    _dropped  = 0;
+    _acq_stop = false;
+
+    if (rdy_pin >= 0) {
+        pinMode(rdy_pin, INPUT_PULLUP);
+        attachInterruptArg(digitalPinToInterrupt(rdy_pin), rdyIsr, this,
+                           FALLING);
+    }
+    TaskHandle_t task;
+    if (xTaskCreatePinnedToCore(acquisitionTask, "ads1115", 3072, this,
+                                priority, &task, core) != pdPASS) {
+        if (rdy_pin >= 0) {
+            detachInterrupt(digitalPinToInterrupt(rdy_pin));
+        }
+        return false;
+    }
+    _acq_task = task;
+    return true;
+}
+
+/*! @brief Stop the acquisition task and restore the previous config */
+void ADS1115::stopAcquisition() {
+    if (_acq_task == NULL) {
+        return;
+    }
+    if (_rdy_pin >= 0) {
+        detachInterrupt(digitalPinToInterrupt(_rdy_pin));
+    }
+    // let the task finish its I2C transaction instead of deleting it mid-way
+    _acq_stop = true;
+    xTaskNotifyGive(_acq_task);
+    while (_acq_task != NULL) {
+        delay(1);
+    }
+}
+
+bool ADS1115::isAcquiring() {
+    return _acq_task != NULL;
+}
+
+/*! @brief Number of queued samples */
+uint8_t ADS1115::available() {
+    return _fifo_tail.load(std::memory_order_acquire) -
+           _fifo_head.load(std::memory_order_relaxed);
+}
+
+/*! @brief Take the oldest queued sample, never blocks
+    @return false if no sample is queued */
+bool ADS1115::readSample(ads1115_sample_t* sample) {
+    uint8_t head = _fifo_head.load(std::memory_order_relaxed);
+    if (_fifo_tail.load(std::memory_order_acquire) == head) {
+        return false;
+    }
+    *sample = _fifo[head & (ADS1115_FIFO_SIZE - 1)];
+    _fifo_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+/*! @brief Samples lost because the FIFO was full */
+uint32_t ADS1115::getDroppedSamples() {
+    return _dropped;
+}
+
+float ADS1115::toMillivolts(int16_t raw) {
+    float calibration =
+        _calibration_factor != 0.0F ? _calibration_factor : 1.0F;
+    return raw * _coefficient * calibration;
+}
+
+void IRAM_ATTR ADS1115::rdyIsr(void* arg) {
+    ADS1115* self   = (ADS1115*)arg;
+    TaskHandle_t task = self->_acq_task;
+    if (task == NULL) {
+        return;
+    }
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(task, &woken);
+    if (woken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+void ADS1115::acquisitionTask(void* arg) {
+    ADS1115* self = (ADS1115*)arg;
+    self->acquisitionLoop();
+    self->_i2c.writeU16(self->_addr, ADS1115_REG_CONFIG,
+                        self->_acq_saved_config);
+    self->_acq_task = NULL;
+    vTaskDelete(NULL);
+}
+
+void ADS1115::acquisitionLoop() {
+    bool ready_pin  = _rdy_pin >= 0;
+    bool continuous = _channel_count == 1;
+    uint8_t channel = 0;
+
+    if (continuous) {
+        // MODE bit clear: the chip free runs, every conversion is one sample
+        ulTaskNotifyTake(pdTRUE, 0);
+        _i2c.writeU16(_addr, ADS1115_REG_CONFIG,
+                      _acq_config | (_channels[0] << 12));
+    }
+
+    TickType_t wake = xTaskGetTickCount();
+    while (!_acq_stop) {
+        if (!continuous) {
+            ulTaskNotifyTake(pdTRUE, 0);
+            _i2c.writeU16(_addr, ADS1115_REG_CONFIG,
+                          _acq_config | (0x01 << 15) |
+                              (_channels[channel] << 12) | (0x01 << 8));
+        }
+
+        bool done;
+        if (continuous && !ready_pin) {
+            vTaskDelayUntil(&wake, pdMS_TO_TICKS((_acq_period_us + 999) / 1000));
+            done = true;
+        } else {
+            done = waitConversion(ready_pin);
+        }
+
+        uint16_t value = 0;
+        if (done && !_acq_stop &&
+            _i2c.readU16(_addr, ADS1115_REG_CONVERSION, &value)) {
+            pushSample((int16_t)value * MEASURING_DIRECTION, channel);
+        }
+
+        if (++channel >= _channel_count) {
+            channel = 0;
+        }
+    }
+}
+
+// Sleeps until the current conversion is ready, false on timeout or stop
+bool ADS1115::waitConversion(bool ready_pin) {
+    TickType_t period = pdMS_TO_TICKS((_acq_period_us + 999) / 1000);
+    if (period == 0) {
+        period = 1;
+    }
+    if (ready_pin) {
+        return ulTaskNotifyTake(pdTRUE, 2 * period + pdMS_TO_TICKS(10)) > 0;
+    }
+
+    // single shot: sleep through the nominal time, then poll OS for the
+    // internal oscillator tolerance
+    vTaskDelay(period);
+    for (uint8_t i = 0; i < 8 && !_acq_stop; i++) {
+        if (!isInConversion()) {
+            return true;
+        }
+        vTaskDelay(period / 8 + 1);
+    }
+    return false;
+}
+
+void ADS1115::pushSample(int16_t raw, uint8_t channel) {
+    uint8_t tail = _fifo_tail.load(std::memory_order_relaxed);
+    if ((uint8_t)(tail - _fifo_head.load(std::memory_order_acquire)) >=
+        ADS1115_FIFO_SIZE) {
+        _dropped = _dropped + 1;
+        return;
+    }
+    ads1115_sample_t& sample = _fifo[tail & (ADS1115_FIFO_SIZE - 1)];
+    sample.timestamp         = micros();
+    sample.raw               = raw;
+    sample.channel           = channel;
+    _fifo_tail.store(tail + 1, std::memory_order_release);
+}
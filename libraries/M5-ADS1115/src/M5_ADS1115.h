@@ -5,8 +5,12 @@
 #include "Wire.h"
 #include "I2C_Class.h"
 
+#include <atomic>
+
 #define ADS1115_REG_CONVERSION 0x00
 #define ADS1115_REG_CONFIG     0x01
+#define ADS1115_REG_LO_THRESH  0x02
+#define ADS1115_REG_HI_THRESH  0x03
 #define ADS1115_I2C_ADDR_0     0x48
 #define ADS1115_I2C_ADDR_1     0x49
 
@@ -19,6 +23,13 @@
 
 #define MEASURING_DIRECTION -1
 
+// Acquisition FIFO depth, must be a power of two
+#ifndef ADS1115_FIFO_SIZE
+#define ADS1115_FIFO_SIZE 16
+#endif
+
+#define ADS1115_MAX_CHANNELS 4
+
 typedef enum {
     ADS1115_PGA_6144 = 0,
     ADS1115_PGA_4096,
@@ -44,6 +55,23 @@ typedef enum {
     ADS1115_MODE_SINGLESHOT,  // default
 } ads1115_mode_t;
 
+typedef enum {
+    ADS1115_MUX_P0_N1 = 0,  // default
+    ADS1115_MUX_P0_N3,
+    ADS1115_MUX_P1_N3,
+    ADS1115_MUX_P2_N3,
+    ADS1115_MUX_P0_GND,
+    ADS1115_MUX_P1_GND,
+    ADS1115_MUX_P2_GND,
+    ADS1115_MUX_P3_GND,
+} ads1115_mux_t;
+
+typedef struct {
+    uint32_t timestamp;  // micros() when the conversion was read
+    int16_t raw;         // same scale and sign as getSingleConversion()
+    uint8_t channel;     // index into the channel list given to startAcquisition()
+} ads1115_sample_t;
+
 class ADS1115 {
    private:
     I2C_Class _i2c;
@@ -51,6 +79,27 @@ class ADS1115 {
     uint8_t _epprom_addr;
     float _coefficient;
 
+    // background acquisition
+    ads1115_mux_t _channels[ADS1115_MAX_CHANNELS];
+    uint8_t _channel_count;
+    int8_t _rdy_pin;
+    uint16_t _acq_config;
+    uint16_t _acq_saved_config;
+    uint32_t _acq_period_us;
+    TaskHandle_t volatile _acq_task = NULL;
+    volatile bool _acq_stop;
+
+    ads1115_sample_t _fifo[ADS1115_FIFO_SIZE];
+    std::atomic<uint8_t> _fifo_head{0};
+    std::atomic<uint8_t> _fifo_tail{0};
+    volatile uint32_t _dropped = 0;
+
+    static void acquisitionTask(void* arg);
+    static void IRAM_ATTR rdyIsr(void* arg);
+    void acquisitionLoop();
+    bool waitConversion(bool ready_pin);
+    void pushSample(int16_t raw, uint8_t channel);
+
    public:
     ads1115_gain_t _gain;
     ads1115_rate_t _rate;
@@ -80,6 +129,26 @@ class ADS1115 {
 
     void setEEPROMAddr(uint8_t addr);
 
+    /*! Background acquisition: a task on 'core' converts the given inputs
+        round robin (continuous mode for a single input) and queues
+        timestamped samples. Pass the ALERT/RDY pin to wake on conversion
+        ready instead of timing the conversions. Gain and rate are taken
+        from the chip, set them first. Don't call the other methods while
+        acquiring, the task owns the bus transactions to the chip. */
+    bool startAcquisition(const ads1115_mux_t* channels = NULL,
+                          uint8_t count = 0, int8_t rdy_pin = -1,
+                          BaseType_t core = 0, UBaseType_t priority = 2);
+    void stopAcquisition();
+    bool isAcquiring();
+
+    uint8_t available();
+    bool readSample(ads1115_sample_t* sample);
+    uint32_t getDroppedSamples();
+
+    /*! Calibrated millivolts of a raw sample (coefficient * factory
+     * calibration) */
+    float toMillivolts(int16_t raw);
+
     void setCalibration(int8_t voltage, uint16_t actual);
     bool saveCalibration(ads1115_gain_t gain, int16_t hope, int16_t actual);
     bool readCalibration(ads1115_gain_t gain, int16_t* hope, int16_t* actual);
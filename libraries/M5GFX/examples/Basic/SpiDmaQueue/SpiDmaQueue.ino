@@ -0,0 +1,169 @@
+// Full screen redraw benchmark for the Bus_SPI DMA queue.
+// The screen is rendered in horizontal strips and sent three ways at 40 and 80 MHz:
+//  serial  : render a strip, push it and wait for the transfer before rendering the next one
+//  flip    : two strips, pushSprite of one while the other is rendered
+//  queued  : three strips handed to Bus_SPI::submitDMA, a strip is reused once its fence has passed
+// Results are printed to Serial and drawn on the screen.
+
+#include <Arduino.h>
+
+#include <M5GFX.h>
+M5GFX display;
+
+static constexpr int strip_lines = 16;
+static constexpr int strip_count = 3;
+static constexpr int frames = 20;
+
+static M5Canvas strips[strip_count];
+static lgfx::Bus_SPI* bus = nullptr;
+
+static void render(M5Canvas& strip, int y0, int frame)
+{
+  int w = strip.width();
+  int h = strip.height();
+  for (int y = 0; y < h; ++y)
+  {
+    int v = (y0 + y + frame * 4) & 0xFF;
+    strip.drawFastHLine(0, y, w, strip.color565(v, 255 - v, (frame * 8) & 0xFF));
+  }
+  for (int i = 0; i < 12; ++i)
+  {
+    int cx = (i * 53 + frame * (i + 3)) % w;
+    int cy = (i * 37 + frame * 5) % display.height();
+    strip.fillCircle(cx, cy - y0, 18, (i & 1) ? TFT_WHITE : TFT_BLACK);
+  }
+  strip.setCursor(4, 4 - y0);
+  strip.setTextColor(TFT_WHITE);
+  strip.printf("frame %d", frame);
+}
+
+static uint32_t run_render_only(void)
+{
+  uint32_t t = micros();
+  for (int f = 0; f < frames; ++f)
+  {
+    for (int y = 0; y < display.height(); y += strip_lines) { render(strips[0], y, f); }
+  }
+  return micros() - t;
+}
+
+static uint32_t run_serial(void)
+{
+  uint32_t t = micros();
+  display.startWrite();
+  for (int f = 0; f < frames; ++f)
+  {
+    for (int y = 0; y < display.height(); y += strip_lines)
+    {
+      render(strips[0], y, f);
+      strips[0].pushSprite(&display, 0, y);
+      display.waitDMA();
+    }
+  }
+  display.endWrite();
+  return micros() - t;
+}
+
+static uint32_t run_flip(void)
+{
+  uint32_t t = micros();
+  int flip = 0;
+  display.startWrite();
+  for (int f = 0; f < frames; ++f)
+  {
+    for (int y = 0; y < display.height(); y += strip_lines)
+    {
+      render(strips[flip], y, f);
+      strips[flip].pushSprite(&display, 0, y);
+      flip ^= 1;
+    }
+  }
+  display.endWrite();
+  return micros() - t;
+}
+
+static uint32_t run_queued(void)
+{
+  uint32_t fences[strip_count] = { 0 };
+  uint32_t t = micros();
+  display.startWrite();
+  for (int f = 0; f < frames; ++f)
+  {
+    // one window for the whole frame, the strips are sent back to back as pixel data.
+    display.setAddrWindow(0, 0, display.width(), display.height());
+    int i = 0;
+    for (int y = 0; y < display.height(); y += strip_lines)
+    {
+      auto& strip = strips[i];
+      bus->waitDMAFence(fences[i]);
+      render(strip, y, f);
+      int lines = std::min(strip_lines, display.height() - y);
+      fences[i] = bus->submitDMA((const uint8_t*)strip.getBuffer(), display.width() * lines * 2);
+      if (++i == strip_count) { i = 0; }
+    }
+  }
+  display.endWrite();
+  return micros() - t;
+}
+
+static void report(const char* name, uint32_t freq, uint32_t us)
+{
+  float ms = us / 1000.0f / frames;
+  Serial.printf("%2u MHz %-7s %7.2f ms/frame %6.2f fps\n", (unsigned)(freq / 1000000), name, ms, 1000.0f / ms);
+}
+
+void setup(void)
+{
+  Serial.begin(115200);
+  display.begin();
+  display.setColorDepth(16);
+
+  auto panel_bus = display.getPanel()->getBus();
+  if (panel_bus == nullptr || panel_bus->busType() != lgfx::bus_type_t::bus_spi)
+  {
+    display.drawString("SPI display required", 0, 0);
+    return;
+  }
+  bus = static_cast<lgfx::Bus_SPI*>(panel_bus);
+
+  for (auto& strip : strips)
+  {
+    strip.setPsram(false);  // DMA capable memory
+    strip.setColorDepth(16);
+    strip.createSprite(display.width(), strip_lines);
+  }
+
+  uint32_t render_us = run_render_only();
+  Serial.printf("render only %7.2f ms/frame\n", render_us / 1000.0f / frames);
+
+  static constexpr uint32_t freqs[] = { 40000000, 80000000 };
+  uint32_t results[2][3];
+  for (int i = 0; i < 2; ++i)
+  {
+    bus->setClock(freqs[i]);
+    results[i][0] = run_serial();
+    report("serial", freqs[i], results[i][0]);
+    results[i][1] = run_flip();
+    report("flip", freqs[i], results[i][1]);
+    results[i][2] = run_queued();
+    report("queued", freqs[i], results[i][2]);
+  }
+
+  display.fillScreen(TFT_BLACK);
+  display.setTextColor(TFT_WHITE, TFT_BLACK);
+  display.setCursor(0, 0);
+  display.printf("render  %6.2f ms\n", render_us / 1000.0f / frames);
+  static constexpr const char* names[] = { "serial", "flip", "queued" };
+  for (int i = 0; i < 2; ++i)
+  {
+    for (int m = 0; m < 3; ++m)
+    {
+      display.printf("%2u MHz %-6s %6.2f ms\n", (unsigned)(freqs[i] / 1000000), names[m], results[i][m] / 1000.0f / frames);
+    }
+  }
+}
+
+void loop(void)
+{
+  delay(1000);
+}
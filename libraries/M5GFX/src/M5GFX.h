@@ -50,6 +50,10 @@
 #include "lgfx/v1/LGFXBase.hpp"
 #include "lgfx/v1/LGFX_Sprite.hpp"
 #include "lgfx/v1/LGFX_Button.hpp"
+#include "lgfx/v1/LGFX_NumberField.hpp"
+#include "lgfx/v1/LGFX_TileCanvas.hpp"
+#include "lgfx/v1/LGFX_Compositor.hpp"
+#include "lgfx/v1/LGFX_SpritePack.hpp"
 
 #include <vector>
 #include <memory>
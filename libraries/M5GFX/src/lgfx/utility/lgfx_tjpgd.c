@@ -24,6 +24,7 @@
 / add support grayscale jpeg
 / add bayer pattern
 / tweak for 32bit processor
+/ add huffman lookup tables
 /----------------------------------------------------------------------------*/
 
 #include "lgfx_tjpgd.h"
@@ -242,6 +243,39 @@ static int32_t create_huffman_tbl (	/* 0:OK, !0:Failed */
 
 
 
+#if JD_FASTHUFF
+/*-----------------------------------------------------------------------*/
+/* Create lookup tables for the huffman codes up to 8 bits               */
+/*-----------------------------------------------------------------------*/
+
+static void create_huffman_lut (
+	lgfxJdec* jd		/* Pointer to the decompressor object */
+)
+{
+	size_t ntbl = jd->comps_in_frame == 1 ? 2 : 4;	/* Tables checked by the SOS segment */
+	for (size_t t = 0; t < ntbl; ++t) {
+		uint_fast8_t num = t >> 1, cls = t & 1;
+		const uint8_t* hb = jd->huffbits[num][cls];
+		uint16_t* lut = (uint16_t*)alloc_pool(jd, 256 * sizeof (uint16_t));
+		if (!lut) return;					/* Not enough memory, huffext searches the code tables */
+		memset(lut, 0, 256 * sizeof (uint16_t));
+		const uint16_t* hc = jd->huffcode[num][cls];
+		const uint8_t* hd = jd->huffdata[num][cls];
+		for (uint_fast8_t bl = 1; bl <= 8; ++bl) {
+			for (size_t n = hb[bl]; n; --n) {	/* Fill every entry that starts with this code */
+				uint_fast16_t code = *++hc << (8 - bl);
+				uint16_t v = (bl << 8) + *++hd;
+				for (size_t k = 0; k < (1u << (8 - bl)); ++k) lut[code + k] = v;
+			}
+		}
+		jd->hufflut[num][cls] = lut;
+	}
+}
+#endif
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Extract N bits from input stream                                      */
 /*-----------------------------------------------------------------------*/
@@ -294,11 +328,30 @@ static int32_t huffext (	/* >=0: decoded data, <0: error code */
 	lgfxJdec* jd,				/* Pointer to the decompressor object */
 	const uint8_t* hb,	/* Pointer to the bit distribution table */
 	const uint16_t* hc,	/* Pointer to the code word table */
-	const uint8_t* hd	/* Pointer to the data table */
+	const uint8_t* hd,	/* Pointer to the data table */
+	const uint16_t* lut	/* Pointer to the lookup table (NULL:none) */
 )
 {
-	const uint8_t* hb_end = hb + 16 + 1;
 	uint_fast8_t msk = jd->dbit;
+#if JD_FASTHUFF
+	/* Look up the next 8 bits while the following byte is in the buffer and is not a flag */
+	uint8_t *dp = jd->dptr;
+	if (lut && dp + 1 < jd->dpend && dp[1] != 0xFF) {
+		uint_fast16_t v = lut[(((dp[0] << 8) + dp[1]) >> msk) & 0xFF];
+		if (v) {
+			uint_fast8_t bl = v >> 8;
+			if (bl > msk) {		/* The code continues into the next byte */
+				jd->dptr = dp + 1;
+				msk += 8;
+			}
+			jd->dbit = msk - bl;
+			return v & 0xFF;
+		}
+	}
+#else
+	(void)lut;
+#endif
+	const uint8_t* hb_end = hb + 16 + 1;
 	uint32_t w = *jd->dptr & ((1ul << msk) - 1);
 	for (;;) {
 		if (!msk) {				/* Next byte? */
@@ -491,7 +544,7 @@ static JRESULT mcu_load (
 		hb = jd->huffbits[id][0];				/* Huffman table for the DC element */
 		hc = jd->huffcode[id][0];
 		hd = jd->huffdata[id][0];
-		b = huffext(jd, hb, hc, hd);			/* Extract a huffman coded data (bit length) */
+		b = huffext(jd, hb, hc, hd, jd->hufflut[id][0]);	/* Extract a huffman coded data (bit length) */
 		if (b < 0) return (JRESULT)(-b);		/* Err: invalid code or input */
 		d = jd->dcv[cmp];						/* DC value of previous block */
 		if (b) {								/* If there is any difference from previous block */
@@ -510,9 +563,10 @@ static JRESULT mcu_load (
 		hb = jd->huffbits[id][1];				/* Huffman table for the AC elements */
 		hc = jd->huffcode[id][1];
 		hd = jd->huffdata[id][1];
+		const uint16_t* lut = jd->hufflut[id][1];
 		uint_fast8_t i = 1;					/* Top of the AC elements */
 		do {
-			b = huffext(jd, hb, hc, hd);		/* Extract a huffman coded value (zero runs and bit length) */
+			b = huffext(jd, hb, hc, hd, lut);	/* Extract a huffman coded value (zero runs and bit length) */
 			if (b == 0) break;					/* EOB? */
 			if (b < 0) return (JRESULT)(-b);	/* Err: invalid code or input error */
 			i += b >> 4;						/* Number of leading zero elements   Skip zero elements */
@@ -780,6 +834,7 @@ JRESULT lgfx_jd_prepare (
 	jd->infunc = infunc;	/* Stream input function */
 	jd->device = dev;		/* I/O device identifier */
 	jd->nrst = 0;			/* No restart interval (default) */
+	memset(jd->hufflut, 0, sizeof(jd->hufflut));	/* Built at SOS if the pool has room */
 
 //	memset(jd->huffbits, 0, sizeof(uint8_t*) * 4);	/* Nulls pointers */
 //	memset(jd->huffcode, 0, sizeof(uint16_t*) * 4);
@@ -903,6 +958,9 @@ JRESULT lgfx_jd_prepare (
 					jd->mcubuf[i] = 128;		/* Cb/Cr clear ( for grayscale )*/
 				}
 			}
+#if JD_FASTHUFF
+			create_huffman_lut(jd);		/* Uses what is left of the pool */
+#endif
 
 			/* Pre-load the JPEG data to extract it from the bit stream */
 			ofs %= JD_SZBUF;						/* Align read offset to JD_SZBUF */
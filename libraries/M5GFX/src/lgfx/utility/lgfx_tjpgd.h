@@ -7,6 +7,7 @@
 / add support grayscale jpeg
 / add bayer pattern
 / tweak for 32bit processor
+/ add huffman lookup tables
 /----------------------------------------------------------------------------*/
 #ifndef __LGFX_TJPGDEC_H__
 #define __LGFX_TJPGDEC_H__
@@ -18,6 +19,8 @@
 #define	JD_USE_SCALE	1	/* Use descaling feature for output */
 #define JD_TBLCLIP		0	/* Use table for saturation (might be a bit faster but increases 1K bytes of code size) */
 #define JD_BAYER		1	/* Use bayer pattern table */
+#define JD_FASTHUFF		1	/* Use 8-bit lookup tables for short huffman codes (needs JD_SZ_FASTHUFF more bytes of memory pool, skipped if the pool is short) */
+#define JD_SZ_FASTHUFF	(4 * 256 * 2)
 
 /*---------------------------------------------------------------------------*/
 
@@ -73,6 +76,7 @@ struct lgfxJdec {
 	uint8_t* huffbits[2][2];	/* Huffman bit distribution tables [id][dcac] */
 	uint16_t* huffcode[2][2];	/* Huffman code word tables [id][dcac] */
 	uint8_t* huffdata[2][2];	/* Huffman decoded data tables [id][dcac] */
+	uint16_t* hufflut[2][2];	/* Lookup tables for codes up to 8 bits, (length << 8) + data, 0:longer code [id][dcac] */
 	int32_t* qttbl[4];			/* Dequantizer tables [id] */
 	void* workbuf;				/* Working buffer for IDCT and RGB output */
 	int16_t* mcubuf;			/* Working buffer for the MCU */
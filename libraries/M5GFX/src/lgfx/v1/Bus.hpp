@@ -77,6 +77,13 @@ namespace lgfx
     /// 現在通信中か否かを返す。true:通信中;
     virtual bool busy(void) const = 0;
 
+    /// 最後に送信を開始したDMA転送のフェンスを返す。;
+    virtual uint32_t getDMAFence(void) const { return 0; }
+
+    /// フェンスのDMA転送が完了し、送信元バッファを再利用できるまで待機する。;
+    /// フェンスを持たないバスでは、次の送信が前回の転送の完了を待つ。;
+    virtual void waitDMAFence(uint32_t) {}
+
     /// DMA転送に必要なペリフェラルの準備を行う。;
     virtual void initDMA(void) = 0;
 
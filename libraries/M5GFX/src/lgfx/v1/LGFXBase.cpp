@@ -33,6 +33,11 @@ Contributors:
 #include <math.h>
 #include <list>
 
+#if defined (ESP_PLATFORM) && !defined (CONFIG_FREERTOS_UNICORE)
+ #include <freertos/queue.h>
+ #define LGFX_JPG_PIPELINE_TASK
+#endif
+
 #ifdef min
 #undef min
 #endif
@@ -2307,6 +2312,153 @@ namespace lgfx
     return sumX;
   }
 
+  template <typename T>
+  void LGFXBase::draw_atlas_glyph(const numeral_atlas_t& atlas, const atlas_glyph_t* glyph, int32_t x, int32_t y, int32_t skip)
+  {
+    int32_t w = glyph->width;
+    int32_t h = atlas.height;
+    const uint8_t* src = &atlas.data[glyph->offset];
+
+    if (skip == 0 && x >= _clip_l && x + w - 1 <= _clip_r && y >= _clip_t && y + h - 1 <= _clip_b)
+    { // whole cell visible : runs become block fills, literals go straight to the panel.
+      bool native = (_write_conv.depth == atlas.depth);
+      setWindow(x, y, x + w - 1, y + h - 1);
+      uint32_t len = w * h;
+      do
+      {
+        uint32_t token = *src++;
+        uint32_t n = (token & 0x7F) + 1;
+        auto px = reinterpret_cast<const T*>(src);
+        if (token & 0x80)
+        {
+          auto pc = create_pc_fast(px);
+          _panel->writePixels(&pc, n, false);
+          src += n * sizeof(T);
+        }
+        else
+        {
+          T c;
+          memcpy(&c, px, sizeof(T));
+          _panel->writeBlock(native ? c.raw : _write_conv.convert(color_convert<rgb888_t, T>(c.get())), n);
+          src += sizeof(T);
+        }
+        len -= n;
+      } while (len);
+      return;
+    }
+
+    // clipped or overlapping the previous cell : decode row by row and let pushImage clip.
+    auto row = (T*)alloca(w * sizeof(T));
+    uint32_t token = 0;
+    uint32_t remain = 0;
+    for (int32_t j = 0; j < h; ++j)
+    {
+      int32_t i = 0;
+      do
+      {
+        if (remain == 0)
+        {
+          token = *src++;
+          remain = (token & 0x7F) + 1;
+        }
+        uint32_t n = std::min<uint32_t>(remain, w - i);
+        if (token & 0x80)
+        {
+          memcpy(&row[i], src, n * sizeof(T));
+          src += n * sizeof(T);
+        }
+        else
+        {
+          T c;
+          memcpy(&c, src, sizeof(T));
+          for (uint32_t k = 0; k < n; ++k) { row[i + k] = c; }
+          if (remain == n) { src += sizeof(T); }
+        }
+        remain -= n;
+        i += n;
+      } while (i < w);
+      if (skip < w)
+      {
+        pushImage(x + skip, y + j, w - skip, 1, &row[skip]);
+      }
+    }
+  }
+
+  size_t LGFXBase::draw_atlas_string(const numeral_atlas_t& atlas, const char *string, int32_t x, int32_t y, textdatum_t datum)
+  {
+    if (!string || !string[0] || atlas.count == 0) return 0;
+    auto space = atlas.find(0x20);
+
+    // same placement as draw_string : the first cell starts at the pen when it extends left of it.
+    int32_t lead = 0;
+    int32_t pen = 0;
+    int32_t cwidth = 0;
+    for (auto tmp = string; *tmp; ++tmp)
+    {
+      uint16_t uniCode = *tmp;
+      if (_text_style.utf8)
+      {
+        uniCode = decodeUTF8(*tmp);
+        if (uniCode < 0x20) continue;
+      }
+      auto glyph = atlas.find(uniCode);
+      if (!glyph && !(glyph = space)) continue;
+      if (pen == 0 && glyph->x < 0) lead = - glyph->x;
+      cwidth = lead + pen + glyph->x + glyph->width;
+      pen += glyph->advance;
+    }
+
+    if (datum & top_center) {           // Horizontal: middle
+      x -= cwidth >> 1;
+    } else if (datum & top_right) {     // Horizontal: right
+      x -= cwidth;
+    }
+    if (datum & middle_left) {          // vertical: middle
+      y -= atlas.height >> 1;
+    } else if (datum & bottom_left) {   // vertical: bottom
+      y -= atlas.height;
+    } else if (datum & baseline_left) { // vertical: baseline
+      y -= atlas.baseline;
+    }
+
+    this->startWrite();
+    pen = x + lead;
+    int32_t filled_x = 0;
+    for (; *string; ++string)
+    {
+      uint16_t uniCode = *string;
+      if (_text_style.utf8)
+      {
+        uniCode = decodeUTF8(*string);
+        if (uniCode < 0x20) continue;
+      }
+      auto glyph = atlas.find(uniCode);
+      if (!glyph && !(glyph = space)) continue;
+      int32_t left = pen + glyph->x;
+      int32_t skip = std::max<int32_t>(0, filled_x - left);
+      if (atlas.depth == grayscale_8bit)
+      {
+        draw_atlas_glyph<grayscale_t>(atlas, glyph, left, y, skip);
+      }
+      else
+      {
+        draw_atlas_glyph<swap565_t>(atlas, glyph, left, y, skip);
+      }
+      filled_x = left + glyph->width;
+      pen += glyph->advance;
+    }
+    this->endWrite();
+
+    return pen - x;
+  }
+
+  size_t LGFXBase::drawAtlasNumber(const numeral_atlas_t& atlas, long long_num, int32_t x, int32_t y)
+  {
+    constexpr size_t len = 8 * sizeof(long) + 1;
+    char buf[len];
+    return drawAtlasString(atlas, numberToStr(long_num, buf, len, 10), x, y);
+  }
+
   size_t LGFXBase::write(uint8_t utf8)
   {
     if (utf8 == '\r') return 1;
@@ -2891,9 +3043,33 @@ namespace lgfx
     }
   };
 
+  struct jpg_row_t
+  {
+    uint8_t* data;    // nullptr : end of image
+    int32_t top;
+    uint32_t height;
+  };
+
+  /// MCU rows are decoded into one buffer while the other one is pushed,
+  /// by a task on the other core if there is one, otherwise by DMA.
+  struct jpg_pipeline_t
+  {
+    static constexpr size_t rows = 2;
+    uint8_t* buf[rows] = { nullptr, nullptr };
+    uint32_t stride = 0;    // pixels
+    size_t fill = 0;        // buffer being decoded into
+    int32_t top = -1;       // image y of the row being decoded, -1 : none yet
+    uint32_t height = 0;
+#if defined (LGFX_JPG_PIPELINE_TASK)
+    QueueHandle_t filled = nullptr;
+    QueueHandle_t freed = nullptr;  // buffer indexes, then `rows` once the task is done
+#endif
+  };
+
   struct draw_jpg_info_t : public image_decoder_t
   {
     pixelcopy_t *pc;
+    jpg_pipeline_t *pipe = nullptr;
   };
 
   static uint32_t jpg_push_image(void *device, void *bitmap, JRECT *rect)
@@ -2936,6 +3112,132 @@ namespace lgfx
     return 1;
   }
 
+  static void jpg_push_row(draw_jpg_info_t *jpeg, const jpg_row_t& row)
+  {
+    jpeg->pc->src_data = row.data;
+    jpeg->pc->src_x32_add = 1 << FP_SCALE;
+    jpeg->pc->src_y32_add = 0;
+    jpeg->gfx->pushImage( jpeg->x
+                        , jpeg->y + row.top
+                        , jpeg->pipe->stride
+                        , row.height
+                        , jpeg->pc
+                        , true);
+    // without conversion the panel sends straight from the row buffer
+    if (jpeg->pc->no_convert) { jpeg->gfx->waitDMA(); }
+  }
+
+#if defined (LGFX_JPG_PIPELINE_TASK)
+  static void jpg_pipeline_task(void *arg)
+  {
+    draw_jpg_info_t *jpeg = static_cast<draw_jpg_info_t*>(arg);
+    auto pipe = jpeg->pipe;
+    jpg_row_t row;
+    while (xQueueReceive(pipe->filled, &row, portMAX_DELAY) == pdTRUE && row.data)
+    {
+      jpg_push_row(jpeg, row);
+      size_t index = (row.data == pipe->buf[0]) ? 0 : 1;
+      xQueueSend(pipe->freed, &index, portMAX_DELAY);
+    }
+    size_t done = jpg_pipeline_t::rows;
+    xQueueSend(pipe->freed, &done, portMAX_DELAY);
+    vTaskDelete(nullptr);
+  }
+#endif
+
+  /// Hand the decoded row over and switch to a free buffer.
+  static void jpg_pipeline_submit(draw_jpg_info_t *jpeg)
+  {
+    auto pipe = jpeg->pipe;
+    jpg_row_t row = { pipe->buf[pipe->fill], pipe->top, pipe->height };
+#if defined (LGFX_JPG_PIPELINE_TASK)
+    if (pipe->filled)
+    {
+      xQueueSend(pipe->filled, &row, portMAX_DELAY);
+      xQueueReceive(pipe->freed, &pipe->fill, portMAX_DELAY);
+      return;
+    }
+#endif
+    jpg_push_row(jpeg, row);
+    pipe->fill ^= 1;
+  }
+
+  static uint32_t jpg_push_image_pipeline(void *device, void *bitmap, JRECT *rect)
+  {
+    draw_jpg_info_t *jpeg = static_cast<draw_jpg_info_t*>(device);
+    auto pipe = jpeg->pipe;
+    if (pipe->top != (int32_t)rect->top)
+    {
+      if (pipe->top >= 0) { jpg_pipeline_submit(jpeg); }
+      pipe->top = rect->top;
+      pipe->height = rect->bottom - rect->top + 1;
+    }
+    uint32_t len = (rect->right - rect->left + 1) * 3;
+    auto src = static_cast<const uint8_t*>(bitmap);
+    auto dst = &pipe->buf[pipe->fill][rect->left * 3];
+    for (uint32_t h = pipe->height; h; --h)
+    {
+      memcpy(dst, src, len);
+      src += len;
+      dst += pipe->stride * 3;
+    }
+    return 1;
+  }
+
+  /// leaves jpeg->pipe unset if the row buffers do not fit.
+  static void jpg_pipeline_begin(draw_jpg_info_t *jpeg, jpg_pipeline_t *pipe, const lgfxJdec& jd, uint_fast8_t div)
+  {
+    pipe->stride = jd.width >> div;
+    size_t len = pipe->stride * ((jd.msy * 8) >> div) * 3;
+    for (size_t i = 0; i < jpg_pipeline_t::rows; ++i)
+    {
+      pipe->buf[i] = (uint8_t*)heap_alloc_dma(len);
+      if (!pipe->buf[i]) { return; }
+    }
+    jpeg->pipe = pipe;
+#if defined (LGFX_JPG_PIPELINE_TASK)
+    pipe->filled = xQueueCreate(jpg_pipeline_t::rows, sizeof(jpg_row_t));
+    pipe->freed = xQueueCreate(jpg_pipeline_t::rows, sizeof(size_t));
+    if (pipe->filled && pipe->freed
+     && pdPASS == xTaskCreatePinnedToCore(jpg_pipeline_task, "jpg", 4096, jpeg, uxTaskPriorityGet(nullptr), nullptr, xPortGetCoreID() ^ 1))
+    {
+      size_t index = 1;
+      xQueueSend(pipe->freed, &index, 0);
+      pipe->fill = 0;
+      return;
+    }
+    if (pipe->filled) { vQueueDelete(pipe->filled); pipe->filled = nullptr; }
+    if (pipe->freed ) { vQueueDelete(pipe->freed ); pipe->freed  = nullptr; }
+#endif
+  }
+
+  static void jpg_pipeline_end(draw_jpg_info_t *jpeg, jpg_pipeline_t *pipe)
+  {
+    if (jpeg->pipe)
+    {
+      if (pipe->top >= 0) { jpg_pipeline_submit(jpeg); }
+#if defined (LGFX_JPG_PIPELINE_TASK)
+      if (pipe->filled)
+      {
+        jpg_row_t end = { nullptr, 0, 0 };
+        xQueueSend(pipe->filled, &end, portMAX_DELAY);
+        size_t index;
+        do
+        {
+          xQueueReceive(pipe->freed, &index, portMAX_DELAY);
+        } while (index < jpg_pipeline_t::rows);
+        vQueueDelete(pipe->filled);
+        vQueueDelete(pipe->freed);
+      }
+#endif
+      jpeg->gfx->waitDMA();
+    }
+    for (size_t i = 0; i < jpg_pipeline_t::rows; ++i)
+    {
+      if (pipe->buf[i]) { heap_free(pipe->buf[i]); }
+    }
+  }
+
   bool LGFXBase::draw_jpg(DataWrapper* data, int32_t x, int32_t y, int32_t maxWidth, int32_t maxHeight, int32_t offX, int32_t offY, float zoom_x, float zoom_y, datum_t datum)
   {
     prepareTmpTransaction(data);
@@ -2947,7 +3249,7 @@ namespace lgfx
     //TJpgD jpegdec;
     lgfxJdec jpegdec;
 
-    static constexpr uint16_t sz_pool = 3900;
+    static constexpr uint16_t sz_pool = 3900 + (JD_FASTHUFF ? JD_SZ_FASTHUFF : 0);
     uint8_t *pool = (uint8_t*)malloc(sz_pool);
     if (!pool)
     {
@@ -2997,7 +3299,17 @@ namespace lgfx
 
     this->startWrite(!data->hasParent());
 
-    jres = lgfx_jd_decomp(&jpegdec, drawinfo.zoom_x == 1.0f && drawinfo.zoom_y == 1.0f ? jpg_push_image : jpg_push_image_affine, div);
+    bool unscaled = drawinfo.zoom_x == 1.0f && drawinfo.zoom_y == 1.0f;
+    jpg_pipeline_t pipe;
+    // a stream sharing the bus with the panel has to be read between pushes
+    if (_jpg_pipeline && unscaled && !data->hasParent())
+    {
+      jpg_pipeline_begin(&drawinfo, &pipe, jpegdec, div);
+    }
+
+    jres = lgfx_jd_decomp(&jpegdec, drawinfo.pipe ? jpg_push_image_pipeline : unscaled ? jpg_push_image : jpg_push_image_affine, div);
+
+    jpg_pipeline_end(&drawinfo, &pipe);
 
     drawinfo.end();
     this->endWrite();
@@ -29,6 +29,7 @@ Contributors:
 #include "misc/colortype.hpp"
 #include "misc/pixelcopy.hpp"
 #include "misc/DataWrapper.hpp"
+#include "misc/numeral_atlas.hpp"
 #include "lgfx_fonts.hpp"
 #include "Touch.hpp"
 #include "panel/Panel_Device.hpp"
@@ -317,6 +318,11 @@ namespace lgfx
     LGFX_INLINE   bool isEPD(void) const { return _panel->isEpd(); }
     LGFX_INLINE   bool getSwapBytes(void) const { return _swapBytes; }
     LGFX_INLINE   void setSwapBytes(bool swap) { _swapBytes = swap; }
+    /// drawJpg at 1:1 decodes MCU rows into two row buffers and pushes finished rows from the other core
+    /// (or by DMA on single core chips) while the next row is decoded. Needs 2 * 16 rows of the image width
+    /// in 24 bit color while drawing. Not used for files on a bus shared with the panel.
+    LGFX_INLINE   bool getJpgPipeline(void) const { return _jpg_pipeline; }
+    LGFX_INLINE   void setJpgPipeline(bool enable) { _jpg_pipeline = enable; }
     LGFX_INLINE   bool isBusShared(void) const { return _panel->isBusShared(); }
     [[deprecated("use isBusShared()")]]
     LGFX_INLINE   bool isSPIShared(void) const { return _panel->isBusShared(); }
@@ -328,6 +334,8 @@ namespace lgfx
     LGFX_INLINE   void initDMA(void) { _panel->initDMA(); }
     LGFX_INLINE   void waitDMA(void) { _panel->waitDMA(); }
     LGFX_INLINE   bool dmaBusy(void) { return _panel->dmaBusy(); }
+    LGFX_INLINE   uint32_t getDMAFence(void) { return _panel->getDMAFence(); }
+    LGFX_INLINE   void waitDMAFence(uint32_t fence) { _panel->waitDMAFence(fence); }
 
     LGFX_INLINE_T void setScrollRect(int32_t x, int32_t y, int32_t w, int32_t h, const T& color) { setBaseColor(color); setScrollRect(x, y, w, h); }
 
@@ -768,6 +776,13 @@ namespace lgfx
       //return (fpDrawChar)(this, x, y, uniCode, &style, _font);
     }
 
+    /// Draw a string with a pre-rendered numeral atlas (tools/numeral_atlas) instead of the font rasterizer.
+    /// Glyph cells are written as runs and pixel blocks in the atlas colors; characters missing from the atlas use its space glyph.
+    /// returns the pen advance like drawString.
+    inline size_t drawAtlasString(const numeral_atlas_t& atlas, const char *string, int32_t x, int32_t y) { return draw_atlas_string(atlas, string, x, y, _text_style.datum); }
+    inline size_t drawAtlasString(const numeral_atlas_t& atlas, const char *string, int32_t x, int32_t y, textdatum_t datum) { return draw_atlas_string(atlas, string, x, y, datum); }
+           size_t drawAtlasNumber(const numeral_atlas_t& atlas, long long_num, int32_t x, int32_t y);
+
     [[deprecated("use getFont()")]]
     uint_fast8_t getTextFont(void) const
     {
@@ -1017,6 +1032,7 @@ namespace lgfx
     float _ypivot = 0.0f;   // x pivot point coordinate
 
     bool _swapBytes = false;
+    bool _jpg_pipeline = false;
 
     enum utf8_decode_state_t : uint8_t
     { utf8_state0 = 0
@@ -1364,6 +1380,9 @@ namespace lgfx
     size_t printNumber(unsigned long n, uint8_t base);
     size_t printFloat(double number, uint8_t digits);
     size_t draw_string(const char *string, int32_t x, int32_t y, textdatum_t datum, const IFont* font = nullptr);
+    size_t draw_atlas_string(const numeral_atlas_t& atlas, const char *string, int32_t x, int32_t y, textdatum_t datum);
+    template <typename T>
+    void draw_atlas_glyph(const numeral_atlas_t& atlas, const atlas_glyph_t* glyph, int32_t x, int32_t y, int32_t skip);
     int32_t text_width(const char *string, const IFont* font, FontMetrics* metrics);
     bool load_font(lgfx::DataWrapper* data);
     bool load_font_with_path(const char *path);
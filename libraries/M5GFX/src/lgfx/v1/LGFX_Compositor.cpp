@@ -0,0 +1,279 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#include "LGFX_Compositor.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  static void merge_rect(range_rect_t& dst, const range_rect_t& src)
+  {
+    if (dst.left   > src.left  ) { dst.left   = src.left;   }
+    if (dst.top    > src.top   ) { dst.top    = src.top;    }
+    if (dst.right  < src.right ) { dst.right  = src.right;  }
+    if (dst.bottom < src.bottom) { dst.bottom = src.bottom; }
+  }
+
+  static uint32_t rect_area(const range_rect_t& r)
+  {
+    return (uint32_t)r.width() * r.height();
+  }
+
+//----------------------------------------------------------------------------
+
+  void LGFX_Layer::setPosition(int32_t x, int32_t y)
+  {
+    if (_x == x && _y == y) { return; }
+    if (_visible) { _owner->_add_rect(_x, _y, width(), height()); }
+    _x = x;
+    _y = y;
+    if (_visible) { _owner->_add_rect(_x, _y, width(), height()); }
+  }
+
+  void LGFX_Layer::setVisible(bool visible)
+  {
+    if (_visible == visible) { return; }
+    _visible = visible;
+    _owner->_add_rect(_x, _y, width(), height());
+  }
+
+  void LGFX_Layer::markDirty(int32_t x, int32_t y, int32_t w, int32_t h)
+  {
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (w > width()  - x) { w = width()  - x; }
+    if (h > height() - y) { h = height() - y; }
+    if (w < 1 || h < 1) { return; }
+    range_rect_t r;
+    r.left = x;
+    r.top = y;
+    r.right = x + w - 1;
+    r.bottom = y + h - 1;
+    merge_rect(_dirty, r);
+  }
+
+  void LGFX_Layer::_set_blend(blend_t blend, uint32_t key)
+  {
+    if (blend == blend_alpha && getColorDepth() != argb8888_4Byte) { return; }
+    _blend = blend;
+    _key = key;
+    markDirty();
+  }
+
+//----------------------------------------------------------------------------
+
+  LGFX_Compositor::~LGFX_Compositor()
+  {
+    for (size_t i = 0; i < _count; ++i) { delete _layers[i]; }
+    _count = 0;
+  }
+
+  LGFX_Layer* LGFX_Compositor::createLayer(int32_t x, int32_t y, int32_t w, int32_t h, color_depth_t depth, int16_t z)
+  {
+    if (_count >= max_layers) { return nullptr; }
+
+    auto layer = new LGFX_Layer(this, _parent);
+    layer->setColorDepth(depth);
+    if (!layer->createSprite(w, h))
+    {
+      delete layer;
+      return nullptr;
+    }
+    layer->_x = x;
+    layer->_y = y;
+    layer->_z = z;
+
+    size_t i = _count;
+    for (; i && _layers[i - 1]->_z > z; --i) { _layers[i] = _layers[i - 1]; }
+    _layers[i] = layer;
+    ++_count;
+
+    layer->markDirty();
+    return layer;
+  }
+
+  void LGFX_Compositor::deleteLayer(LGFX_Layer* layer)
+  {
+    for (size_t i = 0; i < _count; ++i)
+    {
+      if (_layers[i] != layer) { continue; }
+      if (layer->_visible) { _add_rect(layer->_x, layer->_y, layer->width(), layer->height()); }
+      for (--_count; i < _count; ++i) { _layers[i] = _layers[i + 1]; }
+      delete layer;
+      return;
+    }
+  }
+
+  void LGFX_Compositor::invalidate(void)
+  {
+    _rect_count = 0;
+    if (_parent) { _add_rect(0, 0, _parent->width(), _parent->height()); }
+  }
+
+  void LGFX_Compositor::_add_rect(int32_t x, int32_t y, int32_t w, int32_t h)
+  {
+    if (!_parent) { return; }
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (w > _parent->width()  - x) { w = _parent->width()  - x; }
+    if (h > _parent->height() - y) { h = _parent->height() - y; }
+    if (w < 1 || h < 1) { return; }
+
+    range_rect_t r;
+    r.left = x;
+    r.top = y;
+    r.right = x + w - 1;
+    r.bottom = y + h - 1;
+
+    // Merge with every rectangle it overlaps or touches, or whose union costs no more pixels
+    // than sending both. A merge may make the result reach further rectangles, so repeat.
+    for (size_t i = 0; i < _rect_count; )
+    {
+      auto& o = _rects[i];
+      range_rect_t u = o;
+      merge_rect(u, r);
+      bool touch = r.left <= o.right + 1 && o.left <= r.right + 1
+                && r.top <= o.bottom + 1 && o.top <= r.bottom + 1;
+      if (touch || rect_area(u) <= rect_area(o) + rect_area(r))
+      {
+        r = u;
+        _rects[i] = _rects[--_rect_count];
+        i = 0;
+        continue;
+      }
+      ++i;
+    }
+
+    if (_rect_count < max_rects)
+    {
+      _rects[_rect_count++] = r;
+      return;
+    }
+
+    // Out of slots: grow the rectangle that takes the fewest extra pixels.
+    size_t best = 0;
+    uint32_t best_cost = UINT32_MAX;
+    for (size_t i = 0; i < _rect_count; ++i)
+    {
+      range_rect_t u = _rects[i];
+      merge_rect(u, r);
+      uint32_t cost = rect_area(u) - rect_area(_rects[i]);
+      if (best_cost > cost) { best_cost = cost; best = i; }
+    }
+    merge_rect(_rects[best], r);
+  }
+
+  void LGFX_Compositor::_composite(LGFX_Sprite* canvas, const range_rect_t& rect)
+  {
+    // Nothing below the topmost layer that covers the whole strip opaquely is visible.
+    size_t first = 0;
+    bool covered = false;
+    for (size_t i = _count; i--; )
+    {
+      auto layer = _layers[i];
+      if (!layer->_visible || layer->_blend != LGFX_Layer::blend_opaque) { continue; }
+      if (layer->_x <= rect.left && layer->_x + layer->width()  > rect.right
+       && layer->_y <= rect.top  && layer->_y + layer->height() > rect.bottom)
+      {
+        first = i;
+        covered = true;
+        break;
+      }
+    }
+    if (!covered) { canvas->fillScreen(_background); }
+
+    for (size_t i = first; i < _count; ++i)
+    {
+      auto layer = _layers[i];
+      if (!layer->_visible) { continue; }
+      int32_t x = layer->_x - rect.left;
+      int32_t y = layer->_y - rect.top;
+      if (x >= canvas->width() || y >= canvas->height()
+       || x + layer->width() <= 0 || y + layer->height() <= 0) { continue; }
+
+      switch (layer->_blend)
+      {
+      case LGFX_Layer::blend_key:
+        layer->pushSprite(canvas, x, y, layer->_key);
+        break;
+
+      case LGFX_Layer::blend_alpha:
+        canvas->pushAlphaImage(x, y, layer->width(), layer->height(), (const bgra8888_t*)layer->getBuffer());
+        break;
+
+      default:
+        layer->pushSprite(canvas, x, y);
+        break;
+      }
+    }
+  }
+
+  uint32_t LGFX_Compositor::present(void)
+  {
+    _last_rects = 0;
+    _last_pixels = 0;
+    if (!_parent) { return 0; }
+
+    for (size_t i = 0; i < _count; ++i)
+    {
+      auto layer = _layers[i];
+      if (!layer->isDirty()) { continue; }
+      if (layer->_visible)
+      {
+        auto& d = layer->_dirty;
+        _add_rect(layer->_x + d.left, layer->_y + d.top, d.width(), d.height());
+      }
+      layer->_clear_dirty();
+    }
+    if (!_rect_count) { return 0; }
+
+    LGFX_Sprite canvas;
+    canvas.setColorDepth(_parent->getColorDepth());
+    uint32_t bytes = (canvas.getColorDepth() & color_depth_t::bit_mask) >> 3;
+    if (!bytes || _parent->hasPalette() || !_strips.reserve(_parent->width() * bytes)) { return 0; }
+
+    _parent->startWrite();
+    for (size_t i = 0; i < _rect_count; ++i)
+    {
+      auto& r = _rects[i];
+      int32_t w = r.width();
+      _strips.push(_parent, r.left, r.top, w, r.height(), canvas.getColorDepth(), pixelcopy_t::NON_TRANSP,
+        [&](uint8_t* strip, int32_t row, int32_t h)
+        {
+          canvas.setBuffer(strip, w, h);
+          range_rect_t s = r;
+          s.top = r.top + row;
+          s.bottom = s.top + h - 1;
+          _composite(&canvas, s);
+        });
+      _last_pixels += rect_area(r);
+    }
+    _parent->waitDMA();
+    _parent->endWrite();
+    canvas.deleteSprite();
+
+    _last_rects = _rect_count;
+    _rect_count = 0;
+    return _last_pixels;
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
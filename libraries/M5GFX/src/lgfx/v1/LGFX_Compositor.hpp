@@ -0,0 +1,166 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include "LGFX_Sprite.hpp"
+#include "misc/range.hpp"
+#include "misc/StripBuffer.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  class LGFX_Compositor;
+
+  /// One layer of an LGFX_Compositor: a sprite placed on the screen and drawn with the usual calls.
+  /// Every write into the layer is recorded as its dirty area. Rotation 0 only.
+  class LGFX_Layer : public LGFX_Sprite
+  {
+    friend LGFX_Compositor;
+
+  public:
+    enum blend_t : uint8_t
+    {
+      blend_opaque,       // covers everything below it
+      blend_key,          // pixels of the transparent color are skipped
+      blend_alpha,        // per pixel alpha, argb8888 layers only
+    };
+
+    virtual ~LGFX_Layer() { _panel_sprite.setModifiedRange(nullptr); }
+
+    int32_t getX(void) const { return _x; }
+    int32_t getY(void) const { return _y; }
+    bool isVisible(void) const { return _visible; }
+    blend_t getBlend(void) const { return _blend; }
+
+    /// Move the layer; the area it leaves and the area it covers are redrawn on the next present.
+    void setPosition(int32_t x, int32_t y);
+    void setVisible(bool visible);
+
+    /// Skip pixels of this color when compositing (the sprite's own pushSprite transparency).
+    template<typename T>
+    void setTransparentColor(const T& color) { _set_blend(blend_key, convert_to_rgb888(color)); }
+    /// Composite with the alpha channel of the pixels. Requires an argb8888 (32 bit) layer.
+    void setAlphaBlend(void) { _set_blend(blend_alpha, 0); }
+    void setOpaque(void) { _set_blend(blend_opaque, 0); }
+
+    /// Redraw the whole layer, or part of it in layer coordinates, on the next present.
+    /// Only needed after writing to the buffer directly, drawing calls are tracked.
+    void markDirty(void) { markDirty(0, 0, width(), height()); }
+    void markDirty(int32_t x, int32_t y, int32_t w, int32_t h);
+
+    bool isDirty(void) const { return !_dirty.empty(); }
+
+  protected:
+    LGFX_Layer(LGFX_Compositor* owner, LovyanGFX* parent)
+    : LGFX_Sprite(parent)
+    , _owner(owner)
+    {
+      _clear_dirty();
+      _panel_sprite.setModifiedRange(&_dirty);
+    }
+
+    void _clear_dirty(void) { _dirty.left = _dirty.top = INT16_MAX; _dirty.right = _dirty.bottom = INT16_MIN; }
+    void _set_blend(blend_t blend, uint32_t key);
+
+    LGFX_Compositor* _owner;
+    range_rect_t _dirty;      // layer coordinates
+    int32_t _x = 0;
+    int32_t _y = 0;
+    int16_t _z = 0;
+    uint32_t _key = 0;        // rgb888
+    blend_t _blend = blend_opaque;
+    bool _visible = true;
+  };
+
+  /// Composites z-ordered layers onto the parent, touching only what changed.
+  /// present() merges the dirty areas of all layers into a few rectangles, composites each
+  /// rectangle from the topmost layer that covers it opaquely upwards into a strip buffer at
+  /// the parent's color depth, and sends the strips by DMA inside one transaction,
+  /// alternating two buffers so one is composited while the other is sent.
+  ///
+  ///   LGFX_Compositor comp(&display);
+  ///   auto bg = comp.createLayer(0, 0, 320, 240, rgb565_2Byte, 0);
+  ///   auto needle = comp.createLayer(60, 20, 200, 200, rgb565_2Byte, 1);
+  ///   needle->setTransparentColor(TFT_BLACK);
+  ///   loop: needle->fillSprite(TFT_BLACK); needle->drawWedgeLine(...); comp.present();
+  class LGFX_Compositor
+  {
+    friend LGFX_Layer;
+
+  public:
+    static constexpr size_t max_layers = 8;
+    static constexpr size_t max_rects = 8;
+
+    LGFX_Compositor(LovyanGFX* parent, uint32_t strip_bytes = 8192)
+    : _parent(parent)
+    , _strips(strip_bytes)
+    {
+      invalidate();
+    }
+
+    virtual ~LGFX_Compositor();
+
+    LovyanGFX* getParent(void) const { return _parent; }
+
+    /// Create a layer of w x h pixels at x, y. Layers with a higher z are drawn on top,
+    /// equal z in creation order. returns nullptr when out of memory or layers.
+    LGFX_Layer* createLayer(int32_t x, int32_t y, int32_t w, int32_t h, color_depth_t depth, int16_t z = 0);
+    void deleteLayer(LGFX_Layer* layer);
+    size_t getLayerCount(void) const { return _count; }
+
+    /// Color of the screen where no layer is drawn.
+    template<typename T>
+    void setBackgroundColor(const T& color) { _background = convert_to_rgb888(color); invalidate(); }
+
+    /// Redraw the whole screen on the next present (after drawing to the parent directly).
+    void invalidate(void);
+
+    /// Composite and send the dirty areas. returns the number of pixels sent.
+    uint32_t present(void);
+
+    /// Number of rectangles sent by the last present.
+    uint32_t getLastRects(void) const { return _last_rects; }
+    /// Number of pixels sent by the last present.
+    uint32_t getLastPixels(void) const { return _last_pixels; }
+
+  protected:
+    void _add_rect(int32_t x, int32_t y, int32_t w, int32_t h);
+    void _composite(LGFX_Sprite* canvas, const range_rect_t& rect);
+
+    LovyanGFX* _parent;
+    LGFX_Layer* _layers[max_layers];  // bottom to top
+    size_t _count = 0;
+
+    range_rect_t _rects[max_rects];   // screen coordinates
+    size_t _rect_count = 0;
+
+    StripBuffer _strips;              // at least one line of the parent
+    uint32_t _background = 0;
+    uint32_t _last_rects = 0;
+    uint32_t _last_pixels = 0;
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
+
+using LGFX_Layer = lgfx::LGFX_Layer;
+using LGFX_Compositor = lgfx::LGFX_Compositor;
@@ -0,0 +1,242 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+
+#include "LGFX_NumberField.hpp"
+
+#include "LGFXBase.hpp"
+
+#include "../internal/limits.h"
+
+#include <stdio.h>
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  static uint16_t next_code(const char*& str)
+  {
+    uint8_t c = *str++;
+    if (!(c & 0x80)) return c;
+    if ((c & 0xE0) == 0xC0 && (str[0] & 0xC0) == 0x80)
+    {
+      uint16_t res = ((c & 0x1F) << 6) | (str[0] & 0x3F);
+      str += 1;
+      return res;
+    }
+    if ((c & 0xF0) == 0xE0 && (str[0] & 0xC0) == 0x80 && (str[1] & 0xC0) == 0x80)
+    {
+      uint16_t res = ((c & 0x0F) << 12) | ((str[0] & 0x3F) << 6) | (str[1] & 0x3F);
+      str += 2;
+      return res;
+    }
+    return c;
+  }
+
+  void LGFX_NumberField::_init_field( LovyanGFX *gfx, int32_t x, int32_t y, textdatum_t datum, const IFont* font
+                                    , float textsize_x, float textsize_y)
+  {
+    _gfx = gfx;
+    _font = font;
+    _font->getDefaultMetric(&_metrics);
+    _style.size_x = textsize_x > 0 ? textsize_x : 1;
+    _style.size_y = textsize_y <= std::numeric_limits<float>::epsilon() ? _style.size_x : textsize_y;
+    _x = x;
+    _y = y;
+    _datum = datum;
+    _count = 0;
+    _invalid = true;
+  }
+
+  void LGFX_NumberField::setPosition(int32_t x, int32_t y, textdatum_t datum)
+  {
+    if (_x == x && _y == y && _datum == datum) return;
+    _x = x;
+    _y = y;
+    _datum = datum;
+    _invalid = true;
+  }
+
+  /// Computes the same glyph placement and background extents as LGFXBase::draw_string.
+  size_t LGFX_NumberField::_layout(const char* string, cell_t* cells, int32_t& top, int32_t& height)
+  {
+    auto metrics = _metrics;
+    int32_t sx = 65536 * _style.size_x;
+    int32_t sy = 65536 * _style.size_y;
+
+    size_t count = 0;
+    int32_t pen = 0;
+    int32_t filled = INT16_MIN;
+    while (string && *string && count < max_cells)
+    {
+      uint16_t code = next_code(string);
+      if (code < 0x20) continue;
+      _font->updateFontMetric(&metrics, code);
+      int32_t xo  = (metrics.x_offset  * sx) >> 16;
+      int32_t adv = (metrics.x_advance * sx) >> 16;
+      int32_t w   = (metrics.width     * sx) >> 16;
+      if (count == 0 && xo < 0) pen = -xo;
+      auto& c = cells[count++];
+      c.code  = code;
+      c.pos   = pen;
+      c.left  = std::max<int32_t>(filled, pen + (xo < 0 ? xo : 0));
+      c.right = pen + std::max<int32_t>(w + xo, adv);
+      filled = c.right;
+      pen += adv;
+    }
+
+    int32_t cwidth = count ? cells[count - 1].right : 0;
+    height = (_metrics.height * sy) >> 16;
+
+    int32_t x = _x;
+    if (_datum & top_center) {          // Horizontal: middle
+      x -= cwidth >> 1;
+    } else if (_datum & top_right) {    // Horizontal: right
+      x -= cwidth;
+    }
+    top = _y;
+    if (_datum & middle_left) {         // vertical: middle
+      top -= height >> 1;
+    } else if (_datum & bottom_left) {  // vertical: bottom
+      top -= height;
+    } else if (_datum & baseline_left) {// vertical: baseline
+      top -= (_metrics.baseline * sy) >> 16;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      cells[i].pos   += x;
+      cells[i].left  += x;
+      cells[i].right += x;
+    }
+    return count;
+  }
+
+  size_t LGFX_NumberField::drawString(const char* string)
+  {
+    _last_pixels = 0;
+    _last_cells = 0;
+    if (_gfx == nullptr) return 0;
+
+    cell_t cells[max_cells];
+    int32_t top, height;
+    size_t count = _layout(string, cells, top, height);
+    bool redraw_all = _invalid || top != _top || height != _height;
+
+    _gfx->startWrite();
+
+    // background no longer covered by the new string
+    if (_count)
+    {
+      int32_t old_left  = _cells[0].left;
+      int32_t old_right = _cells[_count - 1].right;
+      if (count == 0 || top != _top || height != _height)
+      {
+        _gfx->setColor(_style.back_rgb888);
+        _gfx->writeFillRect(old_left, _top, old_right - old_left, _height);
+        _last_pixels += (old_right - old_left) * _height;
+      }
+      else
+      {
+        int32_t new_left  = cells[0].left;
+        int32_t new_right = cells[count - 1].right;
+        _gfx->setColor(_style.back_rgb888);
+        if (old_left < new_left)
+        {
+          int32_t w = std::min(old_right, new_left) - old_left;
+          _gfx->writeFillRect(old_left, _top, w, _height);
+          _last_pixels += w * _height;
+        }
+        if (new_right < old_right)
+        {
+          int32_t l = std::max(old_left, new_right);
+          _gfx->writeFillRect(l, _top, old_right - l, _height);
+          _last_pixels += (old_right - l) * _height;
+        }
+      }
+    }
+
+    auto metrics = _metrics;
+    int32_t y = top - ((_metrics.y_offset * (int32_t)(65536 * _style.size_y)) >> 16);
+    size_t j = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      const auto& c = cells[i];
+      if (!redraw_all)
+      {
+        // both lists are sorted by pen position
+        while (j < _count && _cells[j].pos < c.pos) { ++j; }
+        if (j < _count
+         && _cells[j].pos   == c.pos
+         && _cells[j].code  == c.code
+         && _cells[j].left  == c.left
+         && _cells[j].right == c.right)
+        {
+          continue;
+        }
+      }
+      _font->updateFontMetric(&metrics, c.code);
+      int32_t filled_x = c.left;
+      _font->drawChar(_gfx, c.pos, y, c.code, &_style, &metrics, filled_x);
+      _last_pixels += (c.right - c.left) * height;
+      ++_last_cells;
+    }
+
+    _gfx->endWrite();
+
+    memcpy(_cells, cells, count * sizeof(cell_t));
+    _count = count;
+    _top = top;
+    _height = height;
+    _invalid = false;
+    return _last_cells;
+  }
+
+  size_t LGFX_NumberField::drawNumber(long value)
+  {
+    char buf[8 * sizeof(long) + 2];
+    snprintf(buf, sizeof(buf), "%ld", value);
+    return drawString(buf);
+  }
+
+  size_t LGFX_NumberField::drawFloat(float value, uint8_t dp)
+  {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%.*f", (int)dp, value);
+    return drawString(buf);
+  }
+
+  void LGFX_NumberField::clear(void)
+  {
+    if (_gfx && _count)
+    {
+      int32_t left  = _cells[0].left;
+      int32_t right = _cells[_count - 1].right;
+      _gfx->startWrite();
+      _gfx->setColor(_style.back_rgb888);
+      _gfx->writeFillRect(left, _top, right - left, _height);
+      _gfx->endWrite();
+    }
+    _count = 0;
+    _invalid = true;
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
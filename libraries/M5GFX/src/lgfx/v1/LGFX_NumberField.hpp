@@ -0,0 +1,118 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include "misc/colortype.hpp"
+#include "misc/enum.hpp"
+#include "lgfx_fonts.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  class LovyanGFX;
+
+  /// Text field for frequently changing values (gauges, counters).
+  /// Remembers the glyphs it drew last time and only redraws the glyph cells that changed,
+  /// the background of a redrawn cell is filled by the glyph write itself.
+  /// Pixels left over from a longer previous string are cleared with the background color.
+  /// A background color different from the text color is required.
+  class LGFX_NumberField
+  {
+  public:
+    static constexpr size_t max_cells = 16;
+
+    template<typename T>
+    void init( LovyanGFX *gfx, int32_t x, int32_t y, textdatum_t datum, const IFont* font
+             , const T& textcolor, const T& bgcolor, float textsize_x = 1.0f, float textsize_y = 0.0f)
+    {
+      _style.fore_rgb888 = lgfx::convert_to_rgb888(textcolor);
+      _style.back_rgb888 = lgfx::convert_to_rgb888(bgcolor);
+      _init_field(gfx, x, y, datum, font, textsize_x, textsize_y);
+    }
+
+    template<typename T>
+    void setTextColor(const T& textcolor, const T& bgcolor)
+    {
+      uint32_t fg = lgfx::convert_to_rgb888(textcolor);
+      uint32_t bg = lgfx::convert_to_rgb888(bgcolor);
+      if (fg != _style.fore_rgb888 || bg != _style.back_rgb888)
+      {
+        _style.fore_rgb888 = fg;
+        _style.back_rgb888 = bg;
+        invalidate();
+      }
+    }
+
+    void setPosition(int32_t x, int32_t y, textdatum_t datum);
+
+    /// Draw the value, touching only the glyph cells that differ from the previous call.
+    /// returns the number of glyph cells written.
+    size_t drawString(const char* string);
+    size_t drawNumber(long value);
+    size_t drawFloat(float value, uint8_t dp);
+
+    /// Forget the previous contents; the next draw writes every cell (after fillScreen etc.)
+    void invalidate(void) { _invalid = true; }
+
+    /// Clear the area covered by the last drawn string and forget it.
+    void clear(void);
+
+    /// Number of pixels written by the last draw, including background.
+    uint32_t getLastPixels(void) const { return _last_pixels; }
+    /// Number of glyph cells written by the last draw.
+    size_t getLastCells(void) const { return _last_cells; }
+
+  private:
+    struct cell_t
+    {
+      uint16_t code;
+      int16_t pos;    // pen x
+      int16_t left;   // background extent [left, right)
+      int16_t right;
+    };
+
+    void _init_field( LovyanGFX *gfx, int32_t x, int32_t y, textdatum_t datum, const IFont* font
+                    , float textsize_x, float textsize_y);
+    size_t _layout(const char* string, cell_t* cells, int32_t& top, int32_t& height);
+
+    LovyanGFX *_gfx = nullptr;
+    const IFont* _font = nullptr;
+    TextStyle _style;
+    FontMetrics _metrics;
+    int32_t _x = 0;
+    int32_t _y = 0;
+    textdatum_t _datum = top_left;
+
+    cell_t _cells[max_cells];
+    size_t _count = 0;
+    int32_t _top = 0;
+    int32_t _height = 0;
+    bool _invalid = true;
+
+    uint32_t _last_pixels = 0;
+    size_t _last_cells = 0;
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
+
+using LGFX_NumberField = lgfx::LGFX_NumberField;
@@ -122,10 +122,12 @@ namespace lgfx
     _ypos = ys;
     _ys = ys;
     _ye = ye;
+    _add_modified(xs, ys, xe - xs + 1, ye - ys + 1);
   }
 
   void Panel_Sprite::drawPixelPreclipped(uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor)
   {
+    _add_modified(x, y, 1, 1);
     uint_fast8_t r = _rotation;
     if (r)
     {
@@ -165,6 +167,7 @@ namespace lgfx
 
   void Panel_Sprite::writeFillRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor)
   {
+    _add_modified(x, y, w, h);
     uint_fast8_t r = _rotation;
     if (r)
     {
@@ -432,6 +435,7 @@ namespace lgfx
 
   void Panel_Sprite::writeImage(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool)
   {
+    _add_modified(x, y, w, h);
     uint_fast8_t r = _rotation;
     if (r == 0 && param->transp == pixelcopy_t::NON_TRANSP && param->no_convert && _img.use_memcpy())
     {
@@ -492,6 +496,7 @@ namespace lgfx
 
   void Panel_Sprite::writeImageARGB(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param)
   {
+    _add_modified(x, y, w, h);
     uint32_t nextx = 0;
     uint32_t nexty = 1 << pixelcopy_t::FP_SCALE;
     if (_rotation)
@@ -611,6 +616,7 @@ namespace lgfx
 
   void Panel_Sprite::copyRect(uint_fast16_t dst_x, uint_fast16_t dst_y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t src_x, uint_fast16_t src_y)
   {
+    _add_modified(dst_x, dst_y, w, h);
     uint_fast8_t r = _rotation;
     if (r)
     {
@@ -22,6 +22,7 @@ Contributors:
 #include "LGFXBase.hpp"
 #include "misc/SpriteBuffer.hpp"
 #include "misc/bitmap.hpp"
+#include "misc/range.hpp"
 #include "Panel.hpp"
 
 namespace lgfx
@@ -89,7 +90,19 @@ namespace lgfx
 
     uint32_t readPixelValue(uint_fast16_t x, uint_fast16_t y);
 
+    /// Merge the area of every following write into *range (sprite coordinates). nullptr stops tracking.
+    LGFX_INLINE void setModifiedRange(range_rect_t* range) { _range_mod = range; }
+
   protected:
+    void _add_modified(int_fast16_t x, int_fast16_t y, int_fast16_t w, int_fast16_t h)
+    {
+      if (_range_mod == nullptr) return;
+      _range_mod->left   = std::min<int_fast16_t>(_range_mod->left  , x        );
+      _range_mod->right  = std::max<int_fast16_t>(_range_mod->right , x + w - 1);
+      _range_mod->top    = std::min<int_fast16_t>(_range_mod->top   , y        );
+      _range_mod->bottom = std::max<int_fast16_t>(_range_mod->bottom, y + h - 1);
+    }
+
     void _rotate_pixelcopy(uint_fast16_t& x, uint_fast16_t& y, uint_fast16_t& w, uint_fast16_t& h, pixelcopy_t* param, uint32_t& nextx, uint32_t& nexty);
 
     SpriteBuffer _img;
@@ -99,6 +112,7 @@ namespace lgfx
     uint_fast16_t _panel_width;   // rotationしていない状態の幅;
     uint_fast16_t _panel_height;  // rotationしていない状態の高さ;
     uint_fast16_t _bitwidth;
+    range_rect_t* _range_mod = nullptr;
   };
 
   class LGFX_Sprite : public LovyanGFX
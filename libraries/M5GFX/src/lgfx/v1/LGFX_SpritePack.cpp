@@ -0,0 +1,189 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#include "LGFX_SpritePack.hpp"
+
+#if defined (ESP_PLATFORM)
+ #include <esp_partition.h>
+ #if __has_include(<esp_idf_version.h>)
+  #include <esp_idf_version.h>
+ #endif
+#endif
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  bool LGFX_SpritePack::open(const void* data, uint32_t length)
+  {
+    close();
+    auto header = (const sprite_pack_header_t*)data;
+    if (!data || length < sizeof(sprite_pack_header_t)
+     || header->magic != sprite_pack_magic
+     || header->version != sprite_pack_version
+     || header->size > length
+     || sizeof(sprite_pack_header_t) + header->count * sizeof(sprite_pack_entry_t) > header->size)
+    {
+      return false;
+    }
+    uint32_t bits = header->depth & color_depth_t::bit_mask;
+    if (bits != 8 && bits != 16 && bits != 24) { return false; }
+
+    auto entries = (const sprite_pack_entry_t*)&header[1];
+    for (size_t i = 0; i < header->count; ++i)
+    {
+      auto& e = entries[i];
+      if (e.offset > header->size || e.size > header->size - e.offset) { return false; }
+      if (e.encoding == sprite_pack_raw && e.size < (uint32_t)e.width * e.height * (bits >> 3)) { return false; }
+    }
+    _data = (const uint8_t*)data;
+    _header = header;
+    _entries = entries;
+    return true;
+  }
+
+  bool LGFX_SpritePack::load(DataWrapper* data)
+  {
+    close();
+    sprite_pack_header_t header;
+    data->preRead();
+    bool res = false;
+    if (data->read((uint8_t*)&header, sizeof(header)) == sizeof(header)
+     && header.magic == sprite_pack_magic
+     && header.size >= sizeof(header))
+    {
+      _loaded = (uint8_t*)heap_alloc_psram(header.size);
+      if (!_loaded) { _loaded = (uint8_t*)heap_alloc(header.size); }
+      if (_loaded)
+      {
+        memcpy(_loaded, &header, sizeof(header));
+        uint32_t len = header.size - sizeof(header);
+        res = (uint32_t)data->read(&_loaded[sizeof(header)], len, len) == len;
+      }
+    }
+    data->postRead();
+
+    // open() starts with close(), which would free the copy.
+    auto loaded = _loaded;
+    _loaded = nullptr;
+    if (res && open(loaded, header.size))
+    {
+      _loaded = loaded;
+      return true;
+    }
+    if (loaded) { heap_free(loaded); }
+    return false;
+  }
+
+#if defined (ESP_PLATFORM)
+  bool LGFX_SpritePack::openPartition(const char* label)
+  {
+    close();
+    auto part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (!part) { return false; }
+
+    const void* ptr = nullptr;
+#if defined ESP_IDF_VERSION_MAJOR && ESP_IDF_VERSION_MAJOR >= 5
+    esp_partition_mmap_handle_t handle;
+    if (ESP_OK != esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &ptr, &handle)) { return false; }
+#else
+    spi_flash_mmap_handle_t handle;
+    if (ESP_OK != esp_partition_mmap(part, 0, part->size, SPI_FLASH_MMAP_DATA, &ptr, &handle)) { return false; }
+#endif
+    _mmap_handle = handle;
+    _mapped = true;
+    if (open(ptr, part->size)) { return true; }
+    close();
+    return false;
+  }
+#endif
+
+  void LGFX_SpritePack::close(void)
+  {
+#if defined (ESP_PLATFORM)
+    if (_mapped)
+    {
+#if defined ESP_IDF_VERSION_MAJOR && ESP_IDF_VERSION_MAJOR >= 5
+      esp_partition_munmap(_mmap_handle);
+#else
+      spi_flash_munmap(_mmap_handle);
+#endif
+    }
+#endif
+    _mapped = false;
+    if (_loaded)
+    {
+      heap_free(_loaded);
+      _loaded = nullptr;
+    }
+    _data = nullptr;
+    _header = nullptr;
+    _entries = nullptr;
+    _strips.release();
+  }
+
+  bool LGFX_SpritePack::push(LovyanGFX* dst, uint16_t id, int32_t x, int32_t y)
+  {
+    auto e = getEntry(id);
+    if (!e) { return false; }
+    int32_t w = e->width;
+    int32_t h = e->height;
+    if (!w || !h) { return true; }
+
+    auto depth = getColorDepth();
+    uint32_t transp = (e->flags & sprite_pack_entry_t::flag_transparent) ? e->transparent : pixelcopy_t::NON_TRANSP;
+    auto src = &_data[e->offset];
+
+    if (e->encoding == sprite_pack_raw)
+    {
+      // flash and PSRAM are not DMA capable, the panel copies from here.
+      pixelcopy_t pc(src, dst->getColorDepth(), depth, dst->hasPalette(), nullptr, transp);
+      dst->pushImage(x, y, w, h, &pc, false);
+      return true;
+    }
+
+    // Skip the expansion of rows above and below the clip rect; the rows above still have to
+    // be decoded, as tokens run across rows.
+    int32_t cx, cy, cw, ch;
+    dst->getClipRect(&cx, &cy, &cw, &ch);
+    if (x >= cx + cw || y >= cy + ch || x + w <= cx || y + h <= cy) { return true; }
+    int32_t y_end = std::min(h, cy + ch - y);
+
+    uint32_t bytes = (depth & color_depth_t::bit_mask) >> 3;
+    if (!_strips.reserve(w * bytes)) { return false; }
+
+    sprite_pack_decoder_t decoder;
+    decoder.begin(src, e->encoding, bytes);
+    int32_t y_begin = std::max(0, cy - y);
+    for (int32_t row = y_begin; row > 0; --row)
+    {
+      decoder.decode(_strips.get(0), w);
+    }
+
+    dst->startWrite();
+    _strips.push(dst, x, y + y_begin, w, y_end - y_begin, depth, transp,
+      [&](uint8_t* strip, int32_t, int32_t rows) { decoder.decode(strip, w * rows); });
+    dst->waitDMA();
+    dst->endWrite();
+    return true;
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
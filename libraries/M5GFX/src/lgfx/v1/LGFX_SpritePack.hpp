@@ -0,0 +1,90 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include "LGFXBase.hpp"
+#include "misc/sprite_pack.hpp"
+#include "misc/DataWrapper.hpp"
+#include "misc/StripBuffer.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  /// Draws images of a sprite pack (see misc/sprite_pack.hpp) by id. The pixels are already in
+  /// the panel format, so a raw entry is a single pushImage and an rle / qoi entry is expanded
+  /// strip by strip into two DMA buffers; no PNG / JPEG decoder runs.
+  ///
+  ///   LGFX_SpritePack pack;
+  ///   pack.openPartition("assets");          // or pack.open(assets_pack, sizeof(assets_pack));
+  ///   pack.push(&display, ASSET_BACKGROUND, 0, 0);
+  class LGFX_SpritePack
+  {
+  public:
+    LGFX_SpritePack(void) = default;
+    LGFX_SpritePack(const LGFX_SpritePack&) = delete;
+    LGFX_SpritePack& operator=(const LGFX_SpritePack&) = delete;
+    virtual ~LGFX_SpritePack(void) { close(); }
+
+    /// Use a pack in memory (a const array in flash, or a region mapped by the caller).
+    /// The data must stay valid until close.
+    bool open(const void* data, uint32_t length);
+
+    /// Copy a pack from a file or stream into PSRAM (heap when there is none).
+    bool load(DataWrapper* data);
+
+#if defined (ESP_PLATFORM)
+    /// Memory-map a data partition holding a pack, e.g. written with
+    /// parttool.py write_partition --partition-name assets --input assets.pack
+    bool openPartition(const char* label);
+#endif
+
+    void close(void);
+
+    bool isOpen(void) const { return _header; }
+    uint16_t getCount(void) const { return _header ? _header->count : 0; }
+    color_depth_t getColorDepth(void) const { return _header ? (color_depth_t)_header->depth : color_depth_t::rgb565_2Byte; }
+    const sprite_pack_entry_t* getEntry(uint16_t id) const { return (id < getCount()) ? &_entries[id] : nullptr; }
+    int32_t width(uint16_t id) const { auto e = getEntry(id); return e ? e->width : 0; }
+    int32_t height(uint16_t id) const { auto e = getEntry(id); return e ? e->height : 0; }
+
+    /// Draw entry id with its top left corner at x, y. Entries with a transparent color skip it.
+    /// returns false for an unknown id.
+    bool push(LovyanGFX* dst, uint16_t id, int32_t x, int32_t y);
+
+    /// Bytes of one expansion strip, at least one row of the entry is used.
+    void setStripBytes(uint32_t bytes) { _strips.setPreferredBytes(bytes); }
+
+  protected:
+    const uint8_t* _data = nullptr;
+    const sprite_pack_header_t* _header = nullptr;
+    const sprite_pack_entry_t* _entries = nullptr;
+    uint8_t* _loaded = nullptr;         // owned copy made by load
+    uint32_t _mmap_handle = 0;
+    bool _mapped = false;
+
+    StripBuffer _strips;
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
+
+using LGFX_SpritePack = lgfx::LGFX_SpritePack;
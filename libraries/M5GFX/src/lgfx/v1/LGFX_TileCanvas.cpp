@@ -0,0 +1,510 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+
+#include "LGFX_TileCanvas.hpp"
+
+#include "misc/pixelcopy.hpp"
+
+#include <string.h>
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  static void fill_raw(uint8_t* dst, uint32_t len, uint32_t rawcolor, uint_fast8_t bytes)
+  {
+    if (bytes == 1)
+    {
+      memset(dst, rawcolor, len);
+    }
+    else if (bytes == 2)
+    {
+      auto d = (uint16_t*)dst;
+      do { *d++ = rawcolor; } while (--len);
+    }
+    else
+    {
+      uint8_t c0 = rawcolor, c1 = rawcolor >> 8, c2 = rawcolor >> 16;
+      do { dst[0] = c0; dst[1] = c1; dst[2] = c2; dst += 3; } while (--len);
+    }
+  }
+
+  color_depth_t Panel_DisplayList::setColorDepth(color_depth_t depth)
+  {
+    // the list stores raw colors in 24 bits and rasterizes whole bytes.
+    if ((depth & color_depth_t::bit_mask) < 8 || (depth & color_depth_t::has_palette))
+    {
+      depth = color_depth_t::rgb332_1Byte;
+    }
+    else if ((depth & color_depth_t::bit_mask) > 24)
+    {
+      depth = color_depth_t::rgb888_3Byte;
+    }
+    if (_write_depth != depth) { _list_used = 0; _last_fill = UINT32_MAX; }
+    _write_depth = depth;
+    _read_depth = depth;
+    return depth;
+  }
+
+  void Panel_DisplayList::setRotation(uint_fast8_t)
+  {
+    _rotation = 0;
+    _xs = 0;
+    _ys = 0;
+    _xe = _width - 1;
+    _ye = _height - 1;
+  }
+
+  void Panel_DisplayList::setWindow(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye)
+  {
+    xs = std::min<uint_fast16_t>(_width  - 1, xs);
+    xe = std::min<uint_fast16_t>(_width  - 1, xe);
+    ys = std::min<uint_fast16_t>(_height - 1, ys);
+    ye = std::min<uint_fast16_t>(_height - 1, ye);
+    _xpos = xs;
+    _xs = xs;
+    _xe = xe;
+    _ypos = ys;
+    _ys = ys;
+    _ye = ye;
+  }
+
+  void Panel_DisplayList::_add_fill(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor)
+  {
+    uint32_t value = (op_fill << 24) | (rawcolor & 0xFFFFFF);
+    if (_last_fill != UINT32_MAX)
+    { // extend the previous fill if this one continues it.
+      auto last = (op_t*)&_list[_last_fill];
+      if (last->value == value)
+      {
+        if (last->y == y && last->h == h && last->x + last->w == x) { last->w += w; return; }
+        if (last->x == x && last->w == w && last->y + last->h == y) { last->h += h; return; }
+      }
+    }
+    if (_list_used + sizeof(op_t) > _list_size)
+    {
+      _overflow = true;
+      return;
+    }
+    auto op = (op_t*)&_list[_list_used];
+    op->x = x;
+    op->y = y;
+    op->w = w;
+    op->h = h;
+    op->value = value;
+    _last_fill = _list_used;
+    _list_used += sizeof(op_t);
+  }
+
+  uint8_t* Panel_DisplayList::_reserve_image(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h)
+  {
+    uint32_t size = sizeof(op_t) + image_size(w, h, _write_bits >> 3);
+    if (_list_used + size > _list_size)
+    {
+      _overflow = true;
+      _reserved = 0;
+      return nullptr;
+    }
+    auto op = (op_t*)&_list[_list_used];
+    op->x = x;
+    op->y = y;
+    op->w = w;
+    op->h = h;
+    op->value = op_image << 24;
+    _reserved = size;
+    return &_list[_list_used + sizeof(op_t)];
+  }
+
+  void Panel_DisplayList::_commit_image(void)
+  {
+    _list_used += _reserved;
+    _reserved = 0;
+    _last_fill = UINT32_MAX;
+  }
+
+  void Panel_DisplayList::drawPixelPreclipped(uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor)
+  {
+    _add_fill(x, y, 1, 1, rawcolor);
+  }
+
+  void Panel_DisplayList::writeFillRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor)
+  {
+    _add_fill(x, y, w, h, rawcolor);
+  }
+
+  void Panel_DisplayList::writeBlock(uint32_t rawcolor, uint32_t length)
+  {
+    do
+    {
+      uint32_t h = 1;
+      auto w = std::min<uint32_t>(length, _xe + 1 - _xpos);
+      if (length >= (w << 1) && _xpos == _xs)
+      {
+        h = std::min<uint32_t>(length / w, _ye + 1 - _ypos);
+      }
+      _add_fill(_xpos, _ypos, w, h, rawcolor);
+      if ((_xpos += w) <= _xe) return;
+      _xpos = _xs;
+      if (_ye < (_ypos += h)) { _ypos = _ys; }
+      length -= w * h;
+    } while (length);
+  }
+
+  void Panel_DisplayList::writePixels(pixelcopy_t* param, uint32_t length, bool)
+  {
+    uint_fast16_t x = _xpos;
+    uint_fast16_t y = _ypos;
+    uint_fast16_t linelength;
+    do {
+      linelength = std::min<uint_fast16_t>(_xe - x + 1, length);
+      auto data = _reserve_image(x, y, linelength, 1);
+      if (data == nullptr) return;
+      param->fp_copy(data, 0, linelength, param);
+      _commit_image();
+      if ((x += linelength) > _xe)
+      {
+        x = _xs;
+        y = (y != _ye) ? (y + 1) : _ys;
+      }
+    } while (length -= linelength);
+    _xpos = x;
+    _ypos = y;
+  }
+
+  void Panel_DisplayList::writeImage(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool)
+  {
+    auto data = _reserve_image(x, y, w, h);
+    if (data == nullptr) return;
+    uint32_t stride = w * (_write_bits >> 3);
+    if (param->transp != pixelcopy_t::NON_TRANSP)
+    { // skipped pixels keep what was drawn below.
+      rasterize(x, y, w, h, data, stride);
+    }
+
+    uint32_t sx32 = param->src_x32;
+    uint32_t sy32 = param->src_y32;
+    uint32_t nexty = 1 << pixelcopy_t::FP_SCALE;
+    for (uint_fast16_t i = 0; i < h; ++i)
+    {
+      auto line = &data[i * stride];
+      int32_t pos = 0;
+      int32_t end = w;
+      while (end != (pos = param->fp_copy(line, pos, end, param))
+         &&  end != (pos = param->fp_skip(      pos, end, param)));
+      param->src_x32 = sx32;
+      param->src_y32 = (sy32 += nexty);
+    }
+    _commit_image();
+  }
+
+  void Panel_DisplayList::writeImageARGB(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param)
+  {
+    auto data = _reserve_image(x, y, w, h);
+    if (data == nullptr) return;
+    uint32_t stride = w * (_write_bits >> 3);
+    rasterize(x, y, w, h, data, stride);
+
+    uint32_t sx32 = param->src_x32;
+    uint32_t sy32 = param->src_y32;
+    uint32_t nexty = 1 << pixelcopy_t::FP_SCALE;
+    for (uint_fast16_t i = 0; i < h; ++i)
+    {
+      param->fp_copy(&data[i * stride], 0, w, param);
+      param->src_x32 = sx32;
+      param->src_y32 = (sy32 += nexty);
+    }
+    _commit_image();
+  }
+
+  void Panel_DisplayList::readRect(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, void* dst, pixelcopy_t* param)
+  {
+    uint32_t stride = w * (_write_bits >> 3);
+    if (param->no_convert)
+    {
+      rasterize(x, y, w, h, (uint8_t*)dst, stride);
+      return;
+    }
+
+    auto line = (uint8_t*)heap_alloc(stride);
+    if (line == nullptr) return;
+    param->src_bitwidth = w;
+    param->src_data = line;
+    size_t dstindex = 0;
+    for (uint_fast16_t i = 0; i < h; ++i)
+    {
+      rasterize(x, y + i, w, 1, line, stride);
+      param->src_x32 = 0;
+      param->src_y32 = 0;
+      dstindex = param->fp_copy(dst, dstindex, dstindex + w, param);
+    }
+    heap_free(line);
+  }
+
+  void Panel_DisplayList::copyRect(uint_fast16_t dst_x, uint_fast16_t dst_y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t src_x, uint_fast16_t src_y)
+  {
+    auto data = _reserve_image(dst_x, dst_y, w, h);
+    if (data == nullptr) return;
+    rasterize(src_x, src_y, w, h, data, w * (_write_bits >> 3));
+    _commit_image();
+  }
+
+  void Panel_DisplayList::rasterize(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t* dst, uint32_t stride, const uint32_t* ops, uint32_t op_count) const
+  {
+    uint_fast8_t bytes = _write_bits >> 3;
+    // pixels not covered by any op are black (raw 0), not whatever dst held before.
+    for (int32_t i = 0; i < h; ++i)
+    {
+      memset(&dst[i * stride], 0, w * bytes);
+    }
+    if (ops)
+    {
+      for (uint32_t i = 0; i < op_count; ++i)
+      {
+        _rasterize_op((const op_t*)&_list[ops[i]], x, y, w, h, dst, stride);
+      }
+      return;
+    }
+    for (uint32_t offset = 0; offset < _list_used; )
+    {
+      auto op = (const op_t*)&_list[offset];
+      offset += op_size(op);
+      _rasterize_op(op, x, y, w, h, dst, stride);
+    }
+  }
+
+  void Panel_DisplayList::_rasterize_op(const op_t* op, int32_t x, int32_t y, int32_t w, int32_t h, uint8_t* dst, uint32_t stride) const
+  {
+    uint_fast8_t bytes = _write_bits >> 3;
+    int32_t l = std::max<int32_t>(x, op->x);
+    int32_t t = std::max<int32_t>(y, op->y);
+    int32_t ir = std::min<int32_t>(x + w, op->x + op->w);
+    int32_t ib = std::min<int32_t>(y + h, op->y + op->h);
+    if (l >= ir || t >= ib) return;
+
+    auto d = &dst[(t - y) * stride + (l - x) * bytes];
+    uint32_t len = ir - l;
+    if ((op->value >> 24) == op_fill)
+    {
+      do
+      {
+        fill_raw(d, len, op->value, bytes);
+        d += stride;
+      } while (++t < ib);
+    }
+    else
+    {
+      uint32_t sw = op->w * bytes;
+      auto s = &((const uint8_t*)&op[1])[(t - op->y) * sw + (l - op->x) * bytes];
+      do
+      {
+        memcpy(d, s, len * bytes);
+        d += stride;
+        s += sw;
+      } while (++t < ib);
+    }
+  }
+
+//----------------------------------------------------------------------------
+
+  bool LGFX_TileCanvas::createCanvas(int32_t w, int32_t h, uint32_t list_bytes, uint_fast16_t tile_w, uint_fast16_t tile_h)
+  {
+    deleteCanvas();
+    if (w <= 0 || h <= 0 || tile_w == 0 || tile_h == 0) return false;
+
+    tile_w = std::min<uint_fast16_t>(tile_w, w);
+    tile_h = std::min<uint_fast16_t>(tile_h, h);
+    _tile_w = tile_w;
+    _tile_h = tile_h;
+    _tile_cols = (w + tile_w - 1) / tile_w;
+    _tile_rows = (h + tile_h - 1) / tile_h;
+
+    uint32_t strip_len = w * tile_h * (_write_conv.bits >> 3);
+    list_bytes = (list_bytes + 3) & ~3u;
+    auto& p = _panel_list;
+    p._list = (uint8_t*)heap_alloc(list_bytes);
+    _tile_hash = (uint32_t*)heap_alloc(getTileCount() * 2 * sizeof(uint32_t));
+    _row_start = (uint32_t*)heap_alloc((_tile_rows + 1) * sizeof(uint32_t));
+    if (!p._list || !_tile_hash || !_row_start || !_strips.reserve(strip_len))
+    {
+      deleteCanvas();
+      return false;
+    }
+    p._list_size = list_bytes;
+    p._width = w;
+    p._height = h;
+    p.setRotation(0);
+    clearClipRect();
+    clearScrollRect();
+    clearList();
+    _invalid = true;
+    return true;
+  }
+
+  void LGFX_TileCanvas::deleteCanvas(void)
+  {
+    auto& p = _panel_list;
+    if (p._list) { heap_free(p._list); p._list = nullptr; }
+    _strips.release();
+    if (_tile_hash) { heap_free(_tile_hash); _tile_hash = nullptr; }
+    if (_row_start) { heap_free(_row_start); _row_start = nullptr; }
+    if (_row_ops) { heap_free(_row_ops); _row_ops = nullptr; }
+    _row_ops_size = 0;
+    p._list_size = 0;
+    p._list_used = 0;
+    p._width = 0;
+    p._height = 0;
+    _tile_cols = 0;
+    _tile_rows = 0;
+    _clip_l = 0;
+    _clip_t = 0;
+    _clip_r = -1;
+    _clip_b = -1;
+  }
+
+  void LGFX_TileCanvas::clearList(void)
+  {
+    auto& p = _panel_list;
+    p._list_used = 0;
+    p._last_fill = UINT32_MAX;
+    p._overflow = false;
+  }
+
+  /// Each op's hash is mixed into every tile it touches, in drawing order.
+  /// The ops touching each tile row are counted for _bin_rows on the way.
+  void LGFX_TileCanvas::_hash_tiles(uint32_t* hashes)
+  {
+    auto& p = _panel_list;
+    uint32_t count = getTileCount();
+    for (uint32_t i = 0; i < count; ++i) { hashes[i] = 2166136261u; }
+    memset(_row_start, 0, (_tile_rows + 1) * sizeof(uint32_t));
+
+    for (uint32_t offset = 0; offset < p._list_used; )
+    {
+      auto op = (const Panel_DisplayList::op_t*)&p._list[offset];
+      uint32_t size = p.op_size(op);
+      offset += size;
+
+      uint32_t h = op->value;
+      h = (h ^ (op->x | op->y << 16)) * 16777619u;
+      h = (h ^ (op->w | op->h << 16)) * 16777619u;
+      auto data = (const uint32_t*)&op[1];
+      for (uint32_t i = (size - sizeof(Panel_DisplayList::op_t)) >> 2; i; --i)
+      {
+        h = (h ^ *data++) * 16777619u;
+      }
+
+      uint32_t tx0 = op->x / _tile_w;
+      uint32_t tx1 = (op->x + op->w - 1) / _tile_w;
+      uint32_t ty1 = (op->y + op->h - 1) / _tile_h;
+      for (uint32_t ty = op->y / _tile_h; ty <= ty1; ++ty)
+      {
+        ++_row_start[ty + 1];
+        auto row = &hashes[ty * _tile_cols];
+        for (uint32_t tx = tx0; tx <= tx1; ++tx)
+        {
+          row[tx] = (row[tx] ^ h) * 16777619u;
+        }
+      }
+    }
+    for (uint32_t ty = 0; ty < _tile_rows; ++ty) { _row_start[ty + 1] += _row_start[ty]; }
+  }
+
+  /// Fill _row_ops from the counts of _hash_tiles. returns false if there is no memory for it,
+  /// rasterize then walks the whole list.
+  bool LGFX_TileCanvas::_bin_rows(void)
+  {
+    auto& p = _panel_list;
+    uint32_t total = _row_start[_tile_rows];
+    if (_row_ops_size < total)
+    {
+      if (_row_ops) { heap_free(_row_ops); }
+      _row_ops = (uint32_t*)heap_alloc(total * sizeof(uint32_t));
+      _row_ops_size = _row_ops ? total : 0;
+      if (!_row_ops) { return false; }
+    }
+
+    // _row_start[ty] serves as the write position of row ty and ends at the start of row ty + 1.
+    for (uint32_t offset = 0; offset < p._list_used; )
+    {
+      auto op = (const Panel_DisplayList::op_t*)&p._list[offset];
+      uint32_t ty1 = (op->y + op->h - 1) / _tile_h;
+      for (uint32_t ty = op->y / _tile_h; ty <= ty1; ++ty)
+      {
+        _row_ops[_row_start[ty]++] = offset;
+      }
+      offset += p.op_size(op);
+    }
+    for (uint32_t ty = _tile_rows; ty; --ty) { _row_start[ty] = _row_start[ty - 1]; }
+    _row_start[0] = 0;
+    return true;
+  }
+
+  bool LGFX_TileCanvas::pushCanvas(LovyanGFX* dst, int32_t x, int32_t y)
+  {
+    _last_dirty = 0;
+    auto& p = _panel_list;
+    if (dst == nullptr || p._list == nullptr || p._overflow) return false;
+
+    uint32_t count = getTileCount();
+    auto prev = _tile_hash;
+    auto work = &_tile_hash[count];
+    _hash_tiles(work);
+    bool binned = _bin_rows();
+
+    auto depth = getColorDepth();
+    uint32_t bytes = _write_conv.bits >> 3;
+    int32_t width = p._width;
+    int32_t height = p._height;
+
+    dst->startWrite();
+    for (uint32_t ty = 0; ty < _tile_rows; ++ty)
+    {
+      int32_t ys = ty * _tile_h;
+      int32_t h = std::min<int32_t>(_tile_h, height - ys);
+      auto row = ty * _tile_cols;
+      auto ops = binned ? &_row_ops[_row_start[ty]] : nullptr;
+      uint32_t op_count = binned ? _row_start[ty + 1] - _row_start[ty] : 0;
+      for (uint32_t tx = 0; tx < _tile_cols; ++tx)
+      {
+        if (!_invalid && work[row + tx] == prev[row + tx]) continue;
+
+        // merge the following dirty tiles of this row into one span.
+        uint32_t te = tx + 1;
+        while (te < _tile_cols && (_invalid || work[row + te] != prev[row + te])) { ++te; }
+        _last_dirty += te - tx;
+
+        int32_t xs = tx * _tile_w;
+        int32_t w = std::min<int32_t>((te - tx) * _tile_w, width - xs);
+        _strips.push(dst, x + xs, y + ys, w, h, depth, pixelcopy_t::NON_TRANSP,
+          [&](uint8_t* strip, int32_t row, int32_t rows) { p.rasterize(xs, ys + row, w, rows, strip, w * bytes, ops, op_count); });
+        tx = te;
+      }
+    }
+    dst->waitDMA();
+    dst->endWrite();
+
+    memcpy(prev, work, count * sizeof(uint32_t));
+    _invalid = false;
+    return true;
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
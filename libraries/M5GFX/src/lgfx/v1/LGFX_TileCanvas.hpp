@@ -0,0 +1,184 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include "LGFXBase.hpp"
+#include "Panel.hpp"
+#include "misc/StripBuffer.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  class LGFX_TileCanvas;
+
+  /// Panel that records pixel operations into a display list instead of a frame buffer.
+  /// Only 8, 16 and 24 bit color depths without palette, rotation 0.
+  struct Panel_DisplayList : public IPanel
+  {
+    friend LGFX_TileCanvas;
+
+    Panel_DisplayList(void) { _start_count = INT32_MAX; }
+
+    void beginTransaction(void) override {}
+    void endTransaction(void) override {}
+    void setInvert(bool) override {}
+    void setSleep(bool) override {}
+    void setPowerSave(bool) override {}
+    void writeCommand(uint32_t, uint_fast8_t) override {}
+    void writeData(uint32_t, uint_fast8_t) override {}
+    void initDMA(void) override {}
+    void waitDMA(void) override {}
+    bool dmaBusy(void) override { return false; }
+    void waitDisplay(void) override {}
+    bool displayBusy(void) override { return false; }
+    void display(uint_fast16_t, uint_fast16_t, uint_fast16_t, uint_fast16_t) override {}
+    bool isReadable(void) const override { return true; }
+    bool isBusShared(void) const override { return false; }
+
+    uint32_t readCommand(uint_fast16_t, uint_fast8_t, uint_fast8_t) override { return 0; }
+    uint32_t readData(uint_fast8_t, uint_fast8_t) override { return 0; }
+
+    color_depth_t setColorDepth(color_depth_t depth) override;
+    void setRotation(uint_fast8_t r) override;
+
+    void setWindow(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye) override;
+    void drawPixelPreclipped(uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor) override;
+    void writeFillRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t raw_color) override;
+    void writeBlock(uint32_t rawcolor, uint32_t len) override;
+    void writePixels(pixelcopy_t* param, uint32_t len, bool use_dma) override;
+    void writeImage(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool) override;
+    void writeImageARGB(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param) override;
+
+    void readRect(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, void* dst, pixelcopy_t* param) override;
+    void copyRect(uint_fast16_t dst_x, uint_fast16_t dst_y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t src_x, uint_fast16_t src_y) override;
+
+    /// Composite every recorded operation that intersects the rectangle into dst (stride in bytes).
+    /// Pixels not covered by any operation are cleared to black.
+    /// ops : list offsets of the operations to visit, in drawing order (nullptr : the whole list).
+    void rasterize(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t* dst, uint32_t stride, const uint32_t* ops = nullptr, uint32_t op_count = 0) const;
+
+  protected:
+    enum op_type_t : uint8_t
+    {
+      op_fill  = 1,
+      op_image = 2,   // w*h raw pixels follow the record, padded to 4 bytes
+    };
+
+    struct op_t
+    {
+      uint16_t x, y, w, h;
+      uint32_t value; // bit 31-24 : op_type_t / bit 23-0 : raw color (fill)
+    };
+
+    static constexpr uint32_t image_size(uint32_t w, uint32_t h, uint32_t bytes) { return (w * h * bytes + 3) & ~3u; }
+    uint32_t op_size(const op_t* op) const { return sizeof(op_t) + ((op->value >> 24) == op_image ? image_size(op->w, op->h, _write_bits >> 3) : 0); }
+
+    void _add_fill(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor);
+    /// Returns the pixel storage of a new image op without committing it (nullptr on overflow).
+    uint8_t* _reserve_image(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h);
+    void _commit_image(void);
+    void _rasterize_op(const op_t* op, int32_t x, int32_t y, int32_t w, int32_t h, uint8_t* dst, uint32_t stride) const;
+
+    uint8_t* _list = nullptr;
+    uint32_t _list_size = 0;
+    uint32_t _list_used = 0;
+    uint32_t _last_fill = UINT32_MAX;   // offset of the last op if it is a fill, for coalescing
+    uint32_t _reserved = 0;
+    bool _overflow = false;
+
+    uint_fast16_t _xpos;
+    uint_fast16_t _ypos;
+  };
+
+  /// Deferred canvas for full screen redraws on devices without RAM for a full frame buffer.
+  /// Drawing calls are recorded into a display list; pushCanvas() bins the list into tiles,
+  /// compares a per-tile hash with the previous frame and rasterizes only the changed tiles
+  /// into a strip buffer, alternating two strips so one is filled while the other is sent by DMA.
+  /// A changed tile only visits the operations binned to its tile row, not the whole list.
+  ///
+  ///   LGFX_TileCanvas canvas(&display);
+  ///   canvas.createCanvas(display.width(), display.height());
+  ///   loop: canvas.clearList(); canvas.fillScreen(TFT_BLACK); ... canvas.pushCanvas(0, 0);
+  class LGFX_TileCanvas : public LovyanGFX
+  {
+  public:
+    LGFX_TileCanvas(LovyanGFX* parent)
+    : LovyanGFX()
+    , _parent(parent)
+    {
+      _panel = &_panel_list;
+      setColorDepth(_write_conv.depth);
+    }
+
+    LGFX_TileCanvas()
+    : LGFX_TileCanvas(nullptr)
+    {}
+
+    virtual ~LGFX_TileCanvas() { deleteCanvas(); }
+
+    LovyanGFX* getParent(void) const { return _parent; }
+
+    /// list_bytes : display list capacity. tile_w / tile_h : tile size in pixels.
+    bool createCanvas(int32_t w, int32_t h, uint32_t list_bytes = 8192, uint_fast16_t tile_w = 32, uint_fast16_t tile_h = 16);
+    void deleteCanvas(void);
+
+    /// Discard the recorded operations and start recording the next frame.
+    void clearList(void);
+
+    /// Send the tiles that differ from the previous push. returns false if the list overflowed.
+    bool pushCanvas(int32_t x, int32_t y) { return pushCanvas(_parent, x, y); }
+    bool pushCanvas(LovyanGFX* dst, int32_t x, int32_t y);
+
+    /// Forget the previous frame; the next push sends every tile.
+    void invalidate(void) { _invalid = true; }
+
+    uint32_t getListUsed(void) const { return _panel_list._list_used; }
+    uint32_t getListSize(void) const { return _panel_list._list_size; }
+    bool isListOverflow(void) const { return _panel_list._overflow; }
+    uint32_t getTileCount(void) const { return _tile_cols * _tile_rows; }
+    /// Number of tiles sent by the last push.
+    uint32_t getLastDirtyTiles(void) const { return _last_dirty; }
+
+  protected:
+    void _hash_tiles(uint32_t* hashes);
+    bool _bin_rows(void);
+
+    LovyanGFX* _parent;
+    Panel_DisplayList _panel_list;
+
+    StripBuffer _strips { 0 };        // full width x tile_h, sized by createCanvas
+    uint32_t* _tile_hash = nullptr;   // [0, count) : previous push / [count, 2*count) : work
+    uint32_t* _row_start = nullptr;   // _tile_rows + 1 entries : first _row_ops index of each tile row
+    uint32_t* _row_ops = nullptr;     // list offsets of the ops touching each tile row, in drawing order
+    uint32_t _row_ops_size = 0;       // entries allocated in _row_ops
+    uint16_t _tile_w = 0;
+    uint16_t _tile_h = 0;
+    uint16_t _tile_cols = 0;
+    uint16_t _tile_rows = 0;
+    uint32_t _last_dirty = 0;
+    bool _invalid = true;
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
+
+using LGFX_TileCanvas = lgfx::LGFX_TileCanvas;
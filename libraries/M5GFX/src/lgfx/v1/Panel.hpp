@@ -118,6 +118,8 @@ namespace lgfx
     virtual void initDMA(void) = 0;
     virtual void waitDMA(void) = 0;
     virtual bool dmaBusy(void) = 0;
+    virtual uint32_t getDMAFence(void) { return 0; }
+    virtual void waitDMAFence(uint32_t) {}
     virtual void waitDisplay(void) = 0;
     virtual bool displayBusy(void) = 0;
     virtual void display(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h) = 0;
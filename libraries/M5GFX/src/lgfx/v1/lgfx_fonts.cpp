@@ -719,6 +719,224 @@ label_nextbyte: /// 次のデータを取得する;
     return xAdvance;
   }
 
+//----------------------------------------------------------------------------
+
+  struct vlw_glyph_t
+  {
+    vlw_glyph_t* prev;    // LRU list, most recently used first
+    vlw_glyph_t* next;
+    vlw_glyph_t* chain;   // hash bucket
+    const VLWfont* font;
+    uint32_t size;
+    uint16_t code;
+    uint16_t width;
+    uint16_t height;
+    uint16_t x_advance;
+    int16_t  y_delta;
+    int8_t   x_offset;
+    uint8_t  bitmap[1];   // width * height alpha values
+  };
+
+  class vlw_glyph_cache_t
+  {
+  public:
+    bool enabled(void) const { return _stats.capacity != 0; }
+
+    void resize(uint32_t bytes, bool use_psram)
+    {
+      _stats.capacity = bytes;
+      _use_psram = use_psram;
+      _trim(bytes);
+    }
+
+    const glyph_cache_stats_t& stats(void) const { return _stats; }
+
+    void resetStats(void)
+    {
+      _stats.hits = 0;
+      _stats.misses = 0;
+      _stats.evictions = 0;
+    }
+
+    vlw_glyph_t* find(const VLWfont* font, uint16_t code)
+    {
+      auto glyph = _buckets[_hash(font, code)];
+      while (glyph && (glyph->font != font || glyph->code != code)) { glyph = glyph->chain; }
+      if (glyph == nullptr)
+      {
+        ++_stats.misses;
+        return nullptr;
+      }
+      ++_stats.hits;
+      if (glyph != _head)
+      {
+        _unlink(glyph);
+        _link_front(glyph);
+      }
+      return glyph;
+    }
+
+    vlw_glyph_t* insert(const VLWfont* font, uint16_t code, uint32_t pixels)
+    {
+      uint32_t size = (offsetof(vlw_glyph_t, bitmap) + pixels + 3) & ~3u;
+      if (size > _stats.capacity) return nullptr;
+      _trim(_stats.capacity - size);
+
+      vlw_glyph_t* glyph = nullptr;
+      if (_use_psram) { glyph = (vlw_glyph_t*)heap_alloc_psram(size); }
+      if (glyph == nullptr) { glyph = (vlw_glyph_t*)heap_alloc(size); }
+      if (glyph == nullptr) return nullptr;
+
+      glyph->font = font;
+      glyph->code = code;
+      glyph->size = size;
+      auto& bucket = _buckets[_hash(font, code)];
+      glyph->chain = bucket;
+      bucket = glyph;
+      _link_front(glyph);
+      ++_stats.glyphs;
+      _stats.bytes += size;
+      return glyph;
+    }
+
+    /// drop every glyph of a font that is being unloaded
+    void purge(const VLWfont* font)
+    {
+      auto glyph = _head;
+      while (glyph)
+      {
+        auto next = glyph->next;
+        if (glyph->font == font) { _erase(glyph); }
+        glyph = next;
+      }
+    }
+
+  private:
+    static constexpr size_t bucket_count = 64;
+
+    static size_t _hash(const VLWfont* font, uint16_t code)
+    {
+      return (((uintptr_t)font >> 4) ^ (code * 0x9E37u)) & (bucket_count - 1);
+    }
+
+    void _link_front(vlw_glyph_t* glyph)
+    {
+      glyph->prev = nullptr;
+      glyph->next = _head;
+      if (_head) { _head->prev = glyph; }
+      else { _tail = glyph; }
+      _head = glyph;
+    }
+
+    void _unlink(vlw_glyph_t* glyph)
+    {
+      if (glyph->prev) { glyph->prev->next = glyph->next; }
+      else { _head = glyph->next; }
+      if (glyph->next) { glyph->next->prev = glyph->prev; }
+      else { _tail = glyph->prev; }
+    }
+
+    void _erase(vlw_glyph_t* glyph)
+    {
+      _unlink(glyph);
+      auto link = &_buckets[_hash(glyph->font, glyph->code)];
+      while (*link != glyph) { link = &(*link)->chain; }
+      *link = glyph->chain;
+      --_stats.glyphs;
+      _stats.bytes -= glyph->size;
+      heap_free(glyph);
+    }
+
+    void _trim(uint32_t bytes)
+    {
+      while (_tail && _stats.bytes > bytes)
+      {
+        _erase(_tail);
+        ++_stats.evictions;
+      }
+    }
+
+    vlw_glyph_t* _buckets[bucket_count] = { nullptr };
+    vlw_glyph_t* _head = nullptr;
+    vlw_glyph_t* _tail = nullptr;
+    glyph_cache_stats_t _stats = { 0, 0, 0, 0, 0, 0 };
+    bool _use_psram = true;
+  };
+
+  static vlw_glyph_cache_t vlw_glyph_cache;
+
+  /// Cached glyph for the index found by getUnicodeIndex, decoded from the font data on a miss.
+  /// nullptr if the cache is disabled or the glyph doesn't fit.
+  static const vlw_glyph_t* vlw_get_glyph(const VLWfont* font, uint16_t gNum, uint16_t code)
+  {
+    if (!vlw_glyph_cache.enabled()) return nullptr;
+    auto glyph = vlw_glyph_cache.find(font, code);
+    if (glyph) return glyph;
+
+    auto file = font->_fontData;
+    file->preRead();
+    file->seek(28 + gNum * 28);
+    uint32_t buffer[6];
+    file->read((uint8_t*)buffer, 24);
+    uint32_t h = getSwap32(buffer[0]);
+    uint32_t w = getSwap32(buffer[1]);
+    glyph = vlw_glyph_cache.insert(font, code, w * h);
+    if (glyph)
+    {
+      glyph->height    = h;
+      glyph->width     = w;
+      glyph->x_advance = getSwap32(buffer[2]);
+      glyph->y_delta   = (int16_t)getSwap32(buffer[3]);
+      glyph->x_offset  = (int8_t)getSwap32(buffer[4]);
+      file->seek(font->gBitmap[gNum]);
+      file->read(glyph->bitmap, w * h);
+    }
+    file->postRead();
+    return glyph;
+  }
+
+  void VLWfont::setGlyphCacheSize(uint32_t bytes, bool use_psram)
+  {
+    vlw_glyph_cache.resize(bytes, use_psram);
+  }
+
+  glyph_cache_stats_t VLWfont::getGlyphCacheStats(void)
+  {
+    return vlw_glyph_cache.stats();
+  }
+
+  void VLWfont::resetGlyphCacheStats(void)
+  {
+    vlw_glyph_cache.resetStats();
+  }
+
+  size_t VLWfont::warmGlyphCache(const char* string) const
+  {
+    size_t count = 0;
+    if (!_fontLoaded || string == nullptr) return 0;
+    auto str = (const uint8_t*)string;
+    while (*str)
+    {
+      uint16_t code = *str++;
+      if ((code & 0xE0) == 0xC0 && (str[0] & 0xC0) == 0x80)
+      {
+        code = ((code & 0x1F) << 6) | (str[0] & 0x3F);
+        str += 1;
+      }
+      else if ((code & 0xF0) == 0xE0 && (str[0] & 0xC0) == 0x80 && (str[1] & 0xC0) == 0x80)
+      {
+        code = ((code & 0x0F) << 12) | ((str[0] & 0x3F) << 6) | (str[1] & 0x3F);
+        str += 2;
+      }
+      uint16_t gNum = 0;
+      if (code != 0x20 && getUnicodeIndex(code, &gNum) && vlw_get_glyph(this, gNum, code))
+      {
+        ++count;
+      }
+    }
+    return count;
+  }
+
 //----------------------------------------------------------------------------
 
   void VLWfont::getDefaultMetric(FontMetrics *metrics) const
@@ -737,6 +955,7 @@ label_nextbyte: /// 次のデータを取得する;
   bool VLWfont::unloadFont(void)
   {
     _fontLoaded = false;
+    vlw_glyph_cache.purge(this);
     if (gUnicode)  { heap_free(gUnicode);  gUnicode  = nullptr; }
     if (gWidth)    { heap_free(gWidth);    gWidth    = nullptr; }
     if (gxAdvance) { heap_free(gxAdvance); gxAdvance = nullptr; }
@@ -766,6 +985,10 @@ label_nextbyte: /// 次のデータを取得する;
         metrics->width     = gWidth[gNum];
         metrics->x_advance = gxAdvance[gNum];
         metrics->x_offset  = gdX[gNum];
+      } else if (auto glyph = vlw_get_glyph(this, gNum, uniCode)) {
+        metrics->width     = glyph->width;
+        metrics->x_advance = glyph->x_advance;
+        metrics->x_offset  = glyph->x_offset;
       } else {
         auto file = _fontData;
 
@@ -882,6 +1105,7 @@ label_nextbyte: /// 次のデータを取得する;
 
     uint32_t buffer[6] = {0};
     uint16_t gNum = 0;
+    const vlw_glyph_t* glyph = nullptr;
 
     int32_t sy = 65536 * style->size_y;
     y += (metrics->y_offset * sy) >> 16;
@@ -891,6 +1115,12 @@ label_nextbyte: /// 次のデータを取得する;
       buffer[2] = getSwap32(this->spaceWidth);
     } else if (!this->getUnicodeIndex(code, &gNum)) {
       return drawCharDummy(gfx, x, y, this->spaceWidth, metrics->height, style, filled_x);
+    } else if (nullptr != (glyph = vlw_get_glyph(this, gNum, code))) {
+      buffer[0] = getSwap32(glyph->height);
+      buffer[1] = getSwap32(glyph->width);
+      buffer[2] = getSwap32(glyph->x_advance);
+      buffer[3] = getSwap32(glyph->y_delta);
+      buffer[4] = getSwap32(glyph->x_offset);
     } else {
       file->preRead();
       file->seek(28 + gNum * 28);
@@ -908,10 +1138,16 @@ label_nextbyte: /// 次のデータを取得する;
     int32_t yoffset  = (this->maxAscent - dY);
 //      int32_t yoffset = (gfx->_font_metrics.y_offset) - dY;
 
-    auto pixel = (uint8_t*)alloca(w * h);
-    if (gNum != 0xFFFF) {
-      file->read(pixel, w * h);
-      file->postRead();
+    const uint8_t* pixel;
+    if (glyph) {
+      pixel = glyph->bitmap;
+    } else {
+      auto buf = (uint8_t*)alloca(w * h);
+      if (gNum != 0xFFFF) {
+        file->read(buf, w * h);
+        file->postRead();
+      }
+      pixel = buf;
     }
 
     gfx->startWrite();
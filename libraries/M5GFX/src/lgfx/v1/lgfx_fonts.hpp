@@ -224,6 +224,17 @@ namespace lgfx
 
 //----------------------------------------------------------------------------
 // VLW font
+
+  struct glyph_cache_stats_t
+  {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t glyphs;    // glyphs held now
+    uint32_t bytes;     // memory held now
+    uint32_t capacity;  // byte budget, 0 = cache disabled
+  };
+
   struct VLWfont : public RunTimeFont
   {
     uint16_t gCount;     // Total number of characters
@@ -256,6 +267,17 @@ namespace lgfx
     bool updateFontMetric(FontMetrics *metrics, uint16_t uniCode) const override;
 
     bool getUnicodeIndex(uint16_t unicode, uint16_t *index) const;
+
+    /// Decoded glyph cache shared by all VLW fonts, keyed by (font, code).
+    /// Holds the metrics and alpha bitmap of recently drawn glyphs so redraws don't read the font data.
+    /// Least recently used glyphs are dropped beyond 'bytes'. 0 disables the cache (default).
+    static void setGlyphCacheSize(uint32_t bytes, bool use_psram = true);
+    static glyph_cache_stats_t getGlyphCacheStats(void);
+    static void resetGlyphCacheStats(void);
+
+    /// Decode the glyphs used by a UTF-8 string into the glyph cache ahead of time.
+    /// returns the number of those glyphs now held in the cache.
+    size_t warmGlyphCache(const char* string) const;
   };
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,54 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+
+#include "StripBuffer.hpp"
+
+#include "../platforms/common.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  bool StripBuffer::reserve(uint32_t bytes)
+  {
+    if (bytes < _preferred) { bytes = _preferred; }
+    if (_strip[0] && _strip[1] && _size >= bytes) { return true; }
+    for (auto& strip : _strip)
+    {
+      if (strip) { heap_free(strip); }
+      strip = (uint8_t*)heap_alloc_dma(bytes);
+    }
+    _size = (_strip[0] && _strip[1]) ? bytes : 0;
+    if (!_size) { release(); }
+    return _size;
+  }
+
+  void StripBuffer::release(void)
+  {
+    for (auto& strip : _strip)
+    {
+      if (strip) { heap_free(strip); strip = nullptr; }
+    }
+    _size = 0;
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
@@ -0,0 +1,91 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "pixelcopy.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  /// Two DMA capable strips used in turn: one is filled while the other is still sent by DMA.
+  /// Each strip remembers the DMA fence of its last push and is only refilled once it has passed.
+  class StripBuffer
+  {
+  public:
+    StripBuffer(uint32_t preferred_bytes = 4096) : _preferred(preferred_bytes) {}
+    StripBuffer(const StripBuffer&) = delete;
+    StripBuffer& operator=(const StripBuffer&) = delete;
+    ~StripBuffer(void) { release(); }
+
+    /// Size of one strip to allocate when less is requested by reserve.
+    void setPreferredBytes(uint32_t bytes) { _preferred = bytes; }
+
+    /// Make both strips at least max(bytes, preferred bytes) long, keeping larger ones.
+    bool reserve(uint32_t bytes);
+    void release(void);
+
+    uint32_t size(void) const { return _size; }
+    uint8_t* get(size_t index) const { return _strip[index & 1]; }
+
+    /// Send w x h pixels of depth to dst at x, y, strip by strip. fill(strip, row, rows) writes
+    /// the pixels of rows [row, row + rows) into the strip. reserve() must have succeeded with
+    /// at least one row.
+    template <typename TDst, typename TFill>
+    void push(TDst* dst, int32_t x, int32_t y, int32_t w, int32_t h, color_depth_t depth, uint32_t transp, TFill&& fill)
+    {
+      uint32_t row_bytes = w * ((depth & color_depth_t::bit_mask) >> 3);
+      int32_t strip_h = _size / row_bytes;
+      if (strip_h < 1) { strip_h = 1; }
+      if (_dst != dst)
+      { // fences of another destination do not apply.
+        _dst = dst;
+        _fence[0] = _fence[1] = dst->getDMAFence();
+      }
+      for (int32_t row = 0; row < h; row += strip_h)
+      {
+        int32_t sh = (strip_h < h - row) ? strip_h : h - row;
+        auto flip = _flip;
+        _flip ^= 1;
+        auto strip = _strip[flip];
+        dst->waitDMAFence(_fence[flip]);
+        fill(strip, row, sh);
+        // the transfer is queued; the next strip is filled while this one is sent.
+        pixelcopy_t pc(strip, dst->getColorDepth(), depth, dst->hasPalette(), nullptr, transp);
+        dst->pushImage(x, y + row, w, sh, &pc, true);
+        _fence[flip] = dst->getDMAFence();
+      }
+    }
+
+  private:
+    uint8_t* _strip[2] = { nullptr, nullptr };
+    uint32_t _preferred;
+    uint32_t _size = 0;
+    uint_fast8_t _flip = 0;
+    uint32_t _fence[2] = { 0, 0 };  // DMA fence of the last push of each strip
+    const void* _dst = nullptr;     // destination the fences belong to
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
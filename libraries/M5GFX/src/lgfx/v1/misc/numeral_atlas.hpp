@@ -0,0 +1,75 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "enum.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  /// One glyph cell of a numeral atlas.
+  /// The cell covers the glyph background the font would fill: [pen + x, pen + x + width) x [top, top + height).
+  struct atlas_glyph_t
+  {
+    uint16_t code;      // unicode
+    int16_t  x;         // cell left relative to the pen position (negative x_offset)
+    uint16_t width;     // cell width in pixels
+    uint16_t advance;   // pen advance
+    uint32_t offset;    // start of the RLE stream in numeral_atlas_t::data
+  };
+
+  /// Pre-rendered subset of a font at a fixed size and color pair, generated by tools/numeral_atlas.
+  ///
+  /// Each glyph cell is stored row-major as a stream of RLE tokens in the panel's native pixel
+  /// format (swap565_t for rgb565_2Byte, grayscale_t for grayscale_8bit):
+  ///   0nnnnnnn pixel          : n + 1 copies of the pixel
+  ///   1nnnnnnn pixel * (n+1)  : n + 1 literal pixels
+  /// Tokens never span two glyphs, they may span rows.
+  struct numeral_atlas_t
+  {
+    const uint8_t* data;
+    const atlas_glyph_t* glyphs;  // sorted by code
+    uint16_t count;
+    uint16_t height;
+    uint16_t baseline;
+    color_depth_t depth;
+    uint32_t fore_rgb888;
+    uint32_t back_rgb888;
+
+    const atlas_glyph_t* find(uint16_t code) const
+    {
+      size_t lo = 0, hi = count;
+      while (lo < hi)
+      {
+        size_t mid = (lo + hi) >> 1;
+        if (glyphs[mid].code < code) lo = mid + 1;
+        else hi = mid;
+      }
+      return (lo < count && glyphs[lo].code == code) ? &glyphs[lo] : nullptr;
+    }
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
@@ -265,6 +265,114 @@ namespace lgfx
       return index;
     }
 
+//----------------------------------------------------------------------------
+
+#if defined ( __GNUC__ ) && !defined ( __clang__ ) && defined ( __x86_64__ ) && defined ( __linux__ )
+ #define LGFX_PIXELCOPY_KERNEL __attribute__((target_clones("avx2","default"), optimize("-O3")))
+#elif defined ( __GNUC__ ) && !defined ( __clang__ )
+ #define LGFX_PIXELCOPY_KERNEL __attribute__((optimize("-O3")))
+#else
+ #define LGFX_PIXELCOPY_KERNEL
+#endif
+
+    // 4 pixels of 3 bytes are read as 3 little endian words ( w0 = p0 p0 p0 p1 / w1 = p1 p1 p2 p2 / w2 = p2 p3 p3 p3 ).
+    // c0, g, c2 : the pixel's bytes in memory order; swap_rb for rgb888 sources (b, g, r).
+    static inline uint16_t pack_swap565(uint32_t c0, uint32_t g, uint32_t c2, bool swap_rb)
+    {
+      return swap_rb ? swap565(c2, g, c0) : swap565(c0, g, c2);
+    }
+
+    static inline void p24_to_swap565_row(uint16_t* __restrict d, const uint8_t* __restrict s, uint32_t len, bool swap_rb)
+    {
+      uint32_t n = len >> 2;
+      for (uint32_t k = 0; k < n; ++k)
+      {
+        uint32_t w0, w1, w2;
+        memcpy(&w0, &s[k * 12    ], 4);
+        memcpy(&w1, &s[k * 12 + 4], 4);
+        memcpy(&w2, &s[k * 12 + 8], 4);
+        d[k * 4    ] = pack_swap565(w0      , w0 >>  8, w0 >> 16, swap_rb);
+        d[k * 4 + 1] = pack_swap565(w0 >> 24, w1      , w1 >>  8, swap_rb);
+        d[k * 4 + 2] = pack_swap565(w1 >> 16, w1 >> 24, w2      , swap_rb);
+        d[k * 4 + 3] = pack_swap565(w2 >>  8, w2 >> 16, w2 >> 24, swap_rb);
+      }
+      for (uint32_t k = n << 2; k < len; ++k)
+      {
+        d[k] = pack_swap565(s[k * 3], s[k * 3 + 1], s[k * 3 + 2], swap_rb);
+      }
+    }
+
+    static LGFX_PIXELCOPY_KERNEL void bgr888_to_swap565_row(uint16_t* __restrict d, const uint8_t* __restrict s, uint32_t len)
+    {
+      p24_to_swap565_row(d, s, len, false);
+    }
+
+    static LGFX_PIXELCOPY_KERNEL void rgb888_to_swap565_row(uint16_t* __restrict d, const uint8_t* __restrict s, uint32_t len)
+    {
+      p24_to_swap565_row(d, s, len, true);
+    }
+
+    static inline uint32_t swap565_to_bgr888(uint32_t c)
+    {
+      uint32_t r = (c >> 3) & 0x1F;
+      uint32_t g = ((c << 3) & 0x38) + (c >> 13);
+      uint32_t b = (c >> 8) & 0x1F;
+      return (((b << 3) + (b >> 2)) << 16) + (((g << 2) + (g >> 4)) << 8) + (r << 3) + (r >> 2);
+    }
+
+    // same arithmetic as blend_rgb_fast; a == 0 and a == 255 fall out of the formula, so no branches.
+    // a_shift .. b_shift : bit position of each channel in the little endian source word.
+    static inline void blend32_swap565_row(uint16_t* __restrict d, const uint32_t* __restrict s, uint32_t len
+                                          , uint32_t a_shift, uint32_t r_shift, uint32_t g_shift, uint32_t b_shift)
+    {
+      for (uint32_t k = 0; k < len; ++k)
+      {
+        uint32_t c = s[k];
+        uint32_t a = (c >> a_shift) & 0xFF;
+        uint32_t inv = 256 - a;
+        ++a;
+        uint32_t dc = swap565_to_bgr888(d[k]);
+        uint32_t r = (( dc        & 0xFF) * inv + ((c >> r_shift) & 0xFF) * a) >> 8;
+        uint32_t g = (((dc >>  8) & 0xFF) * inv + ((c >> g_shift) & 0xFF) * a) >> 8;
+        uint32_t b = (( dc >> 16        ) * inv + ((c >> b_shift) & 0xFF) * a) >> 8;
+        d[k] = swap565(r, g, b);
+      }
+    }
+
+    static LGFX_PIXELCOPY_KERNEL void blend_argb8888_swap565_row(uint16_t* __restrict d, const uint32_t* __restrict s, uint32_t len)
+    {
+      blend32_swap565_row(d, s, len, 24, 16, 8, 0);
+    }
+
+    static LGFX_PIXELCOPY_KERNEL void blend_bgra8888_swap565_row(uint16_t* __restrict d, const uint32_t* __restrict s, uint32_t len)
+    {
+      blend32_swap565_row(d, s, len, 0, 8, 16, 24);
+    }
+
+#undef LGFX_PIXELCOPY_KERNEL
+
+    void pixelcopy_t::convert_row(swap565_t* __restrict dst, const bgr888_t* __restrict src, uint32_t len)
+    {
+      bgr888_to_swap565_row(reinterpret_cast<uint16_t*>(dst), reinterpret_cast<const uint8_t*>(src), len);
+    }
+
+    void pixelcopy_t::convert_row(swap565_t* __restrict dst, const rgb888_t* __restrict src, uint32_t len)
+    {
+      rgb888_to_swap565_row(reinterpret_cast<uint16_t*>(dst), reinterpret_cast<const uint8_t*>(src), len);
+    }
+
+    bool pixelcopy_t::blend_row(swap565_t* __restrict dst, const argb8888_t* __restrict src, uint32_t len)
+    {
+      blend_argb8888_swap565_row(reinterpret_cast<uint16_t*>(dst), reinterpret_cast<const uint32_t*>(src), len);
+      return true;
+    }
+
+    bool pixelcopy_t::blend_row(swap565_t* __restrict dst, const bgra8888_t* __restrict src, uint32_t len)
+    {
+      blend_bgra8888_swap565_row(reinterpret_cast<uint16_t*>(dst), reinterpret_cast<const uint32_t*>(src), len);
+      return true;
+    }
+
 //----------------------------------------------------------------------------
   }
 }
@@ -102,6 +102,28 @@ namespace lgfx
     static uint32_t compare_bit_affine(void* __restrict dst, uint32_t index, uint32_t last, pixelcopy_t* __restrict param);
     static uint32_t skip_bit_affine(uint32_t index, uint32_t last, pixelcopy_t* param);
 
+    /// Converts len pixels with unit stride. The generic version is a counted loop the compiler can vectorize,
+    /// the overloads are kernels for the 24 bit sources it handles poorly (on x86-64 Linux an AVX2 clone is picked at load time).
+    template <typename TDst, typename TSrc>
+    static void convert_row(TDst* __restrict dst, const TSrc* __restrict src, uint32_t len)
+    {
+      if (std::is_same<TDst, TSrc>::value)
+      {
+        memcpy(reinterpret_cast<void*>(dst), reinterpret_cast<const void*>(src), len * sizeof(TSrc));
+        return;
+      }
+      for (uint32_t k = 0; k < len; ++k) { dst[k].set(color_convert<TDst, TSrc>(src[k].get())); }
+    }
+    static void convert_row(swap565_t* __restrict dst, const bgr888_t* __restrict src, uint32_t len);
+    static void convert_row(swap565_t* __restrict dst, const rgb888_t* __restrict src, uint32_t len);
+
+    /// returns false if the pair has no blend kernel.
+
+    template <typename TDst, typename TSrc>
+    static bool blend_row(TDst*, const TSrc*, uint32_t) { return false; }
+    static bool blend_row(swap565_t* __restrict dst, const argb8888_t* __restrict src, uint32_t len);
+    static bool blend_row(swap565_t* __restrict dst, const bgra8888_t* __restrict src, uint32_t len);
+
     template<typename TSrc>
     static auto get_fp_copy_rgb_affine(color_depth_t dst_depth) -> uint32_t(*)(void*, uint32_t, uint32_t, pixelcopy_t*)
     {
@@ -149,6 +171,17 @@ namespace lgfx
       auto pal = static_cast<const TPalette*>(param->palette);
       uint32_t i = param->positions[0] * param->src_bits;
       param->positions[0] += last - index;
+      if (param->src_bits <= 4 && last - index >= 32)
+      { // convert the palette once for long rows of 1, 2 or 4 bit pixels
+        TDst lut[16];
+        for (uint32_t k = 0, n = 1u << param->src_bits; k < n; ++k) { lut[k].set(color_convert<TDst, TPalette>(pal[k].get())); }
+        do {
+          uint32_t raw = s[i >> 3];
+          i += param->src_bits;
+          d[index] = lut[(raw >> (-i & 7)) & param->src_mask];
+        } while (++index != last);
+        return index;
+      }
       do {
         uint32_t raw = s[i >> 3];
         i += param->src_bits;
@@ -164,16 +197,7 @@ namespace lgfx
       auto s = &static_cast<const TSrc*>(param->src_data)[(uintptr_t)param->positions[0] - (uintptr_t)index];
       auto d = static_cast<TDst*>(dst);
       param->positions[0] += last - index;
-      if (std::is_same<TDst, TSrc>::value)
-      {
-        memcpy(reinterpret_cast<void*>(&d[index]), reinterpret_cast<const void*>(&s[index]), (last - index) * sizeof(TSrc));
-      }
-      else
-      {
-        do {
-          d[index].set(color_convert<TDst, TSrc>(s[index].get()));
-        } while (++index != last);
-      }
+      convert_row(&d[index], &s[index], last - index);
       return last;
     }
 #if 0
@@ -250,6 +274,13 @@ namespace lgfx
       auto src_y32_add = param->src_y32_add;
       auto src_x32 = param->src_x32;
       auto src_y32 = param->src_y32;
+      // a 32 bit source pixel can equal NON_TRANSP, leave those to the loop below.
+      if (sizeof(TSrc) < 4 && param->transp == NON_TRANSP && src_x32_add == 1 << FP_SCALE && src_y32_add == 0)
+      {
+        convert_row(&d[index], &s[(src_x32 >> FP_SCALE) + (src_y32 >> FP_SCALE) * src_bitwidth], last - index);
+        param->src_x32 = src_x32 + ((last - index) << FP_SCALE);
+        return last;
+      }
       do {
         uint32_t i = (src_x32 >> FP_SCALE) + (src_y32 >> FP_SCALE) * src_bitwidth;
         uint32_t raw = s[i].get();
@@ -504,6 +535,12 @@ namespace lgfx
       auto src_x32_add = param->src_x32_add;
       auto src_y32_add = param->src_y32_add;
       auto s = static_cast<const TSrc*>(param->src_data);
+      if (src_x32_add == 1 << FP_SCALE && src_y32_add == 0
+       && blend_row(&d[index], &s[param->src_x + param->src_y * param->src_bitwidth], last - index))
+      {
+        param->src_x32 += (last - index) << FP_SCALE;
+        return last;
+      }
       for (;;) {
         uint32_t i = param->src_x + param->src_y * param->src_bitwidth;
         uint_fast16_t a = s[i].a;
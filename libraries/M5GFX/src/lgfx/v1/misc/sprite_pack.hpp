@@ -0,0 +1,194 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "enum.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  /// Sprite pack: images decoded ahead of time by tools/sprite_pack into the panel's native
+  /// pixel format, drawn by LGFX_SpritePack without any image decoder.
+  ///
+  /// Layout (little endian, every offset from the start of the pack, 4 byte aligned):
+  ///   sprite_pack_header_t
+  ///   sprite_pack_entry_t * count     (index, looked up by id = position)
+  ///   pixel data of every entry
+  ///
+  /// Pixels are swap565_t for rgb565_2Byte, bgr888_t for rgb888_3Byte, rgb332_t or grayscale_t
+  /// for the 8 bit depths, stored row-major in one of these encodings:
+  ///   raw   : width * height pixels
+  ///   rle   : 0nnnnnnn pixel            n + 1 copies of the pixel
+  ///           1nnnnnnn pixel * (n+1)    n + 1 literal pixels
+  ///   qoi   : 00nnnnnn                  n + 1 copies of the previous pixel
+  ///           01iiiiii                  the pixel in slot i of the 64 entry index
+  ///           10nnnnnn pixel * (n+1)    n + 1 literal pixels
+  ///           11nnnnnn pixel            n + 1 copies of the pixel
+  ///   Every pixel read from the stream by the qoi encoding is stored in the index slot
+  ///   sprite_pack_hash(pixel) and becomes the previous pixel (initially 0).
+  ///   Tokens run across rows.
+
+  static constexpr uint32_t sprite_pack_magic = 0x4B50534C; // "LSPK"
+  static constexpr uint16_t sprite_pack_version = 1;
+
+  enum sprite_pack_encoding_t : uint8_t
+  {
+    sprite_pack_raw,
+    sprite_pack_rle,
+    sprite_pack_qoi,
+  };
+
+  struct sprite_pack_header_t
+  {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;       // number of entries
+    uint16_t depth;       // color_depth_t of every entry
+    uint16_t reserved;
+    uint32_t size;        // bytes of the whole pack
+  };
+
+  struct sprite_pack_entry_t
+  {
+    static constexpr uint8_t flag_transparent = 0x01;
+
+    uint16_t width;
+    uint16_t height;
+    uint8_t  encoding;    // sprite_pack_encoding_t
+    uint8_t  flags;
+    uint16_t reserved;
+    uint32_t transparent; // native pixel value skipped when flag_transparent is set
+    uint32_t offset;
+    uint32_t size;        // bytes of the encoded pixels
+  };
+
+  static inline uint32_t sprite_pack_hash(uint32_t pixel) { return (pixel * 2654435761u) >> 26; }
+
+  /// Decodes the rle and qoi encodings of one entry in pieces of any length.
+  struct sprite_pack_decoder_t
+  {
+    void begin(const uint8_t* src, uint8_t encoding, uint_fast8_t bytes)
+    {
+      _src = src;
+      _encoding = encoding;
+      _bytes = bytes;
+      _count = 0;
+      _literal = false;
+      _prev = 0;
+      memset(_index, 0, sizeof(_index));
+    }
+
+    void decode(uint8_t* dst, uint32_t pixels)
+    {
+      auto bytes = _bytes;
+      while (pixels)
+      {
+        if (!_count) { _next_token(); }
+        uint32_t n = _count < pixels ? _count : pixels;
+        _count -= n;
+        pixels -= n;
+        if (_literal)
+        {
+          memcpy(dst, _src, n * bytes);
+          dst += n * bytes;
+          if (_encoding == sprite_pack_qoi)
+          {
+            do { _prev = _read_pixel(); _index[sprite_pack_hash(_prev)] = _prev; } while (--n);
+          }
+          else
+          {
+            _src += n * bytes;
+          }
+          continue;
+        }
+        auto prev = _prev;
+        switch (bytes)
+        {
+        case 1:
+          memset(dst, prev, n);
+          dst += n;
+          break;
+        case 2:
+          do { dst[0] = prev; dst[1] = prev >> 8; dst += 2; } while (--n);
+          break;
+        default:
+          do { dst[0] = prev; dst[1] = prev >> 8; dst[2] = prev >> 16; dst += 3; } while (--n);
+          break;
+        }
+      }
+    }
+
+  private:
+    uint32_t _read_pixel(void)
+    {
+      uint32_t p = _src[0];
+      if (_bytes > 1) { p |= _src[1] << 8; }
+      if (_bytes > 2) { p |= _src[2] << 16; }
+      _src += _bytes;
+      return p;
+    }
+
+    void _next_token(void)
+    {
+      uint_fast8_t t = *_src++;
+      if (_encoding == sprite_pack_rle)
+      {
+        _count = (t & 0x7F) + 1;
+        _literal = t & 0x80;
+        if (!_literal) { _prev = _read_pixel(); }
+        return;
+      }
+      _count = (t & 0x3F) + 1;
+      _literal = false;
+      switch (t >> 6)
+      {
+      case 1:
+        _prev = _index[t & 0x3F];
+        _count = 1;
+        break;
+      case 2:
+        _literal = true;
+        break;
+      case 3:
+        _prev = _read_pixel();
+        _index[sprite_pack_hash(_prev)] = _prev;
+        break;
+      default:
+        break;
+      }
+    }
+
+    const uint8_t* _src = nullptr;
+    uint32_t _count = 0;
+    uint32_t _prev = 0;
+    uint32_t _index[64];
+    uint8_t _encoding = sprite_pack_raw;
+    uint8_t _bytes = 2;
+    bool _literal = false;
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
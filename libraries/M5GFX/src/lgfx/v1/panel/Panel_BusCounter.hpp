@@ -0,0 +1,129 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include "../Panel.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  /// Counts the traffic a MIPI-DCS panel on a byte wide bus would see for the drawing calls
+  /// made on TBase, so a host panel (Panel_memory, Panel_sdl) can report what an SPI panel
+  /// would be sent.
+  template <typename TBase>
+  struct Panel_BusCounter : public TBase
+  {
+    struct bus_stats_t
+    {
+      uint64_t pixels = 0;        // pixels written
+      uint64_t windows = 0;       // address window changes (CASET + RASET + RAMWR)
+      uint64_t bytes = 0;         // command and pixel bytes
+      uint32_t transactions = 0;  // beginTransaction calls
+    };
+
+    /// CASET, RASET with 16 bit coordinates and RAMWR.
+    static constexpr uint32_t window_bytes = 11;
+
+    void beginTransaction(void) override
+    {
+      ++_stats.transactions;
+      TBase::beginTransaction();
+    }
+
+    void setWindow(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye) override
+    {
+      if (_enter()) { _count(0, 1); }
+      TBase::setWindow(xs, ys, xe, ye);
+      _leave();
+    }
+
+    void drawPixelPreclipped(uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor) override
+    {
+      if (_enter()) { _count(1, 1); }
+      TBase::drawPixelPreclipped(x, y, rawcolor);
+      _leave();
+    }
+
+    void writeFillRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor) override
+    {
+      if (_enter()) { _count(w * h, 1); }
+      TBase::writeFillRectPreclipped(x, y, w, h, rawcolor);
+      _leave();
+    }
+
+    void writeBlock(uint32_t rawcolor, uint32_t length) override
+    {
+      if (_enter()) { _count(length, 0); }
+      TBase::writeBlock(rawcolor, length);
+      _leave();
+    }
+
+    void writeImage(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool use_dma) override
+    {
+      if (_enter()) { _count(w * h, 1); }
+      TBase::writeImage(x, y, w, h, param, use_dma);
+      _leave();
+    }
+
+    void writeImageARGB(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param) override
+    {
+      if (_enter()) { _count(w * h, 1); }
+      TBase::writeImageARGB(x, y, w, h, param);
+      _leave();
+    }
+
+    void writePixels(pixelcopy_t* param, uint32_t len, bool use_dma) override
+    {
+      if (_enter()) { _count(len, 0); }
+      TBase::writePixels(param, len, use_dma);
+      _leave();
+    }
+
+    void copyRect(uint_fast16_t dst_x, uint_fast16_t dst_y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t src_x, uint_fast16_t src_y) override
+    {
+      // an SPI panel has no copy command, the rectangle is read back and written again.
+      if (_enter()) { _count(w * h * 2, 2); }
+      TBase::copyRect(dst_x, dst_y, w, h, src_x, src_y);
+      _leave();
+    }
+
+    const bus_stats_t& getBusStats(void) const { return _stats; }
+    void resetBusStats(void) { _stats = bus_stats_t(); }
+
+  protected:
+    /// The base class builds some writes out of others (writeBlock -> writeFillRectPreclipped),
+    /// only the outermost call is counted.
+    bool _enter(void) { return 0 == _nesting++; }
+    void _leave(void) { --_nesting; }
+    void _count(uint64_t pixels, uint32_t windows)
+    {
+      _stats.pixels += pixels;
+      _stats.windows += windows;
+      _stats.bytes += pixels * (this->_write_bits >> 3) + windows * window_bytes;
+    }
+
+    bus_stats_t _stats;
+    uint32_t _nesting = 0;
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
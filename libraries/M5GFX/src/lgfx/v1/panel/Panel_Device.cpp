@@ -97,6 +97,14 @@ namespace lgfx
   {
     return _bus->busy();
   }
+  uint32_t Panel_Device::getDMAFence(void)
+  {
+    return _bus->getDMAFence();
+  }
+  void Panel_Device::waitDMAFence(uint32_t fence)
+  {
+    _bus->waitDMAFence(fence);
+  }
 
   void Panel_Device::display(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h)
   {
@@ -146,6 +146,8 @@ namespace lgfx
     void initDMA(void) override;
     void waitDMA(void) override;
     bool dmaBusy(void) override;
+    uint32_t getDMAFence(void) override;
+    void waitDMAFence(uint32_t fence) override;
     void display(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h) override;
 
     void writeCommand(uint32_t data, uint_fast8_t length) override;
@@ -231,6 +233,8 @@ namespace lgfx
     void initDMA(void) override {}
     void waitDMA(void) override {}
     bool dmaBusy(void) override { return false; }
+    uint32_t getDMAFence(void) override { return 0; }
+    void waitDMAFence(uint32_t) override {}
     void waitDisplay(void) override {}
     bool displayBusy(void) override { return false; }
     void display(uint_fast16_t, uint_fast16_t, uint_fast16_t, uint_fast16_t) override {}
@@ -38,6 +38,8 @@ namespace lgfx
     void initDMA(void) override {}
     void waitDMA(void) override {}
     bool dmaBusy(void) override { return false; }
+    uint32_t getDMAFence(void) override { return 0; }
+    void waitDMAFence(uint32_t) override {}
     void waitDisplay(void) override {}
     bool displayBusy(void) override { return false; }
     color_depth_t setColorDepth(color_depth_t depth) override { _write_depth = depth; _read_depth = depth; return depth; }
@@ -0,0 +1,71 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#include "Panel_memory.hpp"
+
+#include <stdlib.h>
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  Panel_memory::~Panel_memory(void)
+  {
+    if (_lines_buffer)
+    {
+      free(_lines_buffer[0]);
+      free(_lines_buffer);
+      _lines_buffer = nullptr;
+    }
+  }
+
+  bool Panel_memory::init(bool use_reset)
+  {
+    if (_lines_buffer == nullptr)
+    {
+      // room for 32 bit pixels, so the color depth can change after init.
+      size_t line = (_cfg.panel_width * 4 + 7) & ~7u;
+      size_t height = _cfg.panel_height;
+      _lines_buffer = (uint8_t**)malloc(height * sizeof(uint8_t*));
+      uint8_t* fb = (uint8_t*)calloc(line * height + 16, 1);
+      if (!_lines_buffer || !fb)
+      {
+        free(fb);
+        free(_lines_buffer);
+        _lines_buffer = nullptr;
+        return false;
+      }
+      for (size_t y = 0; y < height; ++y) { _lines_buffer[y] = fb + y * line; }
+    }
+    return Panel_FrameBufferBase::init(use_reset);
+  }
+
+  color_depth_t Panel_memory::setColorDepth(color_depth_t depth)
+  {
+    auto bits = depth & color_depth_t::bit_mask;
+    if (bits >= 16) { depth = bits > 16 ? rgb888_3Byte : rgb565_2Byte; }
+    else            { depth = depth == grayscale_8bit ? grayscale_8bit : rgb332_1Byte; }
+    _write_depth = depth;
+    _read_depth = depth;
+    return depth;
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
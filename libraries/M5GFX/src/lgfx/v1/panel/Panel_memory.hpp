@@ -0,0 +1,48 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include "Panel_FrameBufferBase.hpp"
+#include "Panel_BusCounter.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  /// Frame buffer panel held in RAM, without a display or a window.
+  /// For host tests and benchmarks: the contents are deterministic and can be read back,
+  /// and the traffic an SPI panel would need for the same drawing calls is counted.
+  struct Panel_memory : public Panel_BusCounter<Panel_FrameBufferBase>
+  {
+    Panel_memory(void) = default;
+    virtual ~Panel_memory(void);
+
+    bool init(bool use_reset) override;
+    color_depth_t setColorDepth(color_depth_t depth) override;
+
+    /// Start of a line in memory (unrotated panel coordinates), panel_width pixels at the write depth.
+    const uint8_t* getLine(uint_fast16_t y) const { return _lines_buffer ? _lines_buffer[y] : nullptr; }
+    /// Bytes of one line, without the padding.
+    uint32_t getLineBytes(void) const { return _cfg.panel_width * (_write_bits >> 3); }
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
@@ -97,8 +97,22 @@ Contributors:
 
 #include "common.hpp"
 
+#include <esp_intr_alloc.h>
+#include <freertos/FreeRTOS.h>
+
 #include <algorithm>
 
+#if defined ( SPI_TRANS_DONE_INT_ENA )  // S2/S3/C3/C6/P4
+ #define LGFX_SPI_TRANS_DONE_INT_ENA_REG(i) SPI_DMA_INT_ENA_REG(i)
+ #define LGFX_SPI_TRANS_DONE_INT_ENA        SPI_TRANS_DONE_INT_ENA
+ #define LGFX_SPI_TRANS_DONE_INT_CLR_REG(i) SPI_DMA_INT_CLR_REG(i)
+ #define LGFX_SPI_TRANS_DONE_INT_CLR        SPI_TRANS_DONE_INT_CLR
+#elif defined ( SPI_TRANS_INTEN )       // ESP32 ; the done flag lives in SPI_SLAVE_REG next to the enable bit.
+ #define LGFX_SPI_TRANS_DONE_INT_ENA_REG(i) SPI_SLAVE_REG(i)
+ #define LGFX_SPI_TRANS_DONE_INT_ENA        SPI_TRANS_INTEN
+ #define LGFX_SPI_TRANS_DONE_SLAVE_FLAG     SPI_TRANS_DONE
+#endif
+
 namespace lgfx
 {
  inline namespace v1
@@ -110,6 +124,24 @@ namespace lgfx
   static __attribute__ ((always_inline)) inline void writereg(uint32_t addr, uint32_t value) { *(volatile uint32_t*)addr = value; }
 #pragma GCC diagnostic pop
 
+  struct Bus_SPI::dma_job_t
+  {
+    lldesc_t* desc;
+    uint32_t desc_count;
+    uint32_t length;
+    uint32_t remain;    // bytes left after the first exec (GDMA splits at SPI_MS_DATA_BITLEN)
+    dma_callback_t callback;
+    void* arg;
+    bool dc;
+  };
+
+  struct Bus_SPI::dma_job_queue_t
+  {
+    dma_job_t jobs[dma_job_max];
+    intr_handle_t intr;
+    portMUX_TYPE mux;
+  };
+
   void Bus_SPI::config(const config_t& cfg)
   {
     _cfg = cfg;
@@ -216,6 +248,17 @@ namespace lgfx
 //ESP_LOGI("LGFX","Bus_SPI::release");
     if (!_inited) return;
     _inited = false;
+    if (_dma_job_queue)
+    {
+      wait_dma_job();
+      if (_dma_job_queue->intr) { esp_intr_free(_dma_job_queue->intr); }
+      for (auto& job : _dma_job_queue->jobs)
+      {
+        if (job.desc) { heap_caps_free(job.desc); }
+      }
+      heap_caps_free(_dma_job_queue);
+      _dma_job_queue = nullptr;
+    }
     spi::release(_cfg.spi_host);
     gpio_reset(_cfg.pin_dc  );
 
@@ -301,13 +344,15 @@ namespace lgfx
 
   void Bus_SPI::wait(void)
   {
+    wait_dma_job();
     auto spi_cmd_reg = _spi_cmd_reg;
     while (*spi_cmd_reg & SPI_USR);
   }
 
   bool Bus_SPI::busy(void) const
   {
-    return (*_spi_cmd_reg & SPI_USR);
+    _kick_dma_job();
+    return (_dma_job_tail != _dma_job_head) || (*_spi_cmd_reg & SPI_USR);
   }
 
   bool Bus_SPI::writeCommand(uint32_t data, uint_fast8_t bit_length)
@@ -671,6 +716,11 @@ namespace lgfx
       }
       if (use_dma)
       {
+        // go through the DMA job queue so that the transfer is fenced and completed by the
+        // interrupt. only one write is kept in flight: callers reuse their buffer after the next write.
+        wait_dma_job();
+        if (_queue_dma_job(data, length, dc, nullptr, nullptr)) { return; }
+
         auto spi_dma_out_link_reg = _spi_dma_out_link_reg;
         auto cmd = _spi_cmd_reg;
         while (*cmd & SPI_USR) {}
@@ -938,6 +988,225 @@ label_start:
 #endif
   }
 
+  void IRAM_ATTR Bus_SPI::_start_dma_job(dma_job_t* job)
+  {
+    uint32_t length = job->length;
+    *_spi_dma_out_link_reg = 0;
+#if defined ( SOC_GDMA_SUPPORTED )
+    auto dma = reg(SPI_DMA_CONF_REG(_spi_port));
+    *dma = 0; /// Clear previous transfer
+    uint32_t len = ((length - 1) & ((SPI_MS_DATA_BITLEN)>>3)) + 1;
+    *_spi_dma_out_link_reg = DMA_OUTLINK_START_CH0 | ((int)(&job->desc[0]) & 0xFFFFF);
+    *dma = SPI_DMA_TX_ENA;
+    _clear_dma_reg = dma;
+#else
+    auto dma_conf_reg = reg(SPI_DMA_CONF_REG(_spi_port));
+    auto dma_conf = *dma_conf_reg & ~(SPI_OUT_DATA_BURST_EN | SPI_AHBM_RST | SPI_AHBM_FIFO_RST | SPI_OUT_RST);
+    *dma_conf_reg = dma_conf | SPI_AHBM_RST | SPI_AHBM_FIFO_RST | SPI_OUT_RST;
+    // 送信長が4の倍数の場合のみバーストモードを使用する (writeBytes参照)
+    dma_conf |= (length & 3) ? (SPI_OUTDSCR_BURST_EN) : (SPI_OUTDSCR_BURST_EN | SPI_OUT_DATA_BURST_EN);
+    *dma_conf_reg = dma_conf;
+    uint32_t len = length;
+    *_spi_dma_out_link_reg = SPI_OUTLINK_START | ((int)(&job->desc[0]) & 0xFFFFF);
+    _clear_dma_reg = _spi_dma_out_link_reg;
+#endif
+    job->remain = length - len;
+    set_write_len(len << 3);
+    *_gpio_reg_dc[job->dc] = _mask_reg_dc;
+#if !defined ( SOC_GDMA_SUPPORTED ) && !defined (SPI_DMA_OUTFIFO_EMPTY) && defined ( LGFX_SPIDMA_WORKAROUND )
+    if (_dma_ch) { spicommon_dmaworkaround_transfer_active(_dma_ch); }
+#endif
+    // the SPI transaction is started by _exec_dma_job once the DMA has filled the FIFO.
+    _dma_job_armed = true;
+  }
+
+  bool IRAM_ATTR Bus_SPI::_exec_dma_job(void) const
+  {
+    // DMA準備完了待ち ; return instead of spinning, the caller retries later.
+#if defined ( SOC_GDMA_SUPPORTED )
+    if (*_spi_dma_outstatus_reg & DMA_OUTFIFO_EMPTY_CH0 ) { return false; }
+#elif defined (SPI_DMA_OUTFIFO_EMPTY)
+    if (*_spi_dma_outstatus_reg & SPI_DMA_OUTFIFO_EMPTY ) { return false; }
+#endif
+    _dma_job_armed = false;
+    exec_spi();
+    return true;
+  }
+
+  void Bus_SPI::_kick_dma_job(void) const
+  {
+    auto queue = _dma_job_queue;
+    if (!_dma_job_armed || queue == nullptr) { return; }
+    portENTER_CRITICAL(&queue->mux);
+    if (_dma_job_armed) { _exec_dma_job(); }
+    portEXIT_CRITICAL(&queue->mux);
+  }
+
+  void IRAM_ATTR Bus_SPI::_dma_job_isr(void* arg)
+  {
+#if defined ( LGFX_SPI_TRANS_DONE_INT_ENA )
+    auto me = (Bus_SPI*)arg;
+    auto queue = me->_dma_job_queue;
+ #if defined ( LGFX_SPI_TRANS_DONE_INT_CLR )
+    *reg(LGFX_SPI_TRANS_DONE_INT_CLR_REG(me->_spi_port)) = LGFX_SPI_TRANS_DONE_INT_CLR;
+ #else
+    *reg(LGFX_SPI_TRANS_DONE_INT_ENA_REG(me->_spi_port)) &= ~LGFX_SPI_TRANS_DONE_SLAVE_FLAG;
+ #endif
+
+    dma_callback_t callback = nullptr;
+    void* callback_arg = nullptr;
+
+    portENTER_CRITICAL_ISR(&queue->mux);
+    uint32_t tail = me->_dma_job_tail;
+    if (tail != me->_dma_job_head)
+    {
+      auto job = &queue->jobs[(tail + 1) % dma_job_max];
+ #if defined ( SOC_GDMA_SUPPORTED )
+      if (job->remain)
+      { // continue the same DMA link with the next SPI transaction.
+        job->remain -= (SPI_MS_DATA_BITLEN + 1) >> 3;
+        me->set_write_len(SPI_MS_DATA_BITLEN + 1);
+        me->exec_spi();
+        job = nullptr;
+      }
+ #endif
+      if (job)
+      {
+        callback = job->callback;
+        callback_arg = job->arg;
+        me->_dma_job_tail = ++tail;
+        if (tail != me->_dma_job_head)
+        { // start the next job before running the callback to keep the bus busy.
+          me->_start_dma_job(&queue->jobs[(tail + 1) % dma_job_max]);
+        }
+        else
+        {
+          *reg(LGFX_SPI_TRANS_DONE_INT_ENA_REG(me->_spi_port)) &= ~LGFX_SPI_TRANS_DONE_INT_ENA;
+        }
+      }
+    }
+    portEXIT_CRITICAL_ISR(&queue->mux);
+
+    if (callback) { callback(callback_arg); }
+
+    // the callback gave the DMA time to fill the FIFO ; if it is still empty,
+    // the next kick from the task side (waitDMAFence, submitDMA, ...) starts the job.
+    if (me->_dma_job_armed)
+    {
+      portENTER_CRITICAL_ISR(&queue->mux);
+      if (me->_dma_job_armed) { me->_exec_dma_job(); }
+      portEXIT_CRITICAL_ISR(&queue->mux);
+    }
+#else
+    (void)arg;
+#endif
+  }
+
+  uint32_t Bus_SPI::submitDMA(const uint8_t* data, uint32_t length, bool dc, dma_callback_t callback, void* arg)
+  {
+    if (length && _queue_dma_job(data, length, dc, callback, arg)) { return _dma_job_head; }
+
+    if (length) { writeBytes(data, length, dc, true); }
+    wait_spi();
+    uint32_t fence = _dma_job_head + 1;
+    _dma_job_head = fence;
+    _dma_job_tail = fence;
+    if (callback) { callback(arg); }
+    return fence;
+  }
+
+  bool Bus_SPI::_queue_dma_job(const uint8_t* data, uint32_t length, bool dc, dma_callback_t callback, void* arg)
+  {
+    auto queue = _dma_job_queue;
+#if defined ( LGFX_SPI_TRANS_DONE_INT_ENA )
+    if (queue == nullptr && _cfg.dma_channel && _inited)
+    {
+      queue = (dma_job_queue_t*)heap_caps_calloc(1, sizeof(dma_job_queue_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+      if (queue)
+      {
+        portMUX_INITIALIZE(&queue->mux);
+        *reg(LGFX_SPI_TRANS_DONE_INT_ENA_REG(_spi_port)) &= ~LGFX_SPI_TRANS_DONE_INT_ENA;
+        if (ESP_OK != esp_intr_alloc(spicommon_irqsource_for_host(_cfg.spi_host), ESP_INTR_FLAG_LEVEL1 | ESP_INTR_FLAG_IRAM, _dma_job_isr, this, &queue->intr))
+        { // the interrupt is owned by another driver ; fall back to blocking writes.
+          queue->intr = nullptr;
+        }
+        _dma_job_queue = queue;
+      }
+    }
+#endif
+
+    uint32_t fence = _dma_job_head + 1;
+    dma_job_t* job = nullptr;
+    if (queue && queue->intr)
+    {
+      // the slot is free once the job submitted dma_job_max fences ago has completed.
+      waitDMAFence(fence - dma_job_max);
+      job = &queue->jobs[fence % dma_job_max];
+      uint32_t count = (length - 1) / SPI_MAX_DMA_LEN + 1;
+      if (job->desc_count < count)
+      {
+        if (job->desc) { heap_caps_free(job->desc); }
+        job->desc = (lldesc_t*)heap_caps_malloc(sizeof(lldesc_t) * count, MALLOC_CAP_DMA);
+        job->desc_count = job->desc ? count : 0;
+        if (job->desc == nullptr) { job = nullptr; }
+      }
+    }
+
+    if (job == nullptr) { return false; }
+
+    job->length = length;
+    job->remain = 0;
+    job->callback = callback;
+    job->arg = arg;
+    job->dc = dc;
+    lldesc_t *dmadesc = job->desc;
+    while (length > SPI_MAX_DMA_LEN)
+    {
+      length -= SPI_MAX_DMA_LEN;
+      dmadesc->buf = (uint8_t *)data;
+      data += SPI_MAX_DMA_LEN;
+      *(uint32_t*)dmadesc = SPI_MAX_DMA_LEN | SPI_MAX_DMA_LEN << 12 | 0x80000000;
+      dmadesc->qe.stqe_next = dmadesc + 1;
+      dmadesc++;
+    }
+    *(uint32_t*)dmadesc = ((length + 3) & ( ~3 )) | length << 12 | 0xC0000000;
+    dmadesc->buf = (uint8_t *)data;
+    dmadesc->qe.stqe_next = nullptr;
+
+#if defined LGFX_USE_QSPI
+    if( _is_quad_spi)
+    {
+      auto qspi_user_reg = _spi_user_reg;
+      *qspi_user_reg = (*qspi_user_reg | SPI_FWRITE_QUAD);
+    }
+#endif
+
+    auto cmd = _spi_cmd_reg;
+    // let a synchronous transfer finish outside of the critical section.
+    if (_dma_job_tail == _dma_job_head) { while (*cmd & SPI_USR) {} }
+
+#if defined ( LGFX_SPI_TRANS_DONE_INT_ENA )
+    portENTER_CRITICAL(&queue->mux);
+    bool idle = (_dma_job_tail == _dma_job_head);
+    _dma_job_head = fence;
+    if (idle)
+    {
+      while (*cmd & SPI_USR) {}
+ #if defined ( LGFX_SPI_TRANS_DONE_INT_CLR )
+      *reg(LGFX_SPI_TRANS_DONE_INT_CLR_REG(_spi_port)) = LGFX_SPI_TRANS_DONE_INT_CLR;
+ #else
+      *reg(LGFX_SPI_TRANS_DONE_INT_ENA_REG(_spi_port)) &= ~LGFX_SPI_TRANS_DONE_SLAVE_FLAG;
+ #endif
+      *reg(LGFX_SPI_TRANS_DONE_INT_ENA_REG(_spi_port)) |= LGFX_SPI_TRANS_DONE_INT_ENA;
+      _start_dma_job(job);
+    }
+    portEXIT_CRITICAL(&queue->mux);
+    // wait for the FIFO here rather than in the critical section.
+    while (_dma_job_armed) { _kick_dma_job(); }
+#endif
+    return true;
+  }
+
   void Bus_SPI::beginRead(uint_fast8_t dummy_bits)
   {
     beginRead();
@@ -135,18 +135,40 @@ namespace lgfx
     bool readBytes(uint8_t* dst, uint32_t length, bool use_dma) override;
     void readPixels(void* dst, pixelcopy_t* pc, uint32_t length) override;
 
+    /// Completion callback of submitDMA.
+    /// Runs in ISR context (registered with ESP_INTR_FLAG_IRAM) : it must be IRAM_ATTR,
+    /// must not block and must not touch flash or PSRAM; use xxxFromISR calls to signal a task.
+    typedef void (*dma_callback_t)(void* arg);
+
+    static constexpr size_t dma_job_max = 8;
+
+    /// Queue a DMA write and return without waiting for the bus.
+    /// Up to dma_job_max writes are kept in flight and started back to back from the SPI interrupt.
+    /// data must be DMA capable and stay untouched until the returned fence has passed.
+    /// Any other bus access waits until the queue is empty.
+    /// callback(arg) runs from the SPI interrupt when the write has completed, see dma_callback_t.
+    /// A queued write whose DMA has not filled the FIFO yet when the previous one completes is
+    /// started by the next call to isDMAFenceDone, waitDMAFence, busy or submitDMA.
+    uint32_t submitDMA(const uint8_t* data, uint32_t length, bool dc = true, dma_callback_t callback = nullptr, void* arg = nullptr);
+    /// Fence of the last submitted write.
+    uint32_t getDMAFence(void) const override { return _dma_job_head; }
+    bool isDMAFenceDone(uint32_t fence) const { _kick_dma_job(); return (int32_t)(_dma_job_tail - fence) >= 0; }
+    void waitDMAFence(uint32_t fence) override { while (!isDMAFenceDone(fence)) {} }
+
   private:
 
     bool _is_quad_spi = false;
 
     static __attribute__ ((always_inline)) inline volatile uint32_t* reg(uint32_t addr) { return (volatile uint32_t *)ETS_UNCACHED_ADDR(addr); }
-    __attribute__ ((always_inline)) inline void exec_spi(void) {        *_spi_cmd_reg = SPI_EXECUTE; }
-    __attribute__ ((always_inline)) inline void wait_spi(void) { while (*_spi_cmd_reg & SPI_USR); }
+    __attribute__ ((always_inline)) inline void exec_spi(void) const {  *_spi_cmd_reg = SPI_EXECUTE; }
+    __attribute__ ((always_inline)) inline void wait_spi(void) { wait_dma_job(); while (*_spi_cmd_reg & SPI_USR); }
+    __attribute__ ((always_inline)) inline void wait_dma_job(void) { while (_dma_job_tail != _dma_job_head) { _kick_dma_job(); } }
     __attribute__ ((always_inline)) inline void set_write_len(uint32_t bitlen) { *_spi_mosi_dlen_reg = bitlen - 1; }
     __attribute__ ((always_inline)) inline void set_read_len( uint32_t bitlen) { *reg(SPI_MISO_DLEN_REG(_spi_port)) = bitlen - 1; }
 
     void dc_control(bool flg)
     {
+      wait_dma_job();
       auto reg = _gpio_reg_dc[flg];
       auto mask = _mask_reg_dc;
       auto spi_cmd_reg = _spi_cmd_reg;
@@ -178,6 +200,15 @@ namespace lgfx
     void _spi_dma_reset(void);
     void _setup_dma_desc_links(const uint8_t *data, int32_t len);
 
+    struct dma_job_t;
+    struct dma_job_queue_t;
+    /// Queue a DMA job ; false if the job queue is unavailable (no DMA channel, interrupt or memory).
+    bool _queue_dma_job(const uint8_t* data, uint32_t length, bool dc, dma_callback_t callback, void* arg);
+    void _start_dma_job(dma_job_t* job);
+    bool _exec_dma_job(void) const;
+    void _kick_dma_job(void) const;
+    static void _dma_job_isr(void* arg);
+
     config_t _cfg;
     FlipBuffer _flip_buffer;
     volatile uint32_t* _gpio_reg_dc[2] = { nullptr, nullptr };
@@ -199,6 +230,10 @@ namespace lgfx
     lldesc_t* _dma_queue = nullptr;
     uint32_t _dma_queue_size = 0;
     uint32_t _dma_queue_capacity = 0;
+    dma_job_queue_t* _dma_job_queue = nullptr;
+    volatile uint32_t _dma_job_head = 0;  // fence of the last submitted job
+    volatile uint32_t _dma_job_tail = 0;  // fence of the last completed job
+    mutable volatile bool _dma_job_armed = false;  // a job is linked but waits for the DMA FIFO
     uint8_t _spi_port = 0;
     uint8_t _dma_ch = 0;
     bool _inited = false;
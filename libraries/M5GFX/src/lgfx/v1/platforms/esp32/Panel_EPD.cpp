@@ -162,6 +162,7 @@ namespace lgfx
   {
     _epd_mode = epd_mode_t::epd_quality;
     _auto_display = true;
+    portMUX_INITIALIZE(&_pending_lock);
   }
 
   Panel_EPD::~Panel_EPD(void)
@@ -283,7 +284,6 @@ namespace lgfx
       }
     }
 
-    _update_queue_handle = xQueueCreate(8, sizeof(update_data_t));
     auto task_priority = _config_detail.task_priority;
     auto task_pinned_core = _config_detail.task_pinned_core;
     if (task_pinned_core >= portNUM_PROCESSORS)
@@ -311,11 +311,8 @@ namespace lgfx
 
   bool Panel_EPD::displayBusy(void)
   {
-// キュー _update_queue_handle に余裕があるか調べる
-    if (_update_queue_handle && uxQueueSpacesAvailable(_update_queue_handle) == 0) {
-      return true;
-    }
-    return false;
+// 保留中の更新領域に空きがあるか調べる
+    return _pending_count >= max_pending;
   };
 
 
@@ -577,10 +574,16 @@ namespace lgfx
     _display_busy = true;
     cacheWriteBack(&_buf[y * _cfg.panel_width >> 1], h * _cfg.panel_width >> 1);
     vTaskDelay(1);
-    bool res = xQueueSend(_update_queue_handle, &upd, 128 / portTICK_PERIOD_MS) == pdTRUE;
+    bool res = _push_update(upd);
+    for (int retry = 128 / portTICK_PERIOD_MS; !res && retry; --retry)
+    {
+      vTaskDelay(1);
+      res = _push_update(upd);
+    }
 // printf("\nres: %d, xs: %d, xe: %d, ys: %d, ye: %d\n", res, xs, xe, ys, ye);
     if (res)
     {
+      if (_task_update_handle) { xTaskNotifyGive(_task_update_handle); }
       _range_mod.top    = INT16_MAX;
       _range_mod.left   = INT16_MAX;
       _range_mod.right  = 0;
@@ -588,6 +591,110 @@ namespace lgfx
     }
   }
 
+  bool Panel_EPD::_push_update(update_data_t upd)
+  {
+    bool res = true;
+    bool covered = false;
+    portENTER_CRITICAL(&_pending_lock);
+    size_t count = _pending_count;
+    for (size_t i = 0; i < count; ++i)
+    {
+      auto& p = _pending[i];
+      int32_t l = std::min<int32_t>(p.x, upd.x);
+      int32_t t = std::min<int32_t>(p.y, upd.y);
+      int32_t r = std::max<int32_t>(p.x + p.w, upd.x + upd.w);
+      int32_t b = std::max<int32_t>(p.y + p.h, upd.y + upd.h);
+      uint32_t union_area = (r - l) * (b - t);
+      uint32_t p_area = p.w * p.h;
+      uint32_t upd_area = upd.w * upd.h;
+
+      if (p.mode == upd.mode && union_area == p_area)
+      { // already covered by a pending request, which reads the frame buffer when it runs.
+        covered = true;
+        break;
+      }
+
+      bool touch = p.x <= upd.x + upd.w && upd.x <= p.x + p.w
+                && p.y <= upd.y + upd.h && upd.y <= p.y + p.h;
+      bool supersede = (union_area == upd_area);
+      if (supersede || (touch && p.mode == upd.mode && union_area <= p_area + upd_area))
+      { // drop the older request, merging it into the new one if it sticks out.
+        upd.x = l;
+        upd.y = t;
+        upd.w = r - l;
+        upd.h = b - t;
+        memmove(&_pending[i], &_pending[i + 1], (count - i - 1) * sizeof(update_data_t));
+        --count;
+        i = -1; // the grown region may touch requests checked before.
+      }
+    }
+    if (!covered)
+    {
+      if (count < max_pending) { _pending[count++] = upd; }
+      else { res = false; }
+      _pending_count = count;
+    }
+    portEXIT_CRITICAL(&_pending_lock);
+    return res;
+  }
+
+  bool Panel_EPD::_pop_update(update_data_t* upd)
+  {
+    portENTER_CRITICAL(&_pending_lock);
+    size_t count = _pending_count;
+    if (count)
+    {
+      *upd = _pending[0];
+      memmove(&_pending[0], &_pending[1], (count - 1) * sizeof(update_data_t));
+      _pending_count = count - 1;
+    }
+    portEXIT_CRITICAL(&_pending_lock);
+    return count;
+  }
+
+  epd_mode_t Panel_EPD::_select_mode(const update_data_t& upd, uint32_t* changed_pixels)
+  {
+    auto mode = upd.mode;
+    bool fast = (mode == epd_mode_t::epd_fast) || (mode == epd_mode_t::epd_fastest);
+    *changed_pixels = 0;
+    if (!_config_detail.adaptive_mode && !(fast && _config_detail.ghost_budget)) { return mode; }
+
+    // count the pixels whose requested value differs from the new one.
+    const size_t panel_w = _cfg.panel_width;
+    const size_t memory_w = _cfg.memory_width;
+    auto src = &_buf[(upd.x + upd.y * panel_w) >> 1];
+    auto dst = &_step_framebuf[((upd.x + upd.y * memory_w) >> 1) * 2];
+    uint32_t changed = 0;
+    bool gray = false;
+    for (size_t h = upd.h; h; --h)
+    {
+      for (size_t i = 0; i < (upd.w >> 1u); ++i)
+      {
+        uint_fast8_t s = src[i];
+        if (s == (uint8_t)dst[i * 2 + 1]) { continue; }
+        changed += 2;
+        uint_fast8_t hi = s >> 4;
+        uint_fast8_t lo = s & 15;
+        gray |= (hi != 0 && hi != 15) || (lo != 0 && lo != 15);
+      }
+      src += panel_w >> 1;
+      dst += (memory_w >> 1) * 2;
+    }
+    *changed_pixels = changed;
+    if (!_config_detail.adaptive_mode || changed == 0) { return mode; }
+
+    // small changes take the faster waveforms ; intermediate gray levels need at least the fast one.
+    uint32_t area = _cfg.panel_width * _cfg.panel_height;
+    epd_mode_t pick = epd_mode_t::epd_quality;
+    if      (changed * 64 < area) { pick = gray ? epd_mode_t::epd_fast : epd_mode_t::epd_fastest; }
+    else if (changed * 16 < area) { pick = epd_mode_t::epd_fast; }
+    else if (changed *  4 < area) { pick = gray ? epd_mode_t::epd_quality : epd_mode_t::epd_text; }
+
+    // never slower than requested, and only modes that have a lut.
+    while (pick > mode && _lut_remain_table[pick] == 0) { pick = (epd_mode_t)(pick - 1); }
+    return std::max(pick, mode);
+  }
+
 #if defined( __XTENSA__ )
   __attribute__((noinline,noclone,optimize("-O3")))
   static bool blit_dmabuf(uint32_t* dst, uint16_t* src, const uint8_t* lut, size_t len)
@@ -902,12 +1009,33 @@ __asm__ __volatile(
     bool remain = false;
 
     for (;;) {
-      me->_display_busy = remain;
-      TickType_t wait_tick = remain ? 0 : portMAX_DELAY;
-      if (xQueueReceive(me->_update_queue_handle, &new_data, wait_tick)) {
-        me->_display_busy = true;
+      me->_display_busy = remain || me->_pending_count;
+      ulTaskNotifyTake(pdTRUE, (remain || me->_pending_count) ? 0 : portMAX_DELAY);
+      bool applied = false;
+      {
         uint32_t usec = lgfx::micros();
         for (;;) {
+          if (me->_pop_update(&new_data)) {
+            uint32_t changed;
+            auto mode = me->_select_mode(new_data, &changed);
+            if (me->_config_detail.adaptive_mode && changed == 0) { continue; }
+            if (mode == epd_mode_t::epd_fast || mode == epd_mode_t::epd_fastest) {
+              me->_ghost_pixels += changed;
+            }
+            new_data.mode = mode;
+          } else {
+            auto budget = me->_config_detail.ghost_budget;
+            if (budget == 0 || me->_ghost_pixels < budget) { break; }
+            // 保留中の更新が無いときに、高速モードで描画された画素を画質優先モードで描き直す
+            me->_ghost_pixels = 0;
+            new_data.x = me->_cfg.offset_x & ~1u;
+            new_data.y = me->_cfg.offset_y;
+            new_data.w = me->_cfg.panel_width & ~1u;
+            new_data.h = me->_cfg.panel_height;
+            new_data.mode = epd_mode_t::epd_quality;
+          }
+          me->_display_busy = true;
+          applied = true;
 // printf("\n new_data: x:%d y:%d w:%d h:%d \n", new_data.x, new_data.y, new_data.w, new_data.h);
           bool flg_fast = ( new_data.mode == epd_mode_t::epd_fastest)
                        || ( new_data.mode == epd_mode_t::epd_fast   );
@@ -1022,15 +1150,9 @@ __asm__ __volatile(
           if (lgfx::micros() - usec >= 2048) {
             break;
           }
-
-          const update_data_t prev_data = new_data;
-          bool result;
-          while (true == (result = xQueueReceive(me->_update_queue_handle, &new_data, 0))) {
-            if (prev_data != new_data) { break; }
-          }
-          if (result == false) { break; }
         }
       }
+      if (!applied && !remain) { continue; }
 
       bus->powerControl(true);
 
@@ -55,6 +55,14 @@ namespace lgfx
 
       /// background epd writer task pinned core. (APP_CPU_NUM or PRO_CPU_NUM)
       uint8_t task_pinned_core = -1;
+
+      /// pick the waveform of each update from the amount of change.
+      /// small changes use the faster waveforms, the mode set by setEpdMode is the slowest one used.
+      bool adaptive_mode = false;
+
+      /// pixels updated with the fast / fastest waveform before a full screen clean is scheduled. (0 = never)
+      /// the clean runs in quality mode once no update is pending.
+      uint32_t ghost_budget = 0;
     };
 
     const config_detail_t& config_detail(void) const { return _config_detail; }
@@ -110,10 +118,21 @@ namespace lgfx
       }
     };
 
+    static constexpr size_t max_pending = 8;
+
+    bool _push_update(update_data_t upd);
+    bool _pop_update(update_data_t* upd);
+    epd_mode_t _select_mode(const update_data_t& upd, uint32_t* changed_pixels);
+
     static void task_update(Panel_EPD* me);
 
     TaskHandle_t _task_update_handle = nullptr;
-    QueueHandle_t _update_queue_handle = nullptr;
+
+    /// pending update regions, oldest first. merged and pruned on insertion.
+    update_data_t _pending[max_pending];
+    volatile uint8_t _pending_count = 0;
+    portMUX_TYPE _pending_lock;
+    uint32_t _ghost_pixels = 0;
   
     uint8_t* _dma_bufs[2] = { 0, 0 };
     uint16_t* _step_framebuf = nullptr;
@@ -0,0 +1,64 @@
+// CAN Receive Queue Example
+//
+// The /INT pin interrupt drains the MCP2515 receive buffers into a queue as soon as
+// frames arrive, so the two hardware buffers never overflow while loop() is busy.
+
+#include <mcp_can.h>
+#include <SPI.h>
+
+long unsigned int rxId;
+unsigned char len = 0;
+unsigned char rxBuf[8];
+char msgString[128];                        // Array to store serial string
+
+#define CAN0_INT 2                              // Set INT to pin 2
+MCP_CAN CAN0(10);                               // Set CS to pin 10
+
+
+void setup()
+{
+  Serial.begin(115200);
+  
+  // Initialize MCP2515 running at 16MHz with a baudrate of 500kb/s and the masks and filters disabled.
+  if(CAN0.begin(MCP_ANY, CAN_500KBPS, MCP_16MHZ) == CAN_OK)
+    Serial.println("MCP2515 Initialized Successfully!");
+  else
+    Serial.println("Error Initializing MCP2515...");
+  
+  CAN0.setMode(MCP_NORMAL);                     // Set operation mode to normal so the MCP2515 sends acks to received data.
+
+  if(CAN0.beginRxQueue(CAN0_INT, 32) != CAN_OK)  // Queue up to 32 frames, drained from the /INT interrupt
+    Serial.println("Error starting RX queue...");
+  
+  Serial.println("MCP2515 Library Receive Queue Example...");
+}
+
+void loop()
+{
+  while(CAN0.readQueuedMsg(&rxId, &len, rxBuf) == CAN_OK)
+  {
+    if((rxId & 0x80000000) == 0x80000000)     // Determine if ID is standard (11 bits) or extended (29 bits)
+      sprintf(msgString, "Extended ID: 0x%.8lX  DLC: %1d  Data:", (rxId & 0x1FFFFFFF), len);
+    else
+      sprintf(msgString, "Standard ID: 0x%.3lX       DLC: %1d  Data:", rxId, len);
+  
+    Serial.print(msgString);
+  
+    for(byte i = 0; i<len; i++){
+      sprintf(msgString, " 0x%.2X", rxBuf[i]);
+      Serial.print(msgString);
+    }
+        
+    Serial.println();
+  }
+
+  if(CAN0.rxQueueOverflows())
+  {
+    sprintf(msgString, "Dropped %lu frames, queue high water %d", CAN0.rxQueueOverflows(), CAN0.rxQueueHighWater());
+    Serial.println(msgString);
+  }
+}
+
+/*********************************************************************************************************
+  END FILE
+*********************************************************************************************************/
@@ -26,6 +26,16 @@
 #define spi_readwrite mcpSPI->transfer
 #define spi_read() spi_readwrite(0x00)
 
+#if defined(ARDUINO_ARCH_ESP32)
+#define MCP_ISR_ATTR IRAM_ATTR
+#define MCP_RX_BARRIER() __sync_synchronize()                           /* RX task and reader may run on different cores */
+#else
+#define MCP_ISR_ATTR
+#define MCP_RX_BARRIER() __asm__ __volatile__ ("" ::: "memory")         /* ISR and reader share the only core */
+#endif
+
+MCP_CAN *MCP_CAN::rxQueueOwner[2] = { NULL, NULL };
+
 /*********************************************************************************************************
 ** Function name:           mcp2515_reset
 ** Descriptions:            Performs a software reset
@@ -781,6 +791,65 @@ void MCP_CAN::mcp2515_read_canMsg( const INT8U buffer_sidh_addr)        /* read
     mcp2515_readRegisterS( mcp_addr+5, &(m_nDta[0]), m_nDlc );
 }
 
+/*********************************************************************************************************
+** Function name:           mcp2515_read_canMsgBurst
+** Descriptions:            Reads the next pending message in two chip selects: READ STATUS to find a full
+**                          buffer, then READ RX BUFFER which streams SIDH..D7 and clears RXnIF on /CS high.
+*********************************************************************************************************/
+INT8U MCP_CAN::mcp2515_read_canMsgBurst(MCP_CAN_Frame *frame)
+{
+    INT8U stat, instr, sidh, sidl, eid8, eid0, dlc, i;
+
+    mcpSPI->beginTransaction(SPISettings(10000000, MSBFIRST, SPI_MODE0));
+    MCP2515_SELECT();
+    spi_readwrite(MCP_READ_STATUS);
+    stat = spi_read();
+    MCP2515_UNSELECT();
+
+    if ( stat & MCP_STAT_RX0IF )                                        /* Msg in Buffer 0              */
+        instr = MCP_READ_RX0;
+    else if ( stat & MCP_STAT_RX1IF )                                   /* Msg in Buffer 1              */
+        instr = MCP_READ_RX1;
+    else
+    {
+        mcpSPI->endTransaction();
+        return CAN_NOMSG;
+    }
+
+    MCP2515_SELECT();
+    spi_readwrite(instr);                                               /* starts at RXBnSIDH           */
+    sidh = spi_read();
+    sidl = spi_read();
+    eid8 = spi_read();
+    eid0 = spi_read();
+    dlc  = spi_read();
+    frame->dlc = dlc & MCP_DLC_MASK;
+    if (frame->dlc > MAX_CHAR_IN_MESSAGE)
+        frame->dlc = MAX_CHAR_IN_MESSAGE;
+    for (i=0; i<frame->dlc; i++)
+        frame->data[i] = spi_read();
+    MCP2515_UNSELECT();                                                 /* clears RXnIF                 */
+    mcpSPI->endTransaction();
+
+    frame->id = (sidh<<3) + (sidl>>5);
+    if ( sidl & MCP_RXB_IDE_M )
+    {
+                                                                        /* extended id                  */
+        frame->id = (frame->id<<2) + (sidl & 0x03);
+        frame->id = (frame->id<<8) + eid8;
+        frame->id = (frame->id<<8) + eid0;
+        frame->ext = 1;
+        frame->rtr = (dlc & MCP_RXB_RTR_M) ? 1 : 0;
+    }
+    else
+    {
+        frame->ext = 0;
+        frame->rtr = (sidl & MCP_RXB_SRR_M) ? 1 : 0;
+    }
+
+    return CAN_OK;
+}
+
 /*********************************************************************************************************
 ** Function name:           mcp2515_getNextFreeTXBuf
 ** Descriptions:            Send message
@@ -812,6 +881,17 @@ INT8U MCP_CAN::mcp2515_getNextFreeTXBuf(INT8U *txbuf_n)                 /* get N
 *********************************************************************************************************/
 MCP_CAN::MCP_CAN(INT8U _CS)
 {
+    rxQueue = NULL;
+    rxHead = 0;
+    rxTail = 0;
+    rxQueueMask = 0;
+    rxHighWater = 0;
+    rxOverflows = 0;
+    rxIntPin = 0xFF;
+#if defined(ARDUINO_ARCH_ESP32)
+    rxTask = NULL;
+    rxTaskStop = 0;
+#endif
     MCPCS = _CS;
     MCP2515_UNSELECT();
     pinMode(MCPCS, OUTPUT);
@@ -824,6 +904,17 @@ MCP_CAN::MCP_CAN(INT8U _CS)
 *********************************************************************************************************/
 MCP_CAN::MCP_CAN(SPIClass *_SPI, INT8U _CS)
 {
+    rxQueue = NULL;
+    rxHead = 0;
+    rxTail = 0;
+    rxQueueMask = 0;
+    rxHighWater = 0;
+    rxOverflows = 0;
+    rxIntPin = 0xFF;
+#if defined(ARDUINO_ARCH_ESP32)
+    rxTask = NULL;
+    rxTaskStop = 0;
+#endif
     MCPCS = _CS;
     MCP2515_UNSELECT();
     pinMode(MCPCS, OUTPUT);
@@ -1180,26 +1271,20 @@ INT8U MCP_CAN::sendMsgBuf(INT32U id, INT8U len, INT8U *buf)
 *********************************************************************************************************/
 INT8U MCP_CAN::readMsg()
 {
-    INT8U stat, res;
+    MCP_CAN_Frame frame;
+    INT8U i;
 
-    stat = mcp2515_readStatus();
+    if ( mcp2515_read_canMsgBurst(&frame) != CAN_OK )
+        return CAN_NOMSG;
 
-    if ( stat & MCP_STAT_RX0IF )                                        /* Msg in Buffer 0              */
-    {
-        mcp2515_read_canMsg( MCP_RXBUF_0);
-        mcp2515_modifyRegister(MCP_CANINTF, MCP_RX0IF, 0);
-        res = CAN_OK;
-    }
-    else if ( stat & MCP_STAT_RX1IF )                                   /* Msg in Buffer 1              */
-    {
-        mcp2515_read_canMsg( MCP_RXBUF_1);
-        mcp2515_modifyRegister(MCP_CANINTF, MCP_RX1IF, 0);
-        res = CAN_OK;
-    }
-    else 
-        res = CAN_NOMSG;
-    
-    return res;
+    m_nID     = frame.id;
+    m_nExtFlg = frame.ext;
+    m_nRtr    = frame.rtr;
+    m_nDlc    = frame.dlc;
+    for (i=0; i<frame.dlc; i++)
+        m_nDta[i] = frame.data[i];
+
+    return CAN_OK;
 }
 
 /*********************************************************************************************************
@@ -1362,6 +1447,272 @@ INT8U MCP_CAN::getGPI(void)
     return (res >> 3);
 }
 
+/*********************************************************************************************************
+** Function name:           beginRxQueue
+** Descriptions:            Public function, drains the receive buffers into a queue whenever /INT falls.
+**                          queueSize must be a power of two between 2 and 128.
+*********************************************************************************************************/
+INT8U MCP_CAN::beginRxQueue(INT8U intPin, INT8U queueSize)
+{
+    INT8U slot;
+
+    if ( queueSize < 2 || queueSize > 128 || (queueSize & (queueSize - 1)) )
+        return CAN_FAIL;
+
+    endRxQueue();
+
+    for (slot = 0; slot < 2 && rxQueueOwner[slot] != NULL; slot++);
+    if (slot == 2)
+        return CAN_FAIL;
+
+    rxQueue = (MCP_CAN_Frame *) malloc(sizeof(MCP_CAN_Frame) * queueSize);
+    if (rxQueue == NULL)
+        return CAN_FAIL;
+
+    rxHead = 0;
+    rxTail = 0;
+    rxQueueMask = queueSize - 1;
+    rxHighWater = 0;
+    rxOverflows = 0;
+    rxIntPin = intPin;
+    rxQueueOwner[slot] = this;
+
+    pinMode(rxIntPin, INPUT);
+#if defined(ARDUINO_ARCH_ESP32)
+    rxTaskStop = 0;
+    if (xTaskCreate(rxTaskLoop, "mcp_can_rx", 2048, this, configMAX_PRIORITIES - 2, &rxTask) != pdPASS)
+    {
+        rxTask = NULL;
+        endRxQueue();
+        return CAN_FAIL;
+    }
+#else
+    mcpSPI->usingInterrupt(digitalPinToInterrupt(rxIntPin));           /* keep SPI users from racing the ISR */
+#endif
+    attachInterrupt(digitalPinToInterrupt(rxIntPin), slot ? rxIsr1 : rxIsr0, FALLING);
+
+    /* Frames that arrived before the interrupt was attached hold /INT low without a new edge */
+#if defined(ARDUINO_ARCH_ESP32)
+    xTaskNotifyGive(rxTask);
+#else
+    noInterrupts();
+    drainRx();
+    interrupts();
+#endif
+
+    return CAN_OK;
+}
+
+/*********************************************************************************************************
+** Function name:           endRxQueue
+** Descriptions:            Public function, stops interrupt driven draining and frees the queue.
+*********************************************************************************************************/
+void MCP_CAN::endRxQueue(void)
+{
+    INT8U slot;
+
+    if (rxIntPin != 0xFF)
+        detachInterrupt(digitalPinToInterrupt(rxIntPin));
+#if defined(ARDUINO_ARCH_ESP32)
+    if (rxTask != NULL)
+    {
+        /* Deleting the task could leave it in the middle of a SPI transaction with /CS low */
+        rxTaskStop = 1;
+        xTaskNotifyGive(rxTask);
+        while (rxTaskStop)
+            vTaskDelay(1);
+        rxTask = NULL;
+    }
+#endif
+    for (slot = 0; slot < 2; slot++)
+        if (rxQueueOwner[slot] == this)
+            rxQueueOwner[slot] = NULL;
+
+    if (rxQueue != NULL)
+    {
+        free(rxQueue);
+        rxQueue = NULL;
+    }
+    rxIntPin = 0xFF;
+}
+
+/*********************************************************************************************************
+** Function name:           drainRx
+** Descriptions:            Public function, moves every pending frame from the MCP2515 into the queue.
+**                          Only the ISR (or the RX task on ESP32) should call this once beginRxQueue() ran.
+*********************************************************************************************************/
+INT8U MCP_CAN::drainRx(void)
+{
+    MCP_CAN_Frame frame;
+    INT8U moved = 0, used;
+    uint16_t reads = 0;
+
+    if (rxQueue == NULL)
+        return 0;
+
+    /* Bounded so a busy bus can't keep us here forever */
+    while ( reads++ < 2 * (rxQueueMask + 1) && mcp2515_read_canMsgBurst(&frame) == CAN_OK )
+    {
+        used = (INT8U)(rxTail - rxHead);
+        if (used > rxQueueMask)
+        {
+            rxOverflows++;                                              /* frame is gone from the chip anyway */
+            continue;
+        }
+        rxQueue[rxTail & rxQueueMask] = frame;
+        MCP_RX_BARRIER();                                               /* publish the slot before the index */
+        rxTail++;
+        moved++;
+        if (used + 1 > rxHighWater)
+            rxHighWater = used + 1;
+    }
+    return moved;
+}
+
+/*********************************************************************************************************
+** Function name:           rxIsr
+** Descriptions:            /INT falling edge handlers
+*********************************************************************************************************/
+void MCP_ISR_ATTR MCP_CAN::rxIsr0(void)
+{
+    if (rxQueueOwner[0] != NULL)
+        rxQueueOwner[0]->rxIsr();
+}
+
+void MCP_ISR_ATTR MCP_CAN::rxIsr1(void)
+{
+    if (rxQueueOwner[1] != NULL)
+        rxQueueOwner[1]->rxIsr();
+}
+
+void MCP_ISR_ATTR MCP_CAN::rxIsr(void)
+{
+#if defined(ARDUINO_ARCH_ESP32)
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(rxTask, &woken);
+    if (woken == pdTRUE)
+        portYIELD_FROM_ISR();
+#else
+    drainRx();
+#endif
+}
+
+#if defined(ARDUINO_ARCH_ESP32)
+/*********************************************************************************************************
+** Function name:           rxTaskLoop
+** Descriptions:            Drains the controller whenever the ISR signals, polls /INT as a fallback
+*********************************************************************************************************/
+void MCP_CAN::rxTaskLoop(void *arg)
+{
+    MCP_CAN *self = (MCP_CAN *) arg;
+
+    while (!self->rxTaskStop)
+    {
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10)) || !digitalRead(self->rxIntPin))
+            self->drainRx();
+    }
+    self->rxTaskStop = 0;                                               /* SPI released, endRxQueue() can go on */
+    vTaskDelete(NULL);
+}
+#endif
+
+/*********************************************************************************************************
+** Function name:           readQueuedMsg
+** Descriptions:            Public function, reads a message from the RX queue.
+*********************************************************************************************************/
+INT8U MCP_CAN::readQueuedMsg(INT32U *id, INT8U *ext, INT8U *len, INT8U buf[])
+{
+    MCP_CAN_Frame *frame;
+    INT8U i;
+
+    if (rxQueue == NULL)
+        return readMsgBuf(id, ext, len, buf);
+
+#if !defined(ARDUINO_ARCH_ESP32)
+    if (rxTail == rxHead && !digitalRead(rxIntPin))                     /* missed edge, /INT still low  */
+    {
+        noInterrupts();
+        drainRx();
+        interrupts();
+    }
+#endif
+
+    if (rxTail == rxHead)
+        return CAN_NOMSG;
+    MCP_RX_BARRIER();                                                   /* read the slot after the index */
+
+    frame = &rxQueue[rxHead & rxQueueMask];
+    *id  = frame->id;
+    *ext = frame->ext;
+    *len = frame->dlc;
+    for (i=0; i<frame->dlc; i++)
+        buf[i] = frame->data[i];
+    MCP_RX_BARRIER();                                                   /* release the slot after reading it */
+    rxHead++;
+
+    return CAN_OK;
+}
+
+/*********************************************************************************************************
+** Function name:           readQueuedMsg
+** Descriptions:            Public function, reads a message from the RX queue, ID flagged like readMsgBuf().
+*********************************************************************************************************/
+INT8U MCP_CAN::readQueuedMsg(INT32U *id, INT8U *len, INT8U buf[])
+{
+    INT8U ext, rtr;
+
+    if (rxQueue == NULL)
+        return readMsgBuf(id, len, buf);
+
+    rtr = 0;
+    if (rxTail != rxHead)
+    {
+        MCP_RX_BARRIER();
+        rtr = rxQueue[rxHead & rxQueueMask].rtr;
+    }
+
+    if (readQueuedMsg(id, &ext, len, buf) != CAN_OK)
+        return CAN_NOMSG;
+
+    if (ext)
+        *id |= 0x80000000;
+    if (rtr)
+        *id |= 0x40000000;
+
+    return CAN_OK;
+}
+
+/*********************************************************************************************************
+** Function name:           queuedMsgs
+** Descriptions:            Public function, number of frames waiting in the RX queue.
+*********************************************************************************************************/
+INT8U MCP_CAN::queuedMsgs(void)
+{
+    return (INT8U)(rxTail - rxHead);
+}
+
+/*********************************************************************************************************
+** Function name:           rxQueueOverflows
+** Descriptions:            Public function, frames dropped because the RX queue was full.
+*********************************************************************************************************/
+INT32U MCP_CAN::rxQueueOverflows(void)
+{
+    INT32U res;
+    noInterrupts();
+    res = rxOverflows;
+    interrupts();
+    return res;
+}
+
+/*********************************************************************************************************
+** Function name:           rxQueueHighWater
+** Descriptions:            Public function, highest RX queue fill level seen since beginRxQueue().
+*********************************************************************************************************/
+INT8U MCP_CAN::rxQueueHighWater(void)
+{
+    return rxHighWater;
+}
+
 /*********************************************************************************************************
   END FILE
 *********************************************************************************************************/
@@ -27,6 +27,18 @@
 #include "mcp_can_dfs.h"
 #define MAX_CHAR_IN_MESSAGE 8
 
+#ifndef MCP_RX_QUEUE_SIZE
+#define MCP_RX_QUEUE_SIZE 16                                            // Default frames in the RX queue, power of two
+#endif
+
+typedef struct {
+    INT32U  id;
+    INT8U   ext;
+    INT8U   rtr;
+    INT8U   dlc;
+    INT8U   data[MAX_CHAR_IN_MESSAGE];
+} MCP_CAN_Frame;
+
 class MCP_CAN
 {
     private:
@@ -41,6 +53,19 @@ class MCP_CAN
     SPIClass *mcpSPI;                                                       // The SPI-Device used
     INT8U   MCPCS;                                                      // Chip Select pin number
     INT8U   mcpMode;                                                    // Mode to return to after configurations are performed.
+
+    MCP_CAN_Frame *rxQueue;                                             // Frames drained by the INT pin interrupt
+    volatile INT8U rxHead;                                              // Consumer index
+    volatile INT8U rxTail;                                              // Producer index
+    INT8U   rxQueueMask;
+    INT8U   rxHighWater;
+    volatile INT32U rxOverflows;
+    INT8U   rxIntPin;
+#if defined(ARDUINO_ARCH_ESP32)
+    TaskHandle_t rxTask;                                                // SPI can't be used from an ISR on ESP32
+    volatile INT8U rxTaskStop;                                          // Set by endRxQueue(), cleared by the task on exit
+#endif
+    static MCP_CAN *rxQueueOwner[2];
     
 
 /*********************************************************************************************************
@@ -95,6 +120,7 @@ class MCP_CAN
 
     void mcp2515_write_canMsg( const INT8U buffer_sidh_addr );          // Write CAN message
     void mcp2515_read_canMsg( const INT8U buffer_sidh_addr);            // Read CAN message
+    INT8U mcp2515_read_canMsgBurst(MCP_CAN_Frame *frame);              // Read next CAN message with READ RX BUFFER
     INT8U mcp2515_getNextFreeTXBuf(INT8U *txbuf_n);                     // Find empty transmit buffer
 
 /*********************************************************************************************************
@@ -106,6 +132,13 @@ class MCP_CAN
     INT8U readMsg();                                                    // Read message
     INT8U sendMsg();                                                    // Send message
 
+    static void rxIsr0(void);                                           // INT pin handlers for up to two controllers
+    static void rxIsr1(void);
+    void rxIsr(void);
+#if defined(ARDUINO_ARCH_ESP32)
+    static void rxTaskLoop(void *arg);
+#endif
+
 public:
     MCP_CAN(INT8U _CS);
     MCP_CAN(SPIClass *_SPI, INT8U _CS);
@@ -130,6 +163,15 @@ public:
     INT8U abortTX(void);                                                // Abort queued transmission(s)
     INT8U setGPO(INT8U data);                                           // Sets GPO
     INT8U getGPI(void);                                                 // Reads GPI
+
+    INT8U beginRxQueue(INT8U intPin, INT8U queueSize = MCP_RX_QUEUE_SIZE); // Drain receive buffers into a queue from the INT pin interrupt
+    void endRxQueue(void);                                              // Stop interrupt driven draining and free the queue
+    INT8U drainRx(void);                                                // Move every pending frame into the queue, returns frames moved
+    INT8U readQueuedMsg(INT32U *id, INT8U *ext, INT8U *len, INT8U *buf); // Read message from the RX queue
+    INT8U readQueuedMsg(INT32U *id, INT8U *len, INT8U *buf);            // Read message from the RX queue
+    INT8U queuedMsgs(void);                                             // Frames waiting in the RX queue
+    INT32U rxQueueOverflows(void);                                      // Frames lost because the RX queue was full
+    INT8U rxQueueHighWater(void);                                       // Highest RX queue fill level seen
 };
 
 #endif
@@ -75,6 +75,7 @@
 #define MCP_TXB_RTR_M       0x40                                        /* In TXBnDLC                   */
 #define MCP_RXB_IDE_M       0x08                                        /* In RXBnSIDL                  */
 #define MCP_RXB_RTR_M       0x40                                        /* In RXBnDLC                   */
+#define MCP_RXB_SRR_M       0x10                                        /* In RXBnSIDL, standard RTR    */
 
 #define MCP_STAT_RXIF_MASK   (0x03)
 #define MCP_STAT_RX0IF       (1<<0)
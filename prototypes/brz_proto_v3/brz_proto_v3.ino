@@ -1,5 +1,9 @@
 #include <Arduino.h>
 #include <ESP32-TWAI-CAN.hpp>
+#include <CanSignalDecoder.hpp>
+#include <TwaiTelemetry.hpp>
+#include <CanIdFilter.hpp>
+#include <ObdPoller.hpp>
 #include <M5GFX.h>
 #include <M5_ADS1115.h>
 
@@ -27,12 +31,63 @@
 
 #define FLASH 192
 
+// decoded signals, same order as g_signals
+enum {
+  SIG_OIL_TEMP,
+  SIG_WATER_TEMP,
+  SIG_RPM,
+  SIG_COUNT
+};
+
+const CanSignal g_signals[SIG_COUNT] = {
+  // id           start len order              signed scale offset
+  { SUB_OIL_COOL, 16,   8,  CAN_LITTLE_ENDIAN, false, 1.0f, -40.0f },
+  { SUB_OIL_COOL, 24,   8,  CAN_LITTLE_ENDIAN, false, 1.0f, -40.0f },
+  // hi byte holds the top 5 bits
+  { SUB_RPM_ACC,  16,   13, CAN_LITTLE_ENDIAN, false, 1.0f, 0.0f },
+};
+
+CanSignalDecoder<SIG_COUNT> g_decoder;
+
+// only let the frames we decode through the TWAI acceptance filter
+const uint32_t g_wantedIds[] = { SUB_OIL_COOL, SUB_RPM_ACC, ODB_RPM };
+CanIdFilter<3> g_idFilter;
+
+// polled from the engine ECU, answers come back on ODB_RPM
+enum {
+  PID_STFT,
+  PID_LTFT,
+  PID_COUNT
+};
+
+const ObdPid g_pids[PID_COUNT] = {
+  // ecu mode  pid   prio period
+  { 0,   0x01, 0x06, 5,   1000 },
+  { 0,   0x01, 0x07, 5,   1000 },
+};
+
+ObdPoller<PID_COUNT> g_obd;
+bool g_trimsChanged = false;
+int32_t g_shortTrim = 0;
+int32_t g_longTrim = 0;
+
+// decoded on the CAN core, read by the display loop
+struct Telemetry {
+  int32_t oilTemp;
+  int32_t waterTemp;
+  int32_t rpm;
+  int32_t oilPeak;
+  int32_t waterPeak;
+  int32_t shortTrim;  // fuel trims in percent
+  int32_t longTrim;
+};
+
+TwaiTelemetry<Telemetry> g_telemetry;
+uint32_t g_telemetryVersion = 0;
+
 M5GFX display;
 ADS1115 meter;
 
-float g_voltRes = 0.0;
-float g_voltCal = 0.0;
-
 bool g_canOk = false;
 
 int g_oilTemp = 888;
@@ -43,6 +98,9 @@ int g_rpm = 8888;
 int g_oilPeak = 888;
 int g_waterPeak = 888;
 
+int g_shortTrimShown = 888;
+int g_longTrimShown = 888;
+
 int g_screenW = 0;
 int g_screenH = 0;
 
@@ -53,6 +111,7 @@ bool g_rpmChanged = true;
 
 bool g_oilPeakChanged = true;
 bool g_waterPeakChanged = true;
+bool g_trimChanged = true;
 
 //Oil pressure sender calibration
 float g_vMin = 0.47;
@@ -68,6 +127,22 @@ uint g_flasher = HIGH;
 int g_inset = 70;
 int g_h72 = 80;
 
+// a value on a colored band; only the digits that changed get redrawn
+struct Gauge {
+  LGFX_NumberField field;
+  int x, y, w, h;
+  uint16_t bg;
+};
+
+Gauge g_oilGauge;
+Gauge g_waterGauge;
+Gauge g_oilPressGauge;
+Gauge g_rpmGauge;
+Gauge g_oilPeakGauge;
+Gauge g_waterPeakGauge;
+Gauge g_shortTrimGauge;
+Gauge g_longTrimGauge;
+
 // flash LEDs by returning isON && FLASH
 uint isOn(uint state) {
   if (state == FLASH) {
@@ -84,94 +159,79 @@ void setLights(uint g, uint y, uint r) {
   digitalWrite(YELLOW_PIN, isOn(y));
 }
 
+void initGauge(Gauge& g, int x, int y, int w, int h, int textX, int textY, const lgfx::IFont* font) {
+  g.x = x;
+  g.y = y;
+  g.w = w;
+  g.h = h;
+  g.bg = TFT_BLACK;
+  g.field.init(&display, textX, textY, textdatum_t::top_right, font, (uint16_t)TFT_WHITE, (uint16_t)TFT_BLACK);
+}
+
+// repaint the whole band only when its color changes
+void setGaugeColor(Gauge& g, uint16_t color) {
+  if (color != g.bg) {
+    g.bg = color;
+    display.fillRect(g.x, g.y, g.w, g.h, color);
+    g.field.setTextColor((uint16_t)TFT_WHITE, color);
+  }
+}
+
+uint16_t tempColor(int temp) {
+  if (temp < 70) {
+    return TFT_BLUE;
+  } else if (temp > 110) {
+    return TFT_RED;
+  }
+  return TFT_BLACK;
+}
+
 void updateDisplay() {
-  uint16_t color;
   bool draw = false;
-  if (g_oilTempChanged || g_waterChanged || g_rpmChanged || g_oilPressChanged || g_oilPeakChanged || g_waterPeakChanged) {
+  if (g_oilTempChanged || g_waterChanged || g_rpmChanged || g_oilPressChanged || g_oilPeakChanged || g_waterPeakChanged || g_trimChanged) {
     draw = true;
     display.startWrite();
-    display.setTextDatum(textdatum_t::top_right);
   }
 
   if (g_oilTempChanged) {
     g_oilTempChanged = false;
-    if (g_oilTemp < 70) {
-      color = TFT_BLUE;
-    } else if (g_oilTemp > 110) {
-      color = TFT_RED;
-    } else {
-      color = TFT_BLACK;
-    }
-    display.setTextColor(TFT_WHITE, color);
-    display.fillRect(g_inset, 0, g_screenW - g_inset, g_h72, color);
-    display.setFont(&fonts::DejaVu72);
-    display.drawNumber(g_oilTemp, g_screenW, 4);
+    setGaugeColor(g_oilGauge, tempColor(g_oilTemp));
+    g_oilGauge.field.drawNumber(g_oilTemp);
   }
 
   if (g_waterChanged) {
     g_waterChanged = false;
-    if (g_waterTemp < 70) {
-      color = TFT_BLUE;
-    } else if (g_waterTemp > 110) {
-      color = TFT_RED;
-    } else {
-      color = TFT_BLACK;
-    }
-    display.setTextColor(TFT_WHITE, color);
-    display.fillRect(g_inset, g_h72, g_screenW - g_inset, g_h72, color);
-    display.setFont(&fonts::DejaVu72);
-    display.drawNumber(g_waterTemp, g_screenW, g_h72 + 4);
+    setGaugeColor(g_waterGauge, tempColor(g_waterTemp));
+    g_waterGauge.field.drawNumber(g_waterTemp);
   }
 
   if (g_oilPressChanged) {
     g_oilPressChanged = false;
-    if (g_oilPress < 0.5) {
-      color = TFT_RED;
-    } else {
-      color = TFT_BLACK;
-    }
-    display.setTextColor(TFT_WHITE, color);
-    display.fillRect(g_inset, 2 * g_h72, g_screenW - g_inset, g_h72, color);
-    display.setFont(&fonts::DejaVu72);
-    display.drawFloat(g_oilPress, 1, g_screenW, 2 * g_h72 + 4);
+    setGaugeColor(g_oilPressGauge, g_oilPress < 0.5 ? TFT_RED : TFT_BLACK);
+    g_oilPressGauge.field.drawFloat(g_oilPress, 1);
   }
 
   if (g_rpmChanged) {
     g_rpmChanged = false;
-    display.setTextColor(TFT_WHITE, TFT_BLACK);
-    display.fillRect(g_inset, 3 * g_h72, g_screenW - g_inset, 40, TFT_BLACK);
-    display.setFont(&fonts::DejaVu40);
-    display.drawNumber(g_rpm, g_screenW, 3 * g_h72 + 3);
+    g_rpmGauge.field.drawNumber(g_rpm);
   }
 
   if (g_oilPeakChanged) {
     g_oilPeakChanged = false;
-    if (g_oilPeak < 70) {
-      color = TFT_BLUE;
-    } else if (g_oilPeak > 110) {
-      color = TFT_RED;
-    } else {
-      color = TFT_BLACK;
-    }
-    display.setTextColor(TFT_WHITE, color);
-    display.fillRect(40, g_screenH - 38, g_screenW / 2 - 40, 38, color);
-    display.setFont(&fonts::DejaVu40);
-    display.drawNumber(g_oilPeak, g_screenW / 2, g_screenH - 36);
+    setGaugeColor(g_oilPeakGauge, tempColor(g_oilPeak));
+    g_oilPeakGauge.field.drawNumber(g_oilPeak);
   }
 
   if (g_waterPeakChanged) {
     g_waterPeakChanged = false;
-    if (g_waterPeak < 70) {
-      color = TFT_BLUE;
-    } else if (g_waterPeak > 110) {
-      color = TFT_RED;
-    } else {
-      color = TFT_BLACK;
-    }
-    display.setTextColor(TFT_WHITE, color);
-    display.fillRect(g_screenW / 2 + 40, g_screenH - 38, g_screenW / 2 - 40, 38, color);
-    display.setFont(&fonts::DejaVu40);
-    display.drawNumber(g_waterPeak, g_screenW, g_screenH - 36);
+    setGaugeColor(g_waterPeakGauge, tempColor(g_waterPeak));
+    g_waterPeakGauge.field.drawNumber(g_waterPeak);
+  }
+
+  if (g_trimChanged) {
+    g_trimChanged = false;
+    g_shortTrimGauge.field.drawNumber(g_shortTrimShown);
+    g_longTrimGauge.field.drawNumber(g_longTrimShown);
   }
 
   if (draw) {
@@ -191,14 +251,81 @@ void initDisplay() {
   display.drawString("Water", 0, g_h72 + 4);
   display.drawString("Oil P", 0, g_h72 * 2 + 4);
   display.drawString("RPM", 0, g_h72 * 3 + 3);
+  display.drawString("ST", 0, g_h72 * 3 + 46);
+  display.drawString("LT", g_screenW / 2 + 3, g_h72 * 3 + 46);
   display.drawString("OP", 0, g_screenH - 36);
   display.drawString("WP", g_screenW / 2 + 3, g_screenH - 36);
 
   display.endWrite();
 
+  initGauge(g_oilGauge, g_inset, 0, g_screenW - g_inset, g_h72, g_screenW, 4, &fonts::DejaVu72);
+  initGauge(g_waterGauge, g_inset, g_h72, g_screenW - g_inset, g_h72, g_screenW, g_h72 + 4, &fonts::DejaVu72);
+  initGauge(g_oilPressGauge, g_inset, 2 * g_h72, g_screenW - g_inset, g_h72, g_screenW, 2 * g_h72 + 4, &fonts::DejaVu72);
+  initGauge(g_rpmGauge, g_inset, 3 * g_h72, g_screenW - g_inset, 40, g_screenW, 3 * g_h72 + 3, &fonts::DejaVu40);
+  initGauge(g_shortTrimGauge, 40, g_h72 * 3 + 44, g_screenW / 2 - 40, 38, g_screenW / 2, g_h72 * 3 + 46, &fonts::DejaVu40);
+  initGauge(g_longTrimGauge, g_screenW / 2 + 40, g_h72 * 3 + 44, g_screenW / 2 - 40, 38, g_screenW, g_h72 * 3 + 46, &fonts::DejaVu40);
+  initGauge(g_oilPeakGauge, 40, g_screenH - 38, g_screenW / 2 - 40, 38, g_screenW / 2, g_screenH - 36, &fonts::DejaVu40);
+  initGauge(g_waterPeakGauge, g_screenW / 2 + 40, g_screenH - 38, g_screenW / 2 - 40, 38, g_screenW, g_screenH - 36, &fonts::DejaVu40);
+
   updateDisplay();
 }
 
+// OBD answers, called from g_obd.onFrame() inside ingestCan()
+void onPid(size_t index, const uint8_t* data, size_t length, void*) {
+  if (length < 1) {
+    return;
+  }
+  int32_t trim = ((int32_t)data[0] - 128) * 100 / 128;
+  if (index == PID_STFT) {
+    g_shortTrim = trim;
+  } else if (index == PID_LTFT) {
+    g_longTrim = trim;
+  }
+  g_trimsChanged = true;
+}
+
+// runs on the CAN core, g_decoder and g_obd are only touched here
+bool ingestCan(const CanFrame* frames, size_t count, Telemetry& t, void*) {
+  bool changed = false;
+  uint32_t now = millis();
+
+  for (size_t i = 0; i < count; i++) {
+    //Serial.printf("Received frame: %03X  \r\n", frames[i].identifier);
+    if (!g_obd.onFrame(frames[i], now) && g_decoder.decode(frames[i]) > 0) {
+      changed = true;
+    }
+  }
+
+  // count is 0 after the idle timeout, so this also runs on a quiet bus
+  g_obd.poll(now);
+
+  if (g_trimsChanged) {
+    g_trimsChanged = false;
+    t.shortTrim = g_shortTrim;
+    t.longTrim = g_longTrim;
+    changed = true;
+  }
+
+  if (changed) {
+    if (g_decoder.consumeChanged(SIG_OIL_TEMP)) {
+      t.oilTemp = g_decoder.valueInt(SIG_OIL_TEMP);
+      if (t.oilTemp > t.oilPeak) {
+        t.oilPeak = t.oilTemp;
+      }
+    }
+    if (g_decoder.consumeChanged(SIG_WATER_TEMP)) {
+      t.waterTemp = g_decoder.valueInt(SIG_WATER_TEMP);
+      if (t.waterTemp > t.waterPeak) {
+        t.waterPeak = t.waterTemp;
+      }
+    }
+    if (g_decoder.consumeChanged(SIG_RPM)) {
+      t.rpm = g_decoder.valueInt(SIG_RPM);
+    }
+  }
+  return changed;
+}
+
 void setup() {
   int baud = 500;
 
@@ -211,8 +338,16 @@ void setup() {
   g_screenW = display.width();
   g_screenH = display.height();
 
-  if (ESP32Can.begin(ESP32Can.convertSpeed(baud), CAN_TX, CAN_RX, 10, 100)) {
-    g_canOk = true;
+  g_decoder.begin(g_signals);
+  g_obd.begin(ESP32Can, g_pids, PID_COUNT, onPid);
+
+  twai_filter_config_t filter;
+  g_idFilter.begin(g_wantedIds, 3);
+  g_idFilter.twai().toConfig(filter);
+
+  if (ESP32Can.begin(ESP32Can.convertSpeed(baud), CAN_TX, CAN_RX, 10, 100, &filter)) {
+    // CAN intake on core 0, loop() keeps the display on core 1
+    g_canOk = g_telemetry.begin(ESP32Can, ingestCan, Telemetry());
   } else {
     g_canOk = false;
   }
@@ -225,12 +360,15 @@ void setup() {
   g_rpm = 0;
   g_oilPeak = 0;
   g_waterPeak = 0;
+  g_shortTrimShown = 0;
+  g_longTrimShown = 0;
   g_oilTempChanged = true;
   g_oilPressChanged = true;
   g_waterChanged = true;
   g_rpmChanged = true;
   g_oilPeakChanged = true;
   g_waterPeakChanged = true;
+  g_trimChanged = true;
 
   if (!meter.begin(&Wire, M5_UNIT_VMETER_I2C_ADDR, 21, 22, 400000U)) {
     delay(500);
@@ -242,8 +380,8 @@ void setup() {
   meter.setRate(ADS1115_RATE_8);
   meter.setGain(ADS1115_PGA_256);
 
-  g_voltRes = meter.getCoefficient() / M5_UNIT_VMETER_PRESSURE_COEFFICIENT;
-  g_voltCal = meter.getFactoryCalibration();
+  // the vmeter converts in the background on the CAN core, loop() only drains samples
+  meter.startAcquisition();
 
   // Set the LED pins as an output
   pinMode(RED_PIN, OUTPUT);
@@ -255,44 +393,35 @@ void setup() {
 }
 
 void loop() {
-  CanFrame rxFrame;
+  Telemetry t;
   ulong now;
-  int val;
-
-  if (ESP32Can.readFrame(rxFrame, FLASH_UPDATE)) {
-    //Serial.printf("Received frame: %03X  \r\n", rxFrame.identifier);
-    if (rxFrame.identifier == SUB_OIL_COOL) {
-      // oil temp
-      val = rxFrame.data[2] - 40;
-      if (g_oilTemp != val)
-      {
-        g_oilTempChanged = true;
-        g_oilTemp = val;
-      }
-      // water temp
-      val = rxFrame.data[3] - 40;
-      if (g_waterTemp != val)
-      {
-        g_waterChanged = true;
-        g_waterTemp = val;
-      }    
-      if (g_oilTemp > g_oilPeak) {
-        g_oilPeak = g_oilTemp;
-        g_oilPeakChanged = true;
-      }
-      if (g_waterTemp > g_waterPeak) {
-        g_waterPeak = g_waterTemp;
-        g_waterPeakChanged = true;
-      }
+
+  if (g_telemetry.version() != g_telemetryVersion) {
+    g_telemetryVersion = g_telemetry.read(t);
+    if (g_oilTemp != t.oilTemp) {
+      g_oilTemp = t.oilTemp;
+      g_oilTempChanged = true;
     }
-    // RPM
-    if (rxFrame.identifier == SUB_RPM_ACC) {
-      uint8_t hiByte = rxFrame.data[3] << 3;
-      val = (hiByte * 32) + rxFrame.data[2];
-      if (g_rpm != val) {
-        g_rpm = val;
-        g_rpmChanged = true;
-      }
+    if (g_waterTemp != t.waterTemp) {
+      g_waterTemp = t.waterTemp;
+      g_waterChanged = true;
+    }
+    if (g_rpm != t.rpm) {
+      g_rpm = t.rpm;
+      g_rpmChanged = true;
+    }
+    if (g_oilPeak != t.oilPeak) {
+      g_oilPeak = t.oilPeak;
+      g_oilPeakChanged = true;
+    }
+    if (g_waterPeak != t.waterPeak) {
+      g_waterPeak = t.waterPeak;
+      g_waterPeakChanged = true;
+    }
+    if (g_shortTrimShown != t.shortTrim || g_longTrimShown != t.longTrim) {
+      g_shortTrimShown = t.shortTrim;
+      g_longTrimShown = t.longTrim;
+      g_trimChanged = true;
     }
   }
 
@@ -319,18 +448,23 @@ void loop() {
     }
   }
 
-  if (now - DISPLAY_UPDATE > g_lastDisplayUpdate) {
-    g_lastDisplayUpdate = now;
-
-    int16_t adc_raw = meter.getSingleConversion();
-    float volt = adc_raw * g_voltRes * g_voltCal / 1000.0;
+  ads1115_sample_t sample;
+  while (meter.readSample(&sample)) {
+    float volt = meter.toMillivolts(sample.raw) / M5_UNIT_VMETER_PRESSURE_COEFFICIENT / 1000.0;
     float raw = (volt - g_vMin) / (g_vMax - g_vMin) * (g_pMax - g_pMin) + g_pMin;
     g_oilPress = 0.7 * g_oilPress + 0.3 * raw;
     //g_oilPress = volt;
     g_oilPressChanged = true;
+  }
+
+  if (now - DISPLAY_UPDATE > g_lastDisplayUpdate) {
+    g_lastDisplayUpdate = now;
 
     if (!display.displayBusy()) {
       updateDisplay();
     }
   }
+
+  // CAN is handled on the other core, just give the idle task a tick
+  delay(1);
 }
\ No newline at end of file
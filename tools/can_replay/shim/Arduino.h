@@ -0,0 +1,51 @@
+// Host stand-in for the parts of the Arduino-ESP32 core the prototypes use.
+#ifndef CAN_REPLAY_ARDUINO_H
+#define CAN_REPLAY_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <sys/types.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+#define HIGH            0x1
+#define LOW             0x0
+#define INPUT           0x01
+#define OUTPUT          0x03
+#define INPUT_PULLUP    0x05
+#define RISING          0x01
+#define FALLING         0x02
+#define CHANGE          0x03
+
+uint32_t millis(void);
+uint32_t micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield(void);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+inline int digitalPinToInterrupt(int pin) { return pin; }
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode);
+void attachInterruptArg(uint8_t pin, void (*isr)(void*), void* arg, int mode);
+void detachInterrupt(uint8_t pin);
+
+class HardwareSerial {
+ public:
+    void begin(unsigned long) {}
+    template <typename... Args> int printf(const char* format, Args... args) { return ::printf(format, args...); }
+    int print(const char* s) { return ::printf("%s", s); }
+    int println(const char* s = "") { return ::printf("%s\n", s); }
+};
+extern HardwareSerial Serial;
+
+#endif
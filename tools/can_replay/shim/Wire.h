@@ -0,0 +1,44 @@
+// Host stand-in for TwoWire. Transfers go to device models registered per address,
+// addresses without a model NACK like an empty bus.
+#ifndef CAN_REPLAY_WIRE_H
+#define CAN_REPLAY_WIRE_H
+
+#include "Arduino.h"
+
+class I2cDeviceModel {
+ public:
+    virtual ~I2cDeviceModel() {}
+    // One write transaction, data[0] is usually the register pointer
+    virtual void write(const uint8_t* data, size_t length) = 0;
+    // One read transaction from the current register pointer
+    virtual void read(uint8_t* data, size_t length) = 0;
+};
+
+class TwoWire {
+ public:
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+    bool end();
+
+    void beginTransmission(uint8_t address);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t* data, size_t length);
+    uint8_t endTransmission(bool sendStop = true);
+
+    uint8_t requestFrom(uint8_t address, uint8_t length, bool sendStop = true);
+    int available();
+    int read();
+
+    static void attach(uint8_t address, I2cDeviceModel* model);
+
+ private:
+    uint8_t address = 0;
+    uint8_t txBuffer[64];
+    size_t txLength = 0;
+    uint8_t rxBuffer[64];
+    size_t rxLength = 0;
+    size_t rxIndex = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
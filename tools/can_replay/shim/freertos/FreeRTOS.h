@@ -0,0 +1,26 @@
+// Host stand-in for the FreeRTOS API used by the sketches and libraries.
+// Tasks are std::threads, one tick is one millisecond.
+#ifndef CAN_REPLAY_FREERTOS_H
+#define CAN_REPLAY_FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef struct HostTask* TaskHandle_t;
+
+#define pdPASS                  1
+#define pdFAIL                  0
+#define pdTRUE                  1
+#define pdFALSE                 0
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFFU)
+#define portTICK_PERIOD_MS      1
+#define configMAX_PRIORITIES    25
+#define tskNO_AFFINITY          0x7FFFFFFF
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms))
+
+#define portYIELD_FROM_ISR(...) do {} while(0)
+
+#endif
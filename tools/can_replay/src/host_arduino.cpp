@@ -0,0 +1,332 @@
+// Arduino core, FreeRTOS and Wire on top of the C++ standard library.
+// Every FreeRTOS task is a std::thread, ticks are milliseconds of the host clock.
+#include "host_arduino.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct HostTask {
+    std::string name;
+    std::mutex lock;
+    std::condition_variable wake;
+    uint32_t notified = 0;
+    std::atomic<bool> deleted{false};
+};
+
+namespace {
+
+// thrown by vTaskDelete(NULL) and by blocking calls of a deleted task, ends the thread
+struct TaskExit {};
+
+const auto startTime = std::chrono::steady_clock::now();
+
+std::mutex tasksLock;
+std::vector<HostTask*> tasks;
+
+thread_local HostTask* currentTask = nullptr;
+
+HostTask* self() {
+    if(!currentTask) {
+        // the main thread (setup/loop) gets a handle on first use
+        currentTask = new HostTask();
+        currentTask->name = "loopTask";
+    }
+    return currentTask;
+}
+
+void checkDeleted() {
+    if(currentTask && currentTask->deleted.load()) throw TaskExit();
+}
+
+void sleepTicks(TickType_t ticks) {
+    checkDeleted();
+    HostTask* task = self();
+    std::unique_lock<std::mutex> guard(task->lock);
+    task->wake.wait_for(guard, std::chrono::milliseconds(ticks), [task] { return task->deleted.load(); });
+    guard.unlock();
+    checkDeleted();
+}
+
+uint8_t pinLevels[64];
+
+} // namespace
+
+HardwareSerial Serial;
+TwoWire Wire;
+
+//------------------------------------------------------------------------------
+// Arduino core
+
+namespace host {
+
+uint64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void stopTasks() {
+    std::lock_guard<std::mutex> guard(tasksLock);
+    for(HostTask* task : tasks) {
+        task->deleted = true;
+        task->wake.notify_all();
+    }
+}
+
+void checkTaskDeleted() { checkDeleted(); }
+
+} // namespace host
+
+uint32_t millis(void) { return (uint32_t)(host::nowNs() / 1000000); }
+uint32_t micros(void) { return (uint32_t)(host::nowNs() / 1000); }
+
+void delay(uint32_t ms) { sleepTicks(ms); }
+
+void delayMicroseconds(uint32_t us) {
+    checkDeleted();
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield(void) { std::this_thread::yield(); }
+
+void pinMode(uint8_t pin, uint8_t mode) { (void)pin; (void)mode; }
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if(pin < sizeof(pinLevels)) pinLevels[pin] = value;
+}
+
+int digitalRead(uint8_t pin) { return pin < sizeof(pinLevels) ? pinLevels[pin] : LOW; }
+
+// no GPIO edges on the host, the libraries fall back to their timed paths
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode) { (void)pin; (void)isr; (void)mode; }
+void attachInterruptArg(uint8_t pin, void (*isr)(void*), void* arg, int mode) { (void)pin; (void)isr; (void)arg; (void)mode; }
+void detachInterrupt(uint8_t pin) { (void)pin; }
+
+//------------------------------------------------------------------------------
+// FreeRTOS
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+    (void)stack; (void)priority; (void)core;
+    HostTask* task = new HostTask();
+    task->name = name ? name : "";
+    {
+        std::lock_guard<std::mutex> guard(tasksLock);
+        tasks.push_back(task);
+    }
+    if(handle) *handle = task;
+    std::thread([task, fn, arg] {
+        currentTask = task;
+        try {
+            fn(arg);
+        } catch(const TaskExit&) {
+        }
+    }).detach();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stack, void* arg,
+                       UBaseType_t priority, TaskHandle_t* handle) {
+    return xTaskCreatePinnedToCore(fn, name, stack, arg, priority, handle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if(task == nullptr || task == currentTask) throw TaskExit();
+    task->deleted = true;
+    task->wake.notify_all();
+}
+
+TickType_t xTaskGetTickCount(void) { return millis(); }
+
+void vTaskDelay(TickType_t ticks) { sleepTicks(ticks); }
+
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t period) {
+    TickType_t next = *previousWake + period;
+    TickType_t now = xTaskGetTickCount();
+    *previousWake = next;
+    if((int32_t)(next - now) > 0) sleepTicks(next - now);
+    else checkDeleted();
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+    checkDeleted();
+    HostTask* task = self();
+    std::unique_lock<std::mutex> guard(task->lock);
+    auto ready = [task] { return task->notified > 0 || task->deleted.load(); };
+    if(ticks == portMAX_DELAY) task->wake.wait(guard, ready);
+    else task->wake.wait_for(guard, std::chrono::milliseconds(ticks), ready);
+    uint32_t value = task->notified;
+    if(value) task->notified = clearOnExit ? 0 : value - 1;
+    guard.unlock();
+    checkDeleted();
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    std::lock_guard<std::mutex> guard(task->lock);
+    task->notified++;
+    task->wake.notify_all();
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken) {
+    xTaskNotifyGive(task);
+    if(woken) *woken = pdTRUE;
+}
+
+//------------------------------------------------------------------------------
+// Wire
+
+namespace {
+I2cDeviceModel* devices[128];
+std::mutex busLock;
+}
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) { (void)sda; (void)scl; (void)frequency; return true; }
+bool TwoWire::end() { return true; }
+
+void TwoWire::attach(uint8_t address, I2cDeviceModel* model) {
+    if(address < 128) devices[address] = model;
+}
+
+void TwoWire::beginTransmission(uint8_t addr) {
+    address = addr;
+    txLength = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if(txLength >= sizeof(txBuffer)) return 0;
+    txBuffer[txLength++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t length) {
+    size_t written = 0;
+    while(written < length && write(data[written])) ++written;
+    return written;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    (void)sendStop;
+    std::lock_guard<std::mutex> guard(busLock);
+    I2cDeviceModel* device = address < 128 ? devices[address] : nullptr;
+    if(!device) return 2;   // NACK on address
+    if(txLength) device->write(txBuffer, txLength);
+    return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t addr, uint8_t length, bool sendStop) {
+    (void)sendStop;
+    std::lock_guard<std::mutex> guard(busLock);
+    rxLength = rxIndex = 0;
+    I2cDeviceModel* device = addr < 128 ? devices[addr] : nullptr;
+    if(!device) return 0;
+    if(length > sizeof(rxBuffer)) length = sizeof(rxBuffer);
+    device->read(rxBuffer, length);
+    rxLength = length;
+    return length;
+}
+
+int TwoWire::available() { return (int)(rxLength - rxIndex); }
+
+int TwoWire::read() { return rxIndex < rxLength ? rxBuffer[rxIndex++] : -1; }
+
+//------------------------------------------------------------------------------
+// Device models
+
+namespace host {
+
+namespace {
+const uint32_t conversionUs[] = { 125000, 62500, 31250, 15625, 7813, 4000, 2106, 1163 };
+const float lsbMillivolts[] = { 0.1875f, 0.125f, 0.0625f, 0.03125f, 0.015625f, 0.0078125f, 0.0078125f, 0.0078125f };
+// VMeter input divider, same figure the sketch divides by
+const float vmeterCoefficient = 0.015918958f;
+}
+
+int16_t Ads1115Model::sample() const {
+    // the vmeter feeds the ADC inverted, the library multiplies by MEASURING_DIRECTION
+    float raw = -input * 1000.0f * vmeterCoefficient / lsbMillivolts[(config >> 9) & 7];
+    if(raw > 32767.0f) raw = 32767.0f;
+    if(raw < -32768.0f) raw = -32768.0f;
+    return (int16_t)lrintf(raw);
+}
+
+void Ads1115Model::update() {
+    uint64_t now = nowNs();
+    uint64_t period = conversionUs[(config >> 5) & 7] * 1000ULL;
+    if(config & 0x0100) {
+        // single shot: OS reads 0 until the conversion is done
+        if(readyAt && now >= readyAt) {
+            conversion = sample();
+            readyAt = 0;
+            config |= 0x8000;
+            ++converted;
+        }
+    } else if(now - lastContinuous >= period) {
+        conversion = sample();
+        lastContinuous = now;
+        ++converted;
+    }
+}
+
+void Ads1115Model::write(const uint8_t* data, size_t length) {
+    pointer = data[0] & 3;
+    if(length < 3) return;
+    uint16_t value = (data[1] << 8) | data[2];
+    update();
+    switch(pointer) {
+        case 0: break;
+        case 1:
+            if((value & 0x0100) && (value & 0x8000)) {
+                readyAt = nowNs() + conversionUs[(value >> 5) & 7] * 1000ULL + 25000;
+                config = value & 0x7FFF;
+            } else {
+                config = (value & 0x7FFF) | (config & 0x8000);
+                lastContinuous = nowNs();
+            }
+            break;
+        case 2: loThresh = value; break;
+        case 3: hiThresh = value; break;
+    }
+}
+
+void Ads1115Model::read(uint8_t* data, size_t length) {
+    update();
+    uint16_t value = 0;
+    switch(pointer) {
+        case 0: value = (uint16_t)conversion; break;
+        case 1: value = config; break;
+        case 2: value = loThresh; break;
+        case 3: value = hiThresh; break;
+    }
+    for(size_t i = 0; i < length; ++i) data[i] = i == 0 ? value >> 8 : i == 1 ? value & 0xFF : 0xFF;
+}
+
+EepromModel::EepromModel() {
+    memset(memory, 0xFF, sizeof(memory));
+    // factory calibration records as ADS1115::saveCalibration writes them, hope == actual
+    for(uint8_t gain = 0; gain < 6; ++gain) {
+        uint8_t* record = &memory[0xd0 + gain * 8];
+        memset(record, 0, 8);
+        record[0] = gain;
+        record[1] = 1000 >> 8;
+        record[2] = 1000 & 0xFF;
+        record[3] = 1000 >> 8;
+        record[4] = 1000 & 0xFF;
+        for(uint8_t i = 0; i < 5; ++i) record[5] ^= record[i];
+    }
+}
+
+void EepromModel::write(const uint8_t* data, size_t length) {
+    pointer = data[0];
+    for(size_t i = 1; i < length; ++i) memory[pointer++] = data[i];
+}
+
+void EepromModel::read(uint8_t* data, size_t length) {
+    for(size_t i = 0; i < length; ++i) data[i] = memory[pointer++];
+}
+
+} // namespace host
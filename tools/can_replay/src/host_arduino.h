@@ -0,0 +1,60 @@
+// Host side of the Arduino / FreeRTOS shims: clock, I2C device models and task control.
+#ifndef CAN_REPLAY_HOST_ARDUINO_H
+#define CAN_REPLAY_HOST_ARDUINO_H
+
+#include <stdint.h>
+
+#include "Wire.h"
+
+namespace host {
+
+// Monotonic nanoseconds since the process started, the same clock millis() uses
+uint64_t nowNs();
+
+// Stop every task created through xTaskCreate*, used at shutdown
+void stopTasks();
+
+// Blocking driver calls poll this so a deleted task unwinds there
+void checkTaskDeleted();
+
+// M5 Unit VMeter: ADS1115 at 0x49, its calibration EEPROM at 0x53
+class Ads1115Model : public I2cDeviceModel {
+ public:
+    // Voltage at the vmeter input
+    void setInput(float volts) { input = volts; }
+
+    void write(const uint8_t* data, size_t length) override;
+    void read(uint8_t* data, size_t length) override;
+
+    uint32_t conversions() const { return converted; }
+
+ private:
+    int16_t sample() const;
+    void update();
+
+    float input = 1.0f;
+    uint8_t pointer = 0;
+    uint16_t config = 0x8583;       // power on default
+    uint16_t loThresh = 0x8000;
+    uint16_t hiThresh = 0x7FFF;
+    int16_t conversion = 0;
+    uint64_t readyAt = 0;           // ns, 0 = idle
+    uint64_t lastContinuous = 0;
+    uint32_t converted = 0;
+};
+
+class EepromModel : public I2cDeviceModel {
+ public:
+    EepromModel();
+
+    void write(const uint8_t* data, size_t length) override;
+    void read(uint8_t* data, size_t length) override;
+
+ private:
+    uint8_t memory[256];
+    uint8_t pointer = 0;
+};
+
+} // namespace host
+
+#endif
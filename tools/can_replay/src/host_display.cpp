@@ -0,0 +1,115 @@
+// M5GFX device setup for the host, replacing the board autodetect in M5GFX.cpp.
+// The sketch draws into an in-memory frame buffer panel (or an SDL window when SDL2 is
+// available) that counts the bus traffic of every write, and each screen update is matched
+// against the CAN frames that arrived before it started.
+#include "host_display.h"
+
+#include <M5GFX.h>
+
+#if defined (CAN_REPLAY_SDL)
+#include <lgfx/v1/platforms/sdl/Panel_sdl.hpp>
+#endif
+#include <lgfx/v1/panel/Panel_memory.hpp>
+
+#include "host_arduino.h"
+#include "twai_replay.h"
+
+namespace {
+
+host::DisplayStats counters;
+
+// Pixel and byte counts come from Panel_BusCounter, the same accounting Panel_memory
+// gives lgfx_bench; this only splits them into screen updates.
+template <typename Base>
+class HostPanelT : public Base {
+ public:
+    void beginTransaction(void) override {
+        Base::beginTransaction();
+        start = this->getBusStats();
+        // frames the sketch could have seen when this update started
+        visible = replay::stats().received;
+    }
+
+    void endTransaction(void) override {
+        Base::endTransaction();
+        const auto& stats = this->getBusStats();
+        uint64_t pixels = stats.pixels - start.pixels;
+        if(!pixels) return;
+        uint64_t now = host::nowNs();
+        uint32_t bytes = (uint32_t)(stats.bytes - start.bytes);
+        counters.updates++;
+        counters.pixels += pixels;
+        counters.bytes += bytes;
+        counters.bytesPerUpdate.push_back(bytes);
+
+        std::vector<uint64_t> arrivals;
+        replay::receivedTimes(attributed, arrivals);
+        size_t count = std::min(arrivals.size(), visible - attributed);
+        for(size_t i = 0; i < count; ++i) counters.latencyNs.push_back(now - arrivals[i]);
+        attributed += count;
+    }
+
+ private:
+    typename Base::bus_stats_t start;
+    size_t visible = 0;
+    size_t attributed = 0;
+};
+
+#if defined (CAN_REPLAY_SDL)
+typedef HostPanelT<lgfx::Panel_BusCounter<lgfx::Panel_sdl> > HostPanel;
+#else
+typedef HostPanelT<lgfx::Panel_memory> HostPanel;
+#endif
+
+} // namespace
+
+namespace host {
+
+DisplayStats displayStats() { return counters; }
+
+bool displayWindowed() {
+#if defined (CAN_REPLAY_SDL)
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace host
+
+namespace m5gfx
+{
+  M5GFX* M5GFX::_instance = nullptr;
+
+  M5GFX::M5GFX(void) : LGFX_Device()
+  {
+    if (_instance == nullptr) _instance = this;
+  }
+
+  bool M5GFX::init_impl(bool use_reset, bool use_clear)
+  {
+    _board = autodetect(use_reset, board_t::board_M5Paper);
+    return LGFX_Device::init_impl(use_reset, use_clear);
+  }
+
+  // The dashboard runs on an M5Paper, same geometry as the SDL branch of M5GFX.cpp
+  board_t M5GFX::autodetect(bool use_reset, board_t board)
+  {
+    (void)use_reset;
+    auto p = new HostPanel();
+    _panel_last.reset(p);
+    auto cfg = p->config();
+#if defined (CAN_REPLAY_SDL)
+    p->setWindowTitle("can_replay");
+#endif
+    cfg.memory_width = cfg.panel_width = 960;
+    cfg.memory_height = cfg.panel_height = 540;
+    cfg.offset_rotation = 3;
+    cfg.bus_shared = false;
+    p->config(cfg);
+    p->setColorDepth(lgfx::color_depth_t::grayscale_8bit);
+    p->setRotation(1);
+    panel(p);
+    return board;
+  }
+}
@@ -0,0 +1,28 @@
+// Display side of the harness: M5GFX on a counting host panel.
+#ifndef CAN_REPLAY_HOST_DISPLAY_H
+#define CAN_REPLAY_HOST_DISPLAY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <vector>
+
+namespace host {
+
+struct DisplayStats {
+    uint32_t updates;               // transactions that changed pixels
+    uint64_t pixels;
+    uint64_t bytes;                 // pixel and address window bytes a bus panel would be sent
+    std::vector<uint32_t> bytesPerUpdate;
+    std::vector<uint64_t> latencyNs; // CAN arrival to the end of the next screen update
+};
+
+// Copy of the counters, call from the sketch thread
+DisplayStats displayStats();
+
+// True if the harness was built against SDL2 and shows a window
+bool displayWindowed();
+
+} // namespace host
+
+#endif
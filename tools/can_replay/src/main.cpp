@@ -0,0 +1,167 @@
+// can_replay: plays a CAN log into the dashboard sketch and reports ingest rate,
+// frame-to-pixel latency and panel traffic.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "host_arduino.h"
+#include "host_display.h"
+#include "twai_replay.h"
+
+#if defined (CAN_REPLAY_SDL)
+#include <lgfx/v1/platforms/sdl/Panel_sdl.hpp>
+#endif
+
+void setup();
+void loop();
+double sketchDecodeRate(const twai_message_t* frames, size_t count, uint32_t minMs);
+
+namespace {
+
+struct Options {
+    std::string path;
+    replay::LogFormat format = replay::FORMAT_AUTO;
+    double speed = 1.0;
+    double synthetic = 0;
+    double duration = 0;        // stop after this many seconds of log, 0 = whole log
+    float vmeter = 1.5f;
+    uint32_t graceMs = 500;
+};
+
+Options options;
+std::vector<replay::LogFrame> frames;
+host::Ads1115Model ads;
+host::EepromModel eeprom;
+
+void usage() {
+    fprintf(stderr,
+            "usage: can_replay [options] <log>\n"
+            "       can_replay [options] --synthetic <seconds>\n"
+            "  --format candump|asc|csv  log format, default from the file extension\n"
+            "  --speed <n>               replay speed, 1 = real time, 0 = as fast as possible\n"
+            "  --duration <s>            only replay the first <s> seconds of the log\n"
+            "  --vmeter <volts>          oil pressure sender voltage seen by the ADS1115\n"
+            "  --grace <ms>              keep running after the last frame, default 500\n");
+}
+
+bool parseArgs(int argc, char** argv) {
+    for(int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if(arg == "--format" && hasValue) {
+            std::string f = argv[++i];
+            if(f == "candump") options.format = replay::FORMAT_CANDUMP;
+            else if(f == "asc") options.format = replay::FORMAT_ASC;
+            else if(f == "csv") options.format = replay::FORMAT_CSV;
+            else return false;
+        } else if(arg == "--speed" && hasValue) {
+            options.speed = atof(argv[++i]);
+        } else if(arg == "--synthetic" && hasValue) {
+            options.synthetic = atof(argv[++i]);
+        } else if(arg == "--duration" && hasValue) {
+            options.duration = atof(argv[++i]);
+        } else if(arg == "--vmeter" && hasValue) {
+            options.vmeter = atof(argv[++i]);
+        } else if(arg == "--grace" && hasValue) {
+            options.graceMs = atoi(argv[++i]);
+        } else if(arg[0] != '-' && options.path.empty()) {
+            options.path = arg;
+        } else {
+            return false;
+        }
+    }
+    return !options.path.empty() || options.synthetic > 0;
+}
+
+double percentile(std::vector<uint64_t> values, double p) {
+    if(values.empty()) return 0;
+    size_t index = std::min(values.size() - 1, (size_t)(p * (values.size() - 1) + 0.5));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+// Runs the sketch until the log is played out, returns the process exit code
+int run(bool* running) {
+    uint64_t startNs = host::nowNs();
+    setup();
+    uint64_t doneAt = 0;
+    while(!running || *running) {
+        loop();
+        if(!doneAt && replay::finished()) doneAt = host::nowNs();
+        if(doneAt && host::nowNs() - doneAt > options.graceMs * 1000000ULL) break;
+    }
+
+    double runSeconds = (host::nowNs() - startNs) / 1e9;
+    replay::Stats bus = replay::stats();
+    host::DisplayStats display = host::displayStats();
+    host::stopTasks();
+
+    std::vector<twai_message_t> messages;
+    for(const auto& frame : frames) messages.push_back(frame.message);
+    double decodeRate = sketchDecodeRate(messages.data(), messages.size(), 200);
+
+    double busSeconds = (bus.lastNs - bus.firstNs) / 1e9;
+    std::vector<uint64_t> bytes(display.bytesPerUpdate.begin(), display.bytesPerUpdate.end());
+    uint64_t maxBytes = bytes.empty() ? 0 : *std::max_element(bytes.begin(), bytes.end());
+
+    printf("log             %s (%zu frames, %.1f s)\n", options.path.empty() ? "synthetic" : options.path.c_str(),
+           frames.size(), frames.empty() ? 0 : frames.back().time);
+    if(options.speed > 0) printf("speed           %gx\n", options.speed);
+    else printf("speed           flood\n");
+    printf("bus             %u released, %u filtered, %u received, %u dropped, %u tx\n",
+           bus.released, bus.filtered, bus.received, bus.missed, bus.transmitted);
+    printf("ingest          %.0f frames/s received\n", busSeconds > 0 ? bus.received / busSeconds : 0.0);
+    printf("decode          %.0f frames/s (decoder only)\n", decodeRate);
+    printf("display         %u updates, %.0f updates/s\n", display.updates, display.updates / runSeconds);
+    printf("frame-to-pixel  p50 %.2f ms, p99 %.2f ms (%zu frames)\n",
+           percentile(display.latencyNs, 0.50) / 1e6, percentile(display.latencyNs, 0.99) / 1e6, display.latencyNs.size());
+    printf("panel bytes     %.0f per update (p50), %llu max, %llu total\n",
+           percentile(bytes, 0.50), (unsigned long long)maxBytes, (unsigned long long)display.bytes);
+    printf("vmeter          %u conversions\n", ads.conversions());
+    fflush(stdout);
+
+    return bus.received > 0 && display.updates > 0 ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if(!parseArgs(argc, argv)) {
+        usage();
+        return 2;
+    }
+
+    std::string error;
+    if(options.synthetic > 0) {
+        replay::synthesizeLog(options.synthetic, frames);
+    } else if(!replay::loadLog(options.path, options.format, frames, error)) {
+        fprintf(stderr, "can_replay: %s\n", error.c_str());
+        return 2;
+    }
+    if(options.duration > 0) {
+        auto end = std::find_if(frames.begin(), frames.end(),
+                                [](const replay::LogFrame& f) { return f.time > options.duration; });
+        frames.erase(end, frames.end());
+    }
+    replay::configure(frames, options.speed);
+
+    ads.setInput(options.vmeter);
+    TwoWire::attach(0x49, &ads);
+    TwoWire::attach(0x53, &eeprom);
+
+    int code;
+#if defined (CAN_REPLAY_SDL)
+    static int result = 1;
+    lgfx::Panel_sdl::main([](bool* running) -> int { return result = run(running); });
+    code = result;
+#else
+    code = run(nullptr);
+#endif
+    // sketch tasks never return, leave without unwinding them
+    _exit(code);
+}
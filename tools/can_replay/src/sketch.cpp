@@ -0,0 +1,22 @@
+// Builds the sketch under test (CAN_REPLAY_SKETCH, set by CMake) as a normal translation unit.
+#include <Arduino.h>
+
+#include CAN_REPLAY_SKETCH
+
+// Frames/s through a private copy of the sketch's signal table, no tasks or display involved
+double sketchDecodeRate(const CanFrame* frames, size_t count, uint32_t minMs) {
+    CanSignalDecoder<SIG_COUNT> decoder;
+    decoder.begin(g_signals);
+    volatile int32_t sink = 0;
+    size_t decoded = 0;
+    uint32_t start = micros();
+    uint64_t elapsed = 0;
+    do {
+        for(size_t i = 0; i < count; ++i) {
+            if(decoder.decode(frames[i]) > 0) sink = sink + decoder.valueInt(SIG_RPM);
+        }
+        decoded += count;
+        elapsed = (uint32_t)(micros() - start);
+    } while(elapsed < minMs * 1000ULL);
+    return elapsed ? decoded * 1e6 / elapsed : 0;
+}
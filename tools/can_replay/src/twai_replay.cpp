@@ -0,0 +1,494 @@
+// Log parsers and the replaying TWAI driver.
+// Frames are released onto the emulated bus at their log time (scaled by the replay speed),
+// go through the acceptance filter the sketch configured and queue up in an RX queue of the
+// configured depth. A full queue drops frames and counts rx_missed_count like the real driver.
+#include "twai_replay.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#include "host_arduino.h"
+
+namespace replay {
+
+//------------------------------------------------------------------------------
+// Log parsing
+
+namespace {
+
+bool parseHex(const std::string& text, uint32_t& value) {
+    if(text.empty()) return false;
+    char* end = nullptr;
+    unsigned long v = strtoul(text.c_str(), &end, 16);
+    if(*end != 0) return false;
+    value = (uint32_t)v;
+    return true;
+}
+
+bool parseNumber(const std::string& text, double& value) {
+    if(text.empty()) return false;
+    char* end = nullptr;
+    value = strtod(text.c_str(), &end);
+    return *end == 0;
+}
+
+std::vector<std::string> split(const std::string& line, char separator) {
+    std::vector<std::string> fields;
+    std::string field;
+    std::istringstream in(line);
+    if(separator == ' ') {
+        while(in >> field) fields.push_back(field);
+    } else {
+        while(std::getline(in, field, separator)) {
+            size_t a = field.find_first_not_of(" \t\r");
+            size_t b = field.find_last_not_of(" \t\r");
+            fields.push_back(a == std::string::npos ? std::string() : field.substr(a, b - a + 1));
+        }
+    }
+    return fields;
+}
+
+// "123", "18DAF110x", "0x7E8"; 'x' suffix or more than 3 digits means a 29 bit id
+bool parseId(std::string text, twai_message_t& message) {
+    bool extended = false;
+    if(text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) text = text.substr(2);
+    if(!text.empty() && (text.back() == 'x' || text.back() == 'X')) {
+        extended = true;
+        text.pop_back();
+    }
+    if(text.size() > 3) extended = true;
+    uint32_t id;
+    if(!parseHex(text, id)) return false;
+    message.extd = extended;
+    message.identifier = id & (extended ? 0x1FFFFFFF : 0x7FF);
+    return true;
+}
+
+bool parseCandump(const std::string& line, LogFrame& frame) {
+    std::vector<std::string> f = split(line, ' ');
+    if(f.size() < 3 || f[0].size() < 3 || f[0][0] != '(') return false;
+    double time;
+    if(!parseNumber(f[0].substr(1, f[0].size() - 2), time)) return false;
+    frame.time = time;
+
+    size_t hash = f[2].find('#');
+    if(hash != std::string::npos) {
+        // candump -l / -L: can0 123#DEADBEEF, 123#R
+        std::string data = f[2].substr(hash + 1);
+        if(!parseId(f[2].substr(0, hash), frame.message)) return false;
+        if(hash == 8) frame.message.extd = 1;
+        if(!data.empty() && (data[0] == 'R' || data[0] == 'r')) {
+            frame.message.rtr = 1;
+            frame.message.data_length_code = data.size() > 1 ? atoi(data.c_str() + 1) : 0;
+            return true;
+        }
+        if(data.size() & 1 || data.size() > 16) return false;
+        frame.message.data_length_code = data.size() / 2;
+        for(size_t i = 0; i < data.size() / 2; ++i) {
+            uint32_t b;
+            if(!parseHex(data.substr(i * 2, 2), b)) return false;
+            frame.message.data[i] = b;
+        }
+        return true;
+    }
+
+    // candump -ta: can0  123   [4]  DE AD BE EF
+    if(f.size() < 4 || f[3].size() < 3 || f[3][0] != '[') return false;
+    if(!parseId(f[2], frame.message)) return false;
+    if(f[2].size() == 8) frame.message.extd = 1;
+    frame.message.data_length_code = std::min(atoi(f[3].c_str() + 1), 8);
+    if(f.size() > 4 && f[4] == "remote") {
+        frame.message.rtr = 1;
+        return true;
+    }
+    for(size_t i = 0; i < frame.message.data_length_code; ++i) {
+        uint32_t b;
+        if(f.size() <= 4 + i || !parseHex(f[4 + i], b)) return false;
+        frame.message.data[i] = b;
+    }
+    return true;
+}
+
+// 0.010000 1  123  Rx  d 8 01 02 03 04 05 06 07 08 ...
+bool parseAsc(const std::string& line, LogFrame& frame) {
+    std::vector<std::string> f = split(line, ' ');
+    if(f.size() < 5) return false;
+    double time, channel;
+    if(!parseNumber(f[0], time) || !parseNumber(f[1], channel)) return false;
+    if(f[3] != "Rx" && f[3] != "Tx") return false;
+    if(!parseId(f[2], frame.message)) return false;
+    if(f[2].back() != 'x' && f[2].back() != 'X') frame.message.extd = 0;
+    frame.time = time;
+    if(f[4] == "r") {
+        frame.message.rtr = 1;
+        frame.message.data_length_code = f.size() > 5 ? std::min(atoi(f[5].c_str()), 8) : 0;
+        return true;
+    }
+    if(f[4] != "d" || f.size() < 6) return false;
+    frame.message.data_length_code = std::min(atoi(f[5].c_str()), 8);
+    for(size_t i = 0; i < frame.message.data_length_code; ++i) {
+        uint32_t b;
+        if(f.size() <= 6 + i || !parseHex(f[6 + i], b)) return false;
+        frame.message.data[i] = b;
+    }
+    return true;
+}
+
+// time,id,dlc,b0,...  ids are hex, 'x' suffix for extended
+bool parseCsv(const std::string& line, LogFrame& frame) {
+    std::vector<std::string> f = split(line, line.find(';') != std::string::npos ? ';' : ',');
+    if(f.size() < 3) return false;
+    double time;
+    if(!parseNumber(f[0], time)) return false;
+    if(!parseId(f[1], frame.message)) return false;
+    if(f[1].back() != 'x' && f[1].back() != 'X' && f[1].size() <= 5) frame.message.extd = frame.message.identifier > 0x7FF;
+    frame.time = time;
+    frame.message.data_length_code = std::min(atoi(f[2].c_str()), 8);
+    for(size_t i = 0; i < frame.message.data_length_code; ++i) {
+        uint32_t b;
+        if(f.size() <= 3 + i || !parseHex(f[3 + i], b)) return false;
+        frame.message.data[i] = b;
+    }
+    return true;
+}
+
+LogFormat guessFormat(const std::string& path) {
+    std::string ext = path.substr(path.find_last_of('.') == std::string::npos ? path.size() : path.find_last_of('.'));
+    for(char& c : ext) c = tolower(c);
+    if(ext == ".asc") return FORMAT_ASC;
+    if(ext == ".csv") return FORMAT_CSV;
+    return FORMAT_CANDUMP;
+}
+
+} // namespace
+
+bool loadLog(const std::string& path, LogFormat format, std::vector<LogFrame>& frames, std::string& error) {
+    std::ifstream in(path);
+    if(!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    if(format == FORMAT_AUTO) format = guessFormat(path);
+
+    frames.clear();
+    std::string line;
+    size_t skipped = 0;
+    while(std::getline(in, line)) {
+        if(line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        LogFrame frame;
+        memset(&frame, 0, sizeof(frame));
+        bool ok = false;
+        switch(format) {
+            case FORMAT_ASC: ok = parseAsc(line, frame); break;
+            case FORMAT_CSV: ok = parseCsv(line, frame); break;
+            default:         ok = parseCandump(line, frame); break;
+        }
+        // headers, comments and error frames
+        if(!ok) {
+            ++skipped;
+            continue;
+        }
+        frames.push_back(frame);
+    }
+    if(frames.empty()) {
+        error = "no CAN frames in " + path;
+        return false;
+    }
+
+    // rebase to the first frame and keep time monotonic
+    double start = frames.front().time;
+    double last = 0;
+    for(LogFrame& frame : frames) {
+        frame.time = std::max(frame.time - start, last);
+        last = frame.time;
+    }
+    (void)skipped;
+    return true;
+}
+
+void synthesizeLog(double seconds, std::vector<LogFrame>& frames) {
+    frames.clear();
+    // 0x360 temps at 20 Hz, 0x140 rpm at 100 Hz, two ids the filter should reject at 50 Hz
+    for(uint32_t tick = 0; tick < (uint32_t)(seconds * 100); ++tick) {
+        double t = tick / 100.0;
+        LogFrame frame;
+
+        memset(&frame, 0, sizeof(frame));
+        frame.time = t;
+        frame.message.identifier = 320;
+        frame.message.data_length_code = 8;
+        uint32_t rpm = 800 + (uint32_t)(3400 * (1 - cos(t * 0.7)));
+        frame.message.data[2] = rpm & 0xFF;
+        frame.message.data[3] = (rpm >> 8) & 0x1F;
+        frames.push_back(frame);
+
+        if(tick % 2 == 0) {
+            memset(&frame, 0, sizeof(frame));
+            frame.time = t + 0.002;
+            frame.message.identifier = tick % 4 ? 0x0D1 : 0x0D4;
+            frame.message.data_length_code = 8;
+            frame.message.data[0] = tick;
+            frames.push_back(frame);
+        }
+
+        if(tick % 5 == 0) {
+            memset(&frame, 0, sizeof(frame));
+            frame.time = t + 0.004;
+            frame.message.identifier = 864;
+            frame.message.data_length_code = 8;
+            frame.message.data[2] = 40 + 60 + (uint8_t)(t / 4) % 60;     // oil
+            frame.message.data[3] = 40 + 75 + (uint8_t)(t / 8) % 30;     // water
+            frames.push_back(frame);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Driver
+
+namespace {
+
+struct Pending {
+    uint64_t arrival;
+    twai_message_t message;
+};
+
+std::mutex lock;
+std::condition_variable wake;
+
+std::vector<LogFrame> frameLog;
+double speed = 1.0;
+size_t next = 0;
+uint64_t startNs = 0;
+bool running = false;
+
+std::deque<Pending> responses;  // OBD answers waiting for their bus time
+std::deque<Pending> rxQueue;
+size_t rxQueueLength = 5;
+
+twai_filter_config_t filter = TWAI_FILTER_CONFIG_ACCEPT_ALL();
+
+Stats counters;
+std::vector<uint64_t> arrivals;
+
+bool match(uint32_t value, uint32_t code, uint32_t mask) {
+    return ((value ^ code) & ~mask) == 0;
+}
+
+// SJA1000 style acceptance filter as the TWAI controller implements it
+bool accepted(const twai_message_t& m) {
+    uint32_t code = filter.acceptance_code;
+    uint32_t mask = filter.acceptance_mask;
+    uint32_t d0 = m.data_length_code > 0 && !m.rtr ? m.data[0] : 0;
+    uint32_t d1 = m.data_length_code > 1 && !m.rtr ? m.data[1] : 0;
+    if(filter.single_filter) {
+        if(m.extd) return match(m.identifier << 3 | m.rtr << 2, code, mask | 0x3);
+        // data bytes the frame doesn't carry don't take part
+        uint32_t ignore = 0x000F0000;
+        if(m.rtr || m.data_length_code < 1) ignore |= 0xFF00;
+        if(m.rtr || m.data_length_code < 2) ignore |= 0x00FF;
+        return match(m.identifier << 21 | m.rtr << 20 | d0 << 8 | d1, code, mask | ignore);
+    }
+    uint32_t code1 = code >> 16, mask1 = mask >> 16;
+    uint32_t code2 = code & 0xFFFF, mask2 = mask & 0xFFFF;
+    if(m.extd) {
+        uint32_t high = (m.identifier >> 13) & 0xFFFF;
+        return match(high, code1, mask1) || match(high, code2, mask2);
+    }
+    uint32_t head = m.identifier << 5 | m.rtr << 4;
+    uint32_t nibble = m.rtr || m.data_length_code < 1 ? 0xF : 0;
+    return match(head | d0 >> 4, code1, mask1 | nibble) || match(head, code2, mask2 | 0xF);
+}
+
+void deliver(const twai_message_t& message, uint64_t arrival) {
+    counters.released++;
+    if(!counters.firstNs) counters.firstNs = arrival;
+    counters.lastNs = arrival;
+    if(!accepted(message)) {
+        counters.filtered++;
+        return;
+    }
+    if(rxQueue.size() >= rxQueueLength) {
+        counters.missed++;
+        return;
+    }
+    rxQueue.push_back({ arrival, message });
+}
+
+uint64_t releaseTime(size_t index) {
+    return startNs + (uint64_t)(frameLog[index].time / speed * 1e9);
+}
+
+// Puts everything due by 'now' on the bus, returns the time of the next release (0 = none)
+uint64_t pump(uint64_t now) {
+    for(;;) {
+        bool haveLog = next < frameLog.size();
+        bool haveResponse = !responses.empty();
+        if(!haveLog && !haveResponse) return 0;
+
+        if(speed <= 0) {
+            // flood: keep the queue topped up, nothing is lost
+            if(rxQueue.size() >= rxQueueLength) return now + 1000000;
+            if(haveResponse) {
+                deliver(responses.front().message, now);
+                responses.pop_front();
+            } else {
+                deliver(frameLog[next++].message, now);
+            }
+            continue;
+        }
+
+        uint64_t logAt = haveLog ? releaseTime(next) : UINT64_MAX;
+        uint64_t responseAt = haveResponse ? responses.front().arrival : UINT64_MAX;
+        uint64_t at = std::min(logAt, responseAt);
+        if(at > now) return at;
+        if(responseAt <= logAt) {
+            deliver(responses.front().message, at);
+            responses.pop_front();
+        } else {
+            deliver(frameLog[next++].message, at);
+        }
+    }
+}
+
+// ECU on the other end of the OBD-II requests, answers mode 01 after 2 ms
+void respond(const twai_message_t& request) {
+    if(request.extd || (request.identifier != 0x7DF && request.identifier != 0x7E0)) return;
+    if(request.data_length_code < 3 || request.data[1] != 0x01) return;
+    uint8_t pid = request.data[2];
+    double t = (host::nowNs() - startNs) / 1e9;
+
+    Pending answer;
+    memset(&answer, 0, sizeof(answer));
+    answer.arrival = host::nowNs() + 2000000;
+    answer.message.identifier = 0x7E8;
+    answer.message.data_length_code = 8;
+    memset(answer.message.data, 0x55, 8);
+    answer.message.data[1] = 0x41;
+    answer.message.data[2] = pid;
+    if(pid == 0x0C) {
+        uint16_t rpm = 4 * (800 + (uint16_t)(1000 * (1 + sin(t))));
+        answer.message.data[0] = 4;
+        answer.message.data[3] = rpm >> 8;
+        answer.message.data[4] = rpm & 0xFF;
+    } else {
+        answer.message.data[0] = 3;
+        answer.message.data[3] = (uint8_t)(128 + 10 * sin(t * (pid + 1)));
+    }
+    responses.push_back(answer);
+}
+
+} // namespace
+
+void configure(const std::vector<LogFrame>& frames, double replaySpeed) {
+    std::lock_guard<std::mutex> guard(lock);
+    frameLog = frames;
+    speed = replaySpeed;
+    next = 0;
+}
+
+bool finished() {
+    std::lock_guard<std::mutex> guard(lock);
+    if(running) pump(host::nowNs());
+    return next >= frameLog.size();
+}
+
+Stats stats() {
+    std::lock_guard<std::mutex> guard(lock);
+    return counters;
+}
+
+size_t receivedTimes(size_t from, std::vector<uint64_t>& out) {
+    std::lock_guard<std::mutex> guard(lock);
+    out.clear();
+    if(from < arrivals.size()) out.assign(arrivals.begin() + from, arrivals.end());
+    return arrivals.size();
+}
+
+} // namespace replay
+
+using namespace replay;
+
+esp_err_t twai_driver_install(const twai_general_config_t* g_config, const twai_timing_config_t* t_config,
+                              const twai_filter_config_t* f_config) {
+    (void)t_config;
+    std::lock_guard<std::mutex> guard(lock);
+    rxQueueLength = g_config->rx_queue_len ? g_config->rx_queue_len : 1;
+    filter = *f_config;
+    rxQueue.clear();
+    return ESP_OK;
+}
+
+esp_err_t twai_driver_uninstall(void) {
+    std::lock_guard<std::mutex> guard(lock);
+    running = false;
+    rxQueue.clear();
+    return ESP_OK;
+}
+
+esp_err_t twai_start(void) {
+    std::lock_guard<std::mutex> guard(lock);
+    // the frameLog starts playing when the sketch brings the bus up
+    if(!running) startNs = host::nowNs();
+    running = true;
+    return ESP_OK;
+}
+
+esp_err_t twai_stop(void) {
+    std::lock_guard<std::mutex> guard(lock);
+    running = false;
+    return ESP_OK;
+}
+
+esp_err_t twai_transmit(const twai_message_t* message, TickType_t ticks_to_wait) {
+    (void)ticks_to_wait;
+    std::lock_guard<std::mutex> guard(lock);
+    if(!running) return ESP_ERR_INVALID_STATE;
+    counters.transmitted++;
+    respond(*message);
+    wake.notify_all();
+    return ESP_OK;
+}
+
+esp_err_t twai_receive(twai_message_t* message, TickType_t ticks_to_wait) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ticks_to_wait);
+    for(;;) {
+        host::checkTaskDeleted();
+        std::unique_lock<std::mutex> guard(lock);
+        if(!running) return ESP_ERR_INVALID_STATE;
+        uint64_t now = host::nowNs();
+        uint64_t nextAt = pump(now);
+        if(!rxQueue.empty()) {
+            *message = rxQueue.front().message;
+            arrivals.push_back(rxQueue.front().arrival);
+            rxQueue.pop_front();
+            counters.received++;
+            return ESP_OK;
+        }
+        if(ticks_to_wait == 0 || std::chrono::steady_clock::now() >= deadline) return ESP_ERR_TIMEOUT;
+        // sleep until the next release, the deadline, or a transmit that queues an answer
+        auto until = deadline;
+        if(nextAt) until = std::min(until, std::chrono::steady_clock::now() + std::chrono::nanoseconds(nextAt - now));
+        wake.wait_until(guard, until);
+    }
+}
+
+esp_err_t twai_get_status_info(twai_status_info_t* status_info) {
+    std::lock_guard<std::mutex> guard(lock);
+    if(running) pump(host::nowNs());
+    memset(status_info, 0, sizeof(*status_info));
+    status_info->state = running ? TWAI_STATE_RUNNING : TWAI_STATE_STOPPED;
+    status_info->msgs_to_rx = rxQueue.size();
+    status_info->rx_missed_count = counters.missed;
+    return ESP_OK;
+}
@@ -0,0 +1,57 @@
+// CAN log replay behind the TWAI driver API (shim/driver/twai.h).
+#ifndef CAN_REPLAY_TWAI_REPLAY_H
+#define CAN_REPLAY_TWAI_REPLAY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "driver/twai.h"
+
+namespace replay {
+
+struct LogFrame {
+    double time;            // seconds from the start of the log
+    twai_message_t message;
+};
+
+enum LogFormat {
+    FORMAT_AUTO,
+    FORMAT_CANDUMP,         // candump -l / -L and candump -ta
+    FORMAT_ASC,             // Vector ASCII
+    FORMAT_CSV,             // time,id,dlc,b0..b7 (ids in hex, 'x' suffix for extended)
+};
+
+// Parses a log, returns false if nothing could be read. Time is rebased to the first frame.
+bool loadLog(const std::string& path, LogFormat format, std::vector<LogFrame>& frames, std::string& error);
+
+// Two broadcast frames the dashboard decodes plus an OBD-II responder, 'seconds' long
+void synthesizeLog(double seconds, std::vector<LogFrame>& frames);
+
+// Replay setup, call before the sketch installs the driver.
+// speed: 1.0 = real time, N = N times faster, 0 = as fast as the reader drains the queue
+void configure(const std::vector<LogFrame>& frames, double speed);
+
+// True once every frame has been released onto the bus
+bool finished();
+
+struct Stats {
+    uint32_t released;      // frames put on the bus
+    uint32_t filtered;      // rejected by the acceptance filter
+    uint32_t received;      // taken by twai_receive
+    uint32_t missed;        // RX queue overflow
+    uint32_t transmitted;   // twai_transmit calls
+    uint64_t firstNs;       // host time of the first / last release
+    uint64_t lastNs;
+};
+Stats stats();
+
+// Bus arrival time (host ns) of every frame twai_receive handed out, in order.
+// Entries from 'from' onward are returned, the total count is the return value.
+size_t receivedTimes(size_t from, std::vector<uint64_t>& out);
+
+} // namespace replay
+
+#endif
@@ -0,0 +1,234 @@
+// lgfx_bench: runs scripted scenes through LGFXBase into a headless Panel_memory, hashes the
+// frame buffer after each scene and reports drawing throughput and the traffic an SPI panel
+// would have needed. No display, window or /dev/fb0 is used.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <M5GFX.h>
+#include <lgfx/v1/panel/Panel_memory.hpp>
+
+#include "scenes.h"
+
+namespace {
+
+struct Options {
+    uint16_t width = 320;
+    uint16_t height = 240;
+    double seconds = 0.1;
+    std::string check;
+    std::string write;
+    std::string filter;
+};
+
+class HeadlessDisplay : public lgfx::LGFX_Device {
+ public:
+    HeadlessDisplay(uint16_t width, uint16_t height) {
+        auto cfg = _panel_memory.config();
+        cfg.memory_width = cfg.panel_width = width;
+        cfg.memory_height = cfg.panel_height = height;
+        cfg.bus_shared = false;
+        _panel_memory.config(cfg);
+        setPanel(&_panel_memory);
+    }
+
+    lgfx::Panel_memory& memory() { return _panel_memory; }
+
+ private:
+    lgfx::Panel_memory _panel_memory;
+};
+
+struct DepthCase {
+    const char* name;
+    lgfx::color_depth_t depth;
+};
+
+const DepthCase depths[] = {
+    {"rgb565", lgfx::rgb565_2Byte},
+    {"rgb888", lgfx::rgb888_3Byte},
+    {"gray8", lgfx::grayscale_8bit},
+};
+
+uint64_t hash_frame(const lgfx::Panel_memory& panel, uint16_t height) {
+    uint64_t h = 0xcbf29ce484222325ull;   // FNV-1a
+    uint32_t bytes = panel.getLineBytes();
+    for (uint16_t y = 0; y < height; ++y) {
+        const uint8_t* line = panel.getLine(y);
+        for (uint32_t i = 0; i < bytes; ++i) {
+            h ^= line[i];
+            h *= 0x100000001b3ull;
+        }
+    }
+    return h;
+}
+
+std::vector<uint8_t> read_file(const char* path) {
+    std::vector<uint8_t> data;
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        fprintf(stderr, "warning: %s not found, the scene using it is skipped\n", path);
+        return data;
+    }
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) data.insert(data.end(), buf, buf + n);
+    fclose(fp);
+    return data;
+}
+
+std::map<std::string, std::string> read_hashes(const std::string& path, bool& ok) {
+    std::map<std::string, std::string> hashes;
+    FILE* fp = fopen(path.c_str(), "r");
+    ok = fp != nullptr;
+    if (!fp) return hashes;
+    char line[256];
+    while (fgets(line, sizeof(line), fp)) {
+        char depth[32], scene[64], hash[32];
+        if (line[0] == '#' || sscanf(line, "%31s %63s %31s", depth, scene, hash) != 3) continue;
+        hashes[std::string(depth) + " " + scene] = hash;
+    }
+    fclose(fp);
+    return hashes;
+}
+
+// Starts every scene from the same state, so its hash does not depend on the scenes before it.
+void reset(HeadlessDisplay& gfx, bench::Context& ctx, size_t index) {
+    gfx.clearClipRect();
+    gfx.fillScreen(0u);
+    gfx.setTextColor(0xFFFFFFu, 0u);
+    gfx.memory().resetBusStats();
+    ctx.rng = 0x9E3779B9u ^ (uint32_t)(index * 0x85EBCA6Bu);
+}
+
+void usage() {
+    fprintf(stderr,
+            "usage: lgfx_bench [--size WxH] [--time S] [--check FILE] [--write FILE] [filter]\n"
+            "  --size WxH    panel size (default 320x240)\n"
+            "  --time S      seconds per scene and color depth (default 0.1)\n"
+            "  --check FILE  compare the frame hash of every scene with FILE, no timing\n"
+            "  --write FILE  write the frame hashes to FILE, no timing\n"
+            "  filter        only scenes whose name contains this text\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        bool has_value = i + 1 < argc;
+        if (a == "--size" && has_value) {
+            unsigned w, h;
+            if (sscanf(argv[++i], "%ux%u", &w, &h) != 2 || !w || !h) { usage(); return 2; }
+            opt.width = w;
+            opt.height = h;
+        }
+        else if (a == "--time" && has_value) opt.seconds = atof(argv[++i]);
+        else if (a == "--check" && has_value) opt.check = argv[++i];
+        else if (a == "--write" && has_value) opt.write = argv[++i];
+        else if (a[0] != '-') opt.filter = a;
+        else { usage(); return 2; }
+    }
+    bool timing = opt.check.empty() && opt.write.empty();
+
+    bench::Assets assets;
+    assets.jpg = read_file(LGFX_BENCH_JPG);
+    assets.png = read_file(LGFX_BENCH_PNG);
+    assets.vlw = read_file(LGFX_BENCH_VLW);
+
+    std::map<std::string, std::string> expected;
+    if (!opt.check.empty()) {
+        bool ok;
+        expected = read_hashes(opt.check, ok);
+        if (!ok) {
+            perror(opt.check.c_str());
+            return 1;
+        }
+    }
+    FILE* out = nullptr;
+    if (!opt.write.empty() && !(out = fopen(opt.write.c_str(), "w"))) {
+        perror(opt.write.c_str());
+        return 1;
+    }
+    if (out) fprintf(out, "# lgfx_bench frame hashes, %ux%u. Regenerate with lgfx_bench --write\n", opt.width, opt.height);
+
+    if (timing) {
+        printf("%-8s %-15s %10s %10s %9s %12s %8s\n",
+               "depth", "scene", "us/scene", "calls/s", "Mpx/s", "bus B/scene", "windows");
+    }
+
+    int failed = 0;
+    int checked = 0;
+    for (const auto& d : depths) {
+        HeadlessDisplay gfx(opt.width, opt.height);
+        if (!gfx.init()) {
+            fprintf(stderr, "panel init failed\n");
+            return 1;
+        }
+        gfx.setColorDepth(d.depth);
+
+        LGFX_Sprite sprite(&gfx);
+        bench::Context ctx;
+        ctx.gfx = &gfx;
+        ctx.assets = &assets;
+        ctx.sprite = &sprite;
+        bench::prepare(ctx);
+
+        const auto& list = bench::scenes();
+        for (size_t i = 0; i < list.size(); ++i) {
+            const auto& scene = list[i];
+            if (!opt.filter.empty() && !strstr(scene.name, opt.filter.c_str())) continue;
+
+            reset(gfx, ctx, i);
+            uint32_t calls = scene.run(ctx);
+            auto stats = gfx.memory().getBusStats();
+            if (calls == 0) continue;   // asset missing
+
+            char hash[20];
+            snprintf(hash, sizeof(hash), "%016llx", (unsigned long long)hash_frame(gfx.memory(), opt.height));
+            std::string key = std::string(d.name) + " " + scene.name;
+            if (out) fprintf(out, "%-8s %-15s %s\n", d.name, scene.name, hash);
+            if (!opt.check.empty()) {
+                auto it = expected.find(key);
+                ++checked;
+                if (it == expected.end()) {
+                    printf("MISSING  %s\n", key.c_str());
+                    ++failed;
+                } else if (it->second != hash) {
+                    printf("MISMATCH %s: %s, expected %s\n", key.c_str(), hash, it->second.c_str());
+                    ++failed;
+                }
+            }
+            if (!timing) continue;
+
+            using clock = std::chrono::steady_clock;
+            uint32_t runs = 0;
+            uint64_t pixels = 0;
+            double elapsed = 0;
+            auto start = clock::now();
+            do {
+                reset(gfx, ctx, i);
+                auto t0 = clock::now();
+                scene.run(ctx);
+                auto t1 = clock::now();
+                // the reset fill is not part of the scene
+                elapsed += std::chrono::duration<double>(t1 - t0).count();
+                pixels += gfx.memory().getBusStats().pixels;
+                ++runs;
+            } while (std::chrono::duration<double>(clock::now() - start).count() < opt.seconds);
+            printf("%-8s %-15s %10.1f %10.0f %9.1f %12llu %8llu\n", d.name, scene.name,
+                   elapsed / runs * 1e6, calls * runs / elapsed, pixels / elapsed / 1e6,
+                   (unsigned long long)stats.bytes, (unsigned long long)stats.windows);
+        }
+        sprite.deleteSprite();
+    }
+
+    if (out) fclose(out);
+    if (!opt.check.empty()) printf("%d of %d frame hashes match\n", checked - failed, checked);
+    return failed ? 1 : 0;
+}
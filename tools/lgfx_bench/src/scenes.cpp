@@ -0,0 +1,353 @@
+// The scenes cover every LGFXBase primitive family and every font type the library ships.
+// Coordinates deliberately run past the screen edges so the clipping paths are exercised.
+#include "scenes.h"
+
+namespace bench {
+
+namespace {
+
+int32_t W(Context& ctx) { return ctx.gfx->width(); }
+int32_t H(Context& ctx) { return ctx.gfx->height(); }
+int32_t rx(Context& ctx) { return ctx.range(-20, W(ctx) + 20); }
+int32_t ry(Context& ctx) { return ctx.range(-20, H(ctx) + 20); }
+
+uint32_t fill_screen(Context& ctx) {
+    for (int i = 0; i < 4; ++i) ctx.gfx->fillScreen(ctx.color());
+    return 4;
+}
+
+uint32_t fill_rect(Context& ctx) {
+    for (int i = 0; i < 100; ++i) ctx.gfx->fillRect(rx(ctx), ry(ctx), ctx.range(1, 80), ctx.range(1, 80), ctx.color());
+    return 100;
+}
+
+uint32_t draw_rect(Context& ctx) {
+    for (int i = 0; i < 100; ++i) ctx.gfx->drawRect(rx(ctx), ry(ctx), ctx.range(1, 120), ctx.range(1, 120), ctx.color());
+    return 100;
+}
+
+uint32_t fast_lines(Context& ctx) {
+    for (int i = 0; i < 100; ++i) {
+        ctx.gfx->drawFastHLine(rx(ctx), ry(ctx), ctx.range(1, W(ctx)), ctx.color());
+        ctx.gfx->drawFastVLine(rx(ctx), ry(ctx), ctx.range(1, H(ctx)), ctx.color());
+    }
+    return 200;
+}
+
+uint32_t lines(Context& ctx) {
+    for (int i = 0; i < 100; ++i) ctx.gfx->drawLine(rx(ctx), ry(ctx), rx(ctx), ry(ctx), ctx.color());
+    return 100;
+}
+
+uint32_t pixels(Context& ctx) {
+    for (int i = 0; i < 2000; ++i) ctx.gfx->drawPixel(rx(ctx), ry(ctx), ctx.color());
+    return 2000;
+}
+
+uint32_t circles(Context& ctx) {
+    for (int i = 0; i < 20; ++i) {
+        ctx.gfx->fillCircle(rx(ctx), ry(ctx), ctx.range(1, 60), ctx.color());
+        ctx.gfx->drawCircle(rx(ctx), ry(ctx), ctx.range(1, 60), ctx.color());
+    }
+    return 40;
+}
+
+uint32_t ellipses(Context& ctx) {
+    for (int i = 0; i < 20; ++i) {
+        ctx.gfx->fillEllipse(rx(ctx), ry(ctx), ctx.range(1, 70), ctx.range(1, 40), ctx.color());
+        ctx.gfx->drawEllipse(rx(ctx), ry(ctx), ctx.range(1, 70), ctx.range(1, 40), ctx.color());
+    }
+    return 40;
+}
+
+uint32_t triangles(Context& ctx) {
+    for (int i = 0; i < 20; ++i) {
+        ctx.gfx->fillTriangle(rx(ctx), ry(ctx), rx(ctx), ry(ctx), rx(ctx), ry(ctx), ctx.color());
+        ctx.gfx->drawTriangle(rx(ctx), ry(ctx), rx(ctx), ry(ctx), rx(ctx), ry(ctx), ctx.color());
+    }
+    return 40;
+}
+
+uint32_t round_rects(Context& ctx) {
+    for (int i = 0; i < 20; ++i) {
+        ctx.gfx->fillRoundRect(rx(ctx), ry(ctx), ctx.range(8, 100), ctx.range(8, 80), ctx.range(1, 12), ctx.color());
+        ctx.gfx->drawRoundRect(rx(ctx), ry(ctx), ctx.range(8, 100), ctx.range(8, 80), ctx.range(1, 12), ctx.color());
+    }
+    return 40;
+}
+
+uint32_t arcs(Context& ctx) {
+    for (int i = 0; i < 20; ++i) {
+        int32_t r = ctx.range(10, 70);
+        ctx.gfx->fillArc(rx(ctx), ry(ctx), r, r - ctx.range(2, 10), ctx.range(0, 360), ctx.range(0, 360), ctx.color());
+        ctx.gfx->drawArc(rx(ctx), ry(ctx), r, r - ctx.range(2, 10), ctx.range(0, 360), ctx.range(0, 360), ctx.color());
+    }
+    return 40;
+}
+
+uint32_t beziers(Context& ctx) {
+    for (int i = 0; i < 20; ++i) {
+        ctx.gfx->drawBezier(rx(ctx), ry(ctx), rx(ctx), ry(ctx), rx(ctx), ry(ctx), ctx.color());
+        ctx.gfx->drawBezier(rx(ctx), ry(ctx), rx(ctx), ry(ctx), rx(ctx), ry(ctx), rx(ctx), ry(ctx), ctx.color());
+    }
+    return 40;
+}
+
+uint32_t smooth(Context& ctx) {
+    for (int i = 0; i < 10; ++i) {
+        ctx.gfx->drawWideLine(rx(ctx), ry(ctx), rx(ctx), ry(ctx), ctx.range(1, 8), ctx.color());
+        ctx.gfx->drawWedgeLine(rx(ctx), ry(ctx), rx(ctx), ry(ctx), ctx.range(1, 4), ctx.range(4, 12), ctx.color());
+        ctx.gfx->fillSmoothCircle(rx(ctx), ry(ctx), ctx.range(2, 40), ctx.color());
+        ctx.gfx->fillSmoothRoundRect(rx(ctx), ry(ctx), ctx.range(10, 90), ctx.range(10, 60), ctx.range(2, 10), ctx.color());
+    }
+    return 40;
+}
+
+uint32_t gradients(Context& ctx) {
+    for (int i = 0; i < 8; ++i) {
+        ctx.gfx->fillGradientRect(rx(ctx), ry(ctx), ctx.range(10, 120), ctx.range(10, 80), ctx.color(), ctx.color(),
+                                  (lgfx::fill_style_t)(i % 3));
+        ctx.gfx->drawGradientLine(rx(ctx), ry(ctx), rx(ctx), ry(ctx), ctx.color(), ctx.color());
+    }
+    return 16;
+}
+
+uint32_t bitmaps(Context& ctx) {
+    int32_t s = Context::image_size;
+    for (int i = 0; i < 20; ++i) {
+        ctx.gfx->drawBitmap(rx(ctx), ry(ctx), ctx.bitmap.data(), s, s, ctx.color());
+        ctx.gfx->drawBitmap(rx(ctx), ry(ctx), ctx.bitmap.data(), s, s, ctx.color(), ctx.color());
+    }
+    return 40;
+}
+
+uint32_t push_image(Context& ctx) {
+    int32_t s = Context::image_size;
+    for (int i = 0; i < 20; ++i) ctx.gfx->pushImage(rx(ctx), ry(ctx), s, s, ctx.image16.data());
+    for (int i = 0; i < 10; ++i) ctx.gfx->pushImage(rx(ctx), ry(ctx), s, s, ctx.image16.data(), ctx.image16[0]);
+    return 30;
+}
+
+uint32_t push_alpha(Context& ctx) {
+    int32_t s = Context::image_size;
+    for (int i = 0; i < 20; ++i) ctx.gfx->pushAlphaImage(rx(ctx), ry(ctx), s, s, ctx.image32.data());
+    return 20;
+}
+
+uint32_t rotate_zoom(Context& ctx) {
+    int32_t s = Context::image_size;
+    for (int i = 0; i < 5; ++i) {
+        float angle = ctx.range(0, 360);
+        float zoom = ctx.range(5, 30) / 10.0f;
+        ctx.gfx->pushImageRotateZoom(rx(ctx), ry(ctx), s / 2, s / 2, angle, zoom, zoom, s, s, ctx.image16.data());
+        ctx.gfx->pushImageRotateZoomWithAA(rx(ctx), ry(ctx), s / 2, s / 2, angle, zoom, zoom, s, s, ctx.image16.data());
+    }
+    return 10;
+}
+
+uint32_t sprites(Context& ctx) {
+    for (int i = 0; i < 10; ++i) {
+        ctx.sprite->pushSprite(rx(ctx), ry(ctx));
+        ctx.sprite->pushSprite(rx(ctx), ry(ctx), 0u);
+    }
+    for (int i = 0; i < 4; ++i) {
+        float zoom = ctx.range(5, 25) / 10.0f;
+        ctx.sprite->pushRotateZoom(rx(ctx), ry(ctx), ctx.range(0, 360), zoom, zoom);
+        ctx.sprite->pushRotateZoomWithAA(rx(ctx), ry(ctx), ctx.range(0, 360), zoom, zoom);
+    }
+    return 28;
+}
+
+uint32_t copy_scroll(Context& ctx) {
+    for (int i = 0; i < 10; ++i) {
+        ctx.gfx->copyRect(ctx.range(0, W(ctx) / 2), ctx.range(0, H(ctx) / 2), W(ctx) / 2, H(ctx) / 2,
+                          ctx.range(0, W(ctx) / 2), ctx.range(0, H(ctx) / 2));
+    }
+    ctx.gfx->setScrollRect(10, 10, W(ctx) - 20, H(ctx) - 20);
+    ctx.gfx->setBaseColor(ctx.color());
+    for (int i = 0; i < 10; ++i) ctx.gfx->scroll(ctx.range(-8, 8), ctx.range(-8, 8));
+    ctx.gfx->clearScrollRect();
+    return 20;
+}
+
+// A gauge: static face, a keyed needle layer and an alpha blended label, updated per frame.
+uint32_t compositor(Context& ctx) {
+    LGFX_Compositor comp(ctx.gfx);
+    comp.setBackgroundColor(0x102030u);
+    auto face = comp.createLayer(W(ctx) / 8, H(ctx) / 8, W(ctx) * 3 / 4, H(ctx) * 3 / 4, lgfx::rgb565_2Byte, 0);
+    auto needle = comp.createLayer(W(ctx) / 4, H(ctx) / 4, W(ctx) / 2, H(ctx) / 2, lgfx::rgb565_2Byte, 1);
+    auto label = comp.createLayer(0, 0, 96, 24, lgfx::argb8888_4Byte, 2);
+    face->fillSprite(0x404040u);
+    for (int i = 0; i < 12; ++i) face->fillCircle(ctx.range(0, face->width()), ctx.range(0, face->height()), 8, ctx.color());
+    needle->setTransparentColor(0u);
+    label->setAlphaBlend();
+    label->setTextColor(0xFFFFFFu);
+    comp.present();
+
+    int32_t cx = needle->width() / 2;
+    int32_t cy = needle->height() / 2;
+    for (int i = 0; i < 16; ++i) {
+        needle->fillSprite(0u);
+        needle->drawWedgeLine(cx, cy, ctx.range(0, cx * 2), ctx.range(0, cy * 2), 4, 1, ctx.color());
+        label->fillSprite(lgfx::argb8888_t(0x80000000u));
+        label->drawNumber(i, 4, 4);
+        label->setPosition(ctx.range(-24, W(ctx) - 48), ctx.range(-8, H(ctx) - 16));
+        comp.present();
+    }
+    return 17;
+}
+
+// A full screen redraw every frame through the deferred tile canvas: a static face of many
+// ops and one moving marker, so most tiles are unchanged and each dirty one sees a busy list.
+uint32_t tile_canvas(Context& ctx) {
+    LGFX_TileCanvas canvas(ctx.gfx);
+    canvas.setColorDepth(ctx.gfx->getColorDepth());
+    if (!canvas.createCanvas(W(ctx), H(ctx), 64 * 1024)) return 0;
+
+    int32_t face[48][5];
+    for (auto& f : face) {
+        f[0] = rx(ctx); f[1] = ry(ctx); f[2] = ctx.range(4, 60); f[3] = ctx.range(4, 60); f[4] = ctx.color();
+    }
+    uint32_t frames = 0;
+    for (int i = 0; i < 8; ++i) {
+        canvas.clearList();
+        canvas.fillScreen(0x202020u);
+        for (auto& f : face) canvas.fillRect(f[0], f[1], f[2], f[3], f[4]);
+        canvas.fillCircle(ctx.range(0, W(ctx)), ctx.range(0, H(ctx)), 10, ctx.color());
+        canvas.drawNumber(i, 4, 4);
+        if (canvas.pushCanvas(0, 0)) ++frames;
+    }
+    return frames;
+}
+
+uint32_t flood_fill(Context& ctx) {
+    ctx.gfx->fillScreen(0u);
+    for (int i = 0; i < 12; ++i) ctx.gfx->drawCircle(rx(ctx), ry(ctx), ctx.range(10, 80), 0xFFFFFFu);
+    for (int i = 0; i < 4; ++i) ctx.gfx->floodFill(ctx.range(0, W(ctx)), ctx.range(0, H(ctx)), ctx.color());
+    return 17;
+}
+
+uint32_t decode_jpg(Context& ctx) {
+    const auto& jpg = ctx.assets->jpg;
+    if (jpg.empty()) return 0;
+    ctx.gfx->drawJpg(jpg.data(), jpg.size(), 0, 0);
+    ctx.gfx->drawJpg(jpg.data(), jpg.size(), W(ctx) / 2, H(ctx) / 3, 0, 0, 0, 0, 0.5f);
+    return 2;
+}
+
+uint32_t decode_png(Context& ctx) {
+    const auto& png = ctx.assets->png;
+    if (png.empty()) return 0;
+    for (int i = 0; i < 4; ++i) ctx.gfx->drawPng(png.data(), png.size(), rx(ctx), ry(ctx));
+    return 4;
+}
+
+uint32_t qrcode(Context& ctx) {
+    ctx.gfx->qrcode("https://github.com/m5stack/M5GFX", ctx.range(0, 40), ctx.range(0, 40), 160, 3);
+    return 1;
+}
+
+uint32_t draw_text(Context& ctx, const lgfx::IFont* font, float size) {
+    auto gfx = ctx.gfx;
+    gfx->setFont(font);
+    gfx->setTextSize(size);
+    static const char* const strings[] = {"0123456789", "-12.5 km/h", "The quick brown fox", "88:88"};
+    uint32_t ops = 0;
+    for (auto str : strings) {
+        gfx->setTextColor(ctx.color(), ctx.color());
+        gfx->setTextDatum((lgfx::textdatum_t)(ops % 3 | (ops % 4) << 2));
+        gfx->drawString(str, rx(ctx), ry(ctx));
+        gfx->setTextColor(ctx.color());
+        gfx->drawString(str, rx(ctx), ry(ctx));
+        ops += 2;
+    }
+    gfx->setTextDatum(lgfx::top_left);
+    gfx->setTextSize(1);
+    gfx->setFont(&fonts::Font0);
+    return ops;
+}
+
+uint32_t font_glcd(Context& ctx) { return draw_text(ctx, &fonts::Font0, 2); }
+uint32_t font_bmp(Context& ctx) { return draw_text(ctx, &fonts::Font2, 1); }
+uint32_t font_rle(Context& ctx) { return draw_text(ctx, &fonts::Font4, 1) + draw_text(ctx, &fonts::Font7, 1); }
+uint32_t font_fixed(Context& ctx) { return draw_text(ctx, &fonts::AsciiFont8x16, 1); }
+uint32_t font_gfx(Context& ctx) { return draw_text(ctx, &fonts::DejaVu18, 1) + draw_text(ctx, &fonts::DejaVu72, 1); }
+uint32_t font_gfx_scaled(Context& ctx) { return draw_text(ctx, &fonts::DejaVu24, 1.5f); }
+
+uint32_t font_vlw(Context& ctx) {
+    const auto& vlw = ctx.assets->vlw;
+    if (vlw.empty() || !ctx.gfx->loadFont(vlw.data())) return 0;
+    uint32_t ops = draw_text(ctx, ctx.gfx->getFont(), 1);
+    ctx.gfx->unloadFont();
+    return ops;
+}
+
+} // namespace
+
+void prepare(Context& ctx) {
+    int32_t s = Context::image_size;
+    ctx.image16.resize(s * s);
+    ctx.image32.resize(s * s);
+    ctx.bitmap.assign((s + 7) / 8 * s, 0);
+    for (int32_t y = 0; y < s; ++y) {
+        for (int32_t x = 0; x < s; ++x) {
+            uint8_t r = x * 255 / s, g = y * 255 / s, b = ((x ^ y) & 8) ? 255 : 0;
+            ctx.image16[y * s + x].set(r, g, b);
+            int32_t dx = x - s / 2, dy = y - s / 2;
+            int32_t a = 255 - (dx * dx + dy * dy) * 255 / (s * s / 4);
+            ctx.image32[y * s + x].set(std::max(0, std::min(255, a)), r, g, b);
+            if ((dx * dx + dy * dy) < s * s / 5 && ((x + y) % 5)) ctx.bitmap[y * ((s + 7) / 8) + x / 8] |= 0x80 >> (x & 7);
+        }
+    }
+
+    auto spr = ctx.sprite;
+    spr->setColorDepth(ctx.gfx->getColorDepth());
+    spr->createSprite(64, 40);
+    spr->fillSprite(0u);
+    spr->fillCircle(32, 20, 18, 0xFF8000u);
+    spr->drawRect(0, 0, 64, 40, 0x00FF00u);
+    spr->setTextColor(0xFFFFFFu);
+    spr->drawString("SPR", 20, 16);
+    spr->setPivot(32, 20);
+}
+
+const std::vector<Scene>& scenes() {
+    static const std::vector<Scene> list = {
+        {"fillScreen", fill_screen},
+        {"fillRect", fill_rect},
+        {"drawRect", draw_rect},
+        {"fastHVLine", fast_lines},
+        {"drawLine", lines},
+        {"drawPixel", pixels},
+        {"circle", circles},
+        {"ellipse", ellipses},
+        {"triangle", triangles},
+        {"roundRect", round_rects},
+        {"arc", arcs},
+        {"bezier", beziers},
+        {"smoothAA", smooth},
+        {"gradient", gradients},
+        {"drawBitmap", bitmaps},
+        {"pushImage", push_image},
+        {"pushAlphaImage", push_alpha},
+        {"rotateZoom", rotate_zoom},
+        {"pushSprite", sprites},
+        {"copyScroll", copy_scroll},
+        {"floodFill", flood_fill},
+        {"drawJpg", decode_jpg},
+        {"drawPng", decode_png},
+        {"qrcode", qrcode},
+        {"fontGLCD", font_glcd},
+        {"fontBMP", font_bmp},
+        {"fontRLE", font_rle},
+        {"fontFixedBMP", font_fixed},
+        {"fontGFX", font_gfx},
+        {"fontGFXscaled", font_gfx_scaled},
+        {"fontVLW", font_vlw},
+        {"compositor", compositor},
+        {"tileCanvas", tile_canvas},
+    };
+    return list;
+}
+
+} // namespace bench
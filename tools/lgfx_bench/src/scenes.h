@@ -0,0 +1,50 @@
+// Scripted drawing scenes for lgfx_bench. Every scene draws the same pixels for the same seed.
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <M5GFX.h>
+
+namespace bench {
+
+struct Assets {
+    std::vector<uint8_t> jpg;
+    std::vector<uint8_t> png;
+    std::vector<uint8_t> vlw;
+};
+
+struct Context {
+    lgfx::LGFX_Device* gfx = nullptr;
+    const Assets* assets = nullptr;
+    LGFX_Sprite* sprite = nullptr;
+    std::vector<lgfx::swap565_t> image16;    // image_size x image_size
+    std::vector<lgfx::argb8888_t> image32;   // image_size x image_size, alpha 0 to 255
+    std::vector<uint8_t> bitmap;             // image_size x image_size, 1 bit
+    uint32_t rng = 1;
+
+    static constexpr int32_t image_size = 48;
+
+    uint32_t next() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    }
+    int32_t range(int32_t lo, int32_t hi) { return lo + (int32_t)(next() % (uint32_t)(hi - lo)); }
+    uint32_t color() { return next() & 0xFFFFFF; }
+};
+
+// Fills the images and the sprite; the sprite is drawn for the display's color depth.
+void prepare(Context& ctx);
+
+struct Scene {
+    const char* name;
+    uint32_t (*run)(Context& ctx);   // returns the number of drawing calls
+};
+
+const std::vector<Scene>& scenes();
+
+} // namespace bench
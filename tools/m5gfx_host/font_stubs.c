@@ -0,0 +1,145 @@
+/* Stand-ins for the efont and IPA tables of M5GFX, which are not part of
+ * this tree.
+ *
+ * Each one is a valid u8g2 font without glyphs: the ASCII list and the
+ * unicode lookup table are both empty, so U8g2font::getGlyph() returns
+ * nullptr and text drawn with them is blank.
+ */
+
+#include <stdint.h>
+
+#define FONT_STUB(name)                                                     \
+  const uint8_t name[] = {                                                  \
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, /* header */         \
+    0, 0, 0, 0, /* start of 'A' and 'a': the empty ASCII list */            \
+    0, 2,       /* start of the unicode lookup table */                     \
+    0, 0,       /* ASCII list: end */                                       \
+    0, 4, 0xFF, 0xFF, /* unicode lookup: skip 4 bytes, up to U+FFFF */      \
+    0, 0,       /* unicode glyphs: end */                                   \
+  };
+
+/* efont/lgfx_efont_cn.h */
+FONT_STUB(lgfx_efont_cn_10)
+FONT_STUB(lgfx_efont_cn_10_b)
+FONT_STUB(lgfx_efont_cn_10_bi)
+FONT_STUB(lgfx_efont_cn_10_i)
+FONT_STUB(lgfx_efont_cn_12)
+FONT_STUB(lgfx_efont_cn_12_b)
+FONT_STUB(lgfx_efont_cn_12_bi)
+FONT_STUB(lgfx_efont_cn_12_i)
+FONT_STUB(lgfx_efont_cn_14)
+FONT_STUB(lgfx_efont_cn_14_b)
+FONT_STUB(lgfx_efont_cn_14_bi)
+FONT_STUB(lgfx_efont_cn_14_i)
+FONT_STUB(lgfx_efont_cn_16)
+FONT_STUB(lgfx_efont_cn_16_b)
+FONT_STUB(lgfx_efont_cn_16_bi)
+FONT_STUB(lgfx_efont_cn_16_i)
+FONT_STUB(lgfx_efont_cn_24)
+FONT_STUB(lgfx_efont_cn_24_b)
+FONT_STUB(lgfx_efont_cn_24_bi)
+FONT_STUB(lgfx_efont_cn_24_i)
+
+/* efont/lgfx_efont_ja.h */
+FONT_STUB(lgfx_efont_ja_10)
+FONT_STUB(lgfx_efont_ja_10_b)
+FONT_STUB(lgfx_efont_ja_10_bi)
+FONT_STUB(lgfx_efont_ja_10_i)
+FONT_STUB(lgfx_efont_ja_12)
+FONT_STUB(lgfx_efont_ja_12_b)
+FONT_STUB(lgfx_efont_ja_12_bi)
+FONT_STUB(lgfx_efont_ja_12_i)
+FONT_STUB(lgfx_efont_ja_14)
+FONT_STUB(lgfx_efont_ja_14_b)
+FONT_STUB(lgfx_efont_ja_14_bi)
+FONT_STUB(lgfx_efont_ja_14_i)
+FONT_STUB(lgfx_efont_ja_16)
+FONT_STUB(lgfx_efont_ja_16_b)
+FONT_STUB(lgfx_efont_ja_16_bi)
+FONT_STUB(lgfx_efont_ja_16_i)
+FONT_STUB(lgfx_efont_ja_24)
+FONT_STUB(lgfx_efont_ja_24_b)
+FONT_STUB(lgfx_efont_ja_24_bi)
+FONT_STUB(lgfx_efont_ja_24_i)
+
+/* efont/lgfx_efont_kr.h */
+FONT_STUB(lgfx_efont_kr_10)
+FONT_STUB(lgfx_efont_kr_10_b)
+FONT_STUB(lgfx_efont_kr_10_bi)
+FONT_STUB(lgfx_efont_kr_10_i)
+FONT_STUB(lgfx_efont_kr_12)
+FONT_STUB(lgfx_efont_kr_12_b)
+FONT_STUB(lgfx_efont_kr_12_bi)
+FONT_STUB(lgfx_efont_kr_12_i)
+FONT_STUB(lgfx_efont_kr_14)
+FONT_STUB(lgfx_efont_kr_14_b)
+FONT_STUB(lgfx_efont_kr_14_bi)
+FONT_STUB(lgfx_efont_kr_14_i)
+FONT_STUB(lgfx_efont_kr_16)
+FONT_STUB(lgfx_efont_kr_16_b)
+FONT_STUB(lgfx_efont_kr_16_bi)
+FONT_STUB(lgfx_efont_kr_16_i)
+FONT_STUB(lgfx_efont_kr_24)
+FONT_STUB(lgfx_efont_kr_24_b)
+FONT_STUB(lgfx_efont_kr_24_bi)
+FONT_STUB(lgfx_efont_kr_24_i)
+
+/* efont/lgfx_efont_tw.h */
+FONT_STUB(lgfx_efont_tw_10)
+FONT_STUB(lgfx_efont_tw_10_b)
+FONT_STUB(lgfx_efont_tw_10_bi)
+FONT_STUB(lgfx_efont_tw_10_i)
+FONT_STUB(lgfx_efont_tw_12)
+FONT_STUB(lgfx_efont_tw_12_b)
+FONT_STUB(lgfx_efont_tw_12_bi)
+FONT_STUB(lgfx_efont_tw_12_i)
+FONT_STUB(lgfx_efont_tw_14)
+FONT_STUB(lgfx_efont_tw_14_b)
+FONT_STUB(lgfx_efont_tw_14_bi)
+FONT_STUB(lgfx_efont_tw_14_i)
+FONT_STUB(lgfx_efont_tw_16)
+FONT_STUB(lgfx_efont_tw_16_b)
+FONT_STUB(lgfx_efont_tw_16_bi)
+FONT_STUB(lgfx_efont_tw_16_i)
+FONT_STUB(lgfx_efont_tw_24)
+FONT_STUB(lgfx_efont_tw_24_b)
+FONT_STUB(lgfx_efont_tw_24_bi)
+FONT_STUB(lgfx_efont_tw_24_i)
+
+/* IPA/lgfx_font_japan.h */
+FONT_STUB(lgfx_font_japan_mincho_8)
+FONT_STUB(lgfx_font_japan_mincho_12)
+FONT_STUB(lgfx_font_japan_mincho_16)
+FONT_STUB(lgfx_font_japan_mincho_20)
+FONT_STUB(lgfx_font_japan_mincho_24)
+FONT_STUB(lgfx_font_japan_mincho_28)
+FONT_STUB(lgfx_font_japan_mincho_32)
+FONT_STUB(lgfx_font_japan_mincho_36)
+FONT_STUB(lgfx_font_japan_mincho_40)
+FONT_STUB(lgfx_font_japan_mincho_p_8)
+FONT_STUB(lgfx_font_japan_mincho_p_12)
+FONT_STUB(lgfx_font_japan_mincho_p_16)
+FONT_STUB(lgfx_font_japan_mincho_p_20)
+FONT_STUB(lgfx_font_japan_mincho_p_24)
+FONT_STUB(lgfx_font_japan_mincho_p_28)
+FONT_STUB(lgfx_font_japan_mincho_p_32)
+FONT_STUB(lgfx_font_japan_mincho_p_36)
+FONT_STUB(lgfx_font_japan_mincho_p_40)
+FONT_STUB(lgfx_font_japan_gothic_8)
+FONT_STUB(lgfx_font_japan_gothic_12)
+FONT_STUB(lgfx_font_japan_gothic_16)
+FONT_STUB(lgfx_font_japan_gothic_20)
+FONT_STUB(lgfx_font_japan_gothic_24)
+FONT_STUB(lgfx_font_japan_gothic_28)
+FONT_STUB(lgfx_font_japan_gothic_32)
+FONT_STUB(lgfx_font_japan_gothic_36)
+FONT_STUB(lgfx_font_japan_gothic_40)
+FONT_STUB(lgfx_font_japan_gothic_p_8)
+FONT_STUB(lgfx_font_japan_gothic_p_12)
+FONT_STUB(lgfx_font_japan_gothic_p_16)
+FONT_STUB(lgfx_font_japan_gothic_p_20)
+FONT_STUB(lgfx_font_japan_gothic_p_24)
+FONT_STUB(lgfx_font_japan_gothic_p_28)
+FONT_STUB(lgfx_font_japan_gothic_p_32)
+FONT_STUB(lgfx_font_japan_gothic_p_36)
+FONT_STUB(lgfx_font_japan_gothic_p_40)
@@ -0,0 +1,24 @@
+# M5GFX sources for the host tools, shared by their CMakeLists.txt:
+#
+#   set(M5GFX_HOST_PLATFORM sdl)  # optional, framebuffer by default
+#   include(${CMAKE_CURRENT_SOURCE_DIR}/../m5gfx_host/m5gfx_host.cmake)
+#   add_executable(my_tool src/main.cpp ${M5GFX_HOST_SOURCES})
+#
+# The efont and IPA tables that lgfx_fonts.cpp refers to are not part of this
+# tree. font_stubs.c defines them as fonts without glyphs, so every other
+# symbol is still checked by the linker.
+
+if(NOT M5GFX_HOST_PLATFORM)
+	set(M5GFX_HOST_PLATFORM framebuffer)
+endif()
+
+set(M5GFX_HOST_ROOT ${CMAKE_CURRENT_LIST_DIR}/../../libraries/M5GFX/src)
+
+file(GLOB M5GFX_HOST_SOURCES
+	${M5GFX_HOST_ROOT}/lgfx/v1/*.cpp
+	${M5GFX_HOST_ROOT}/lgfx/v1/misc/*.cpp
+	${M5GFX_HOST_ROOT}/lgfx/v1/panel/*.cpp
+	${M5GFX_HOST_ROOT}/lgfx/v1/platforms/${M5GFX_HOST_PLATFORM}/*.cpp
+	${M5GFX_HOST_ROOT}/lgfx/utility/*.c
+)
+list(APPEND M5GFX_HOST_SOURCES ${CMAKE_CURRENT_LIST_DIR}/font_stubs.c)
@@ -0,0 +1,364 @@
+// numeral_atlas: renders the digits and punctuation of an M5GFX font at a fixed size and color
+// pair and writes them as an RLE compressed lgfx::numeral_atlas_t header for drawAtlasString.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <M5GFX.h>
+
+namespace {
+
+struct Options {
+    std::string font = "DejaVu72";
+    float size = 1.0f;
+    uint32_t fg = 0xFFFFFF;
+    uint32_t bg = 0x000000;
+    int depth = 16;
+    std::string chars = "0123456789 +-.,:/%";
+    std::string name;
+    std::string output;
+    bool selftest = false;
+};
+
+struct FontEntry {
+    const char* name;
+    const lgfx::IFont* font;
+};
+
+const FontEntry font_table[] = {
+    {"Font0", &fonts::Font0},       {"Font2", &fonts::Font2},       {"Font4", &fonts::Font4},
+    {"Font6", &fonts::Font6},       {"Font7", &fonts::Font7},       {"Font8", &fonts::Font8},
+    {"DejaVu9", &fonts::DejaVu9},   {"DejaVu12", &fonts::DejaVu12}, {"DejaVu18", &fonts::DejaVu18},
+    {"DejaVu24", &fonts::DejaVu24}, {"DejaVu40", &fonts::DejaVu40}, {"DejaVu56", &fonts::DejaVu56},
+    {"DejaVu72", &fonts::DejaVu72},
+    {"FreeSansBold12pt7b", &fonts::FreeSansBold12pt7b},
+    {"FreeSansBold18pt7b", &fonts::FreeSansBold18pt7b},
+    {"FreeSansBold24pt7b", &fonts::FreeSansBold24pt7b},
+};
+
+const lgfx::IFont* find_font(const std::string& name) {
+    for (const auto& f : font_table) {
+        if (name == f.name) return f.font;
+    }
+    return nullptr;
+}
+
+struct Glyph {
+    uint16_t code = 0;
+    int16_t x = 0;
+    uint16_t width = 0;
+    uint16_t advance = 0;
+    std::vector<uint8_t> rle;
+};
+
+struct Atlas {
+    uint16_t height = 0;
+    uint16_t baseline = 0;
+    lgfx::color_depth_t depth = lgfx::rgb565_2Byte;
+    std::vector<Glyph> glyphs;
+    std::vector<uint8_t> data;
+    std::vector<lgfx::atlas_glyph_t> table;
+
+    lgfx::numeral_atlas_t view(uint32_t fg, uint32_t bg) const {
+        return {data.data(), table.data(), (uint16_t)table.size(), height, baseline, depth, fg, bg};
+    }
+};
+
+std::vector<uint16_t> decode_utf8(const std::string& s) {
+    std::vector<uint16_t> codes;
+    for (size_t i = 0; i < s.size();) {
+        uint8_t c = s[i];
+        if (c < 0x80) { codes.push_back(c); i += 1; }
+        else if ((c & 0xE0) == 0xC0 && i + 1 < s.size()) { codes.push_back(((c & 0x1F) << 6) | (s[i + 1] & 0x3F)); i += 2; }
+        else if ((c & 0xF0) == 0xE0 && i + 2 < s.size()) {
+            codes.push_back(((c & 0x0F) << 12) | ((s[i + 1] & 0x3F) << 6) | (s[i + 2] & 0x3F));
+            i += 3;
+        }
+        else ++i;
+    }
+    return codes;
+}
+
+std::string encode_utf8(uint16_t code) {
+    std::string s;
+    if (code < 0x80) s += (char)code;
+    else if (code < 0x800) { s += (char)(0xC0 | (code >> 6)); s += (char)(0x80 | (code & 0x3F)); }
+    else {
+        s += (char)(0xE0 | (code >> 12));
+        s += (char)(0x80 | ((code >> 6) & 0x3F));
+        s += (char)(0x80 | (code & 0x3F));
+    }
+    return s;
+}
+
+// Runs of three or more equal pixels become fills, everything else is copied as literals.
+void encode_rle(const uint8_t* px, uint32_t count, uint32_t bytes, std::vector<uint8_t>& out) {
+    auto same = [&](uint32_t a, uint32_t b) { return !memcmp(px + a * bytes, px + b * bytes, bytes); };
+    uint32_t i = 0;
+    while (i < count) {
+        uint32_t run = 1;
+        while (i + run < count && run < 128 && same(i, i + run)) ++run;
+        if (run >= 3) {
+            out.push_back(run - 1);
+            out.insert(out.end(), px + i * bytes, px + (i + 1) * bytes);
+            i += run;
+            continue;
+        }
+        uint32_t start = i;
+        uint32_t n = 0;
+        while (i < count && n < 128) {
+            if (i + 2 < count && same(i, i + 1) && same(i, i + 2)) break;
+            ++i;
+            ++n;
+        }
+        out.push_back(0x80 | (n - 1));
+        out.insert(out.end(), px + start * bytes, px + i * bytes);
+    }
+}
+
+void setup_sprite(LGFX_Sprite& spr, const Options& opt, const lgfx::IFont* font) {
+    spr.setColorDepth(opt.depth == 8 ? lgfx::grayscale_8bit : lgfx::rgb565_2Byte);
+    spr.setFont(font);
+    spr.setTextSize(opt.size);
+    spr.setTextColor(opt.fg, opt.bg);
+    spr.setTextDatum(lgfx::top_left);
+}
+
+// Draws the glyph alone onto a black and onto a white canvas. The pixels that match are the ones
+// drawString wrote, they have to form a rectangle of the full font height.
+bool render_glyph(const Options& opt, const lgfx::IFont* font, uint16_t code, Glyph& g, Atlas& atlas, std::string& err) {
+    LGFX_Sprite a, b;
+    setup_sprite(a, opt, font);
+    setup_sprite(b, opt, font);
+    int32_t height = a.fontHeight();
+    int32_t width = 64 + height * 4;
+    int32_t pen0 = width / 3;
+    if (!a.createSprite(width, height) || !b.createSprite(width, height)) {
+        err = "out of memory";
+        return false;
+    }
+    std::string str = encode_utf8(code);
+    a.fillSprite(0x000000u);
+    b.fillSprite(0xFFFFFFu);
+    int32_t advance = a.drawString(str.c_str(), pen0, 0);
+    b.drawString(str.c_str(), pen0, 0);
+
+    lgfx::FontMetrics m;
+    font->getDefaultMetric(&m);
+    font->updateFontMetric(&m, code);
+    int32_t sx = 65536 * opt.size;
+    int32_t lead = m.x_offset < 0 ? (-(m.x_offset * sx)) >> 16 : 0;
+    advance -= lead;
+
+    uint32_t bytes = opt.depth / 8;
+    auto pa = (const uint8_t*)a.getBuffer();
+    auto pb = (const uint8_t*)b.getBuffer();
+    int32_t l = width, r = -1, t = height, btm = -1;
+    for (int32_t y = 0; y < height; ++y) {
+        for (int32_t x = 0; x < width; ++x) {
+            uint32_t i = (y * width + x) * bytes;
+            if (memcmp(pa + i, pb + i, bytes)) continue;
+            l = std::min(l, x); r = std::max(r, x);
+            t = std::min(t, y); btm = std::max(btm, y);
+        }
+    }
+    if (r < 0) {
+        err = "glyph not in font";
+        return false;
+    }
+    if (t != 0 || btm != height - 1) {
+        err = "glyph does not cover the font height";
+        return false;
+    }
+    for (int32_t y = 0; y < height; ++y) {
+        for (int32_t x = l; x <= r; ++x) {
+            uint32_t i = (y * width + x) * bytes;
+            if (memcmp(pa + i, pb + i, bytes)) {
+                err = "glyph cell is not opaque";
+                return false;
+            }
+        }
+    }
+
+    g.code = code;
+    g.x = l - (pen0 + lead);
+    g.width = r - l + 1;
+    g.advance = advance;
+    std::vector<uint8_t> cell;
+    for (int32_t y = 0; y < height; ++y) {
+        auto row = pa + (y * width + l) * bytes;
+        cell.insert(cell.end(), row, row + g.width * bytes);
+    }
+    encode_rle(cell.data(), g.width * height, bytes, g.rle);
+
+    atlas.height = height;
+    atlas.baseline = (m.baseline * (int32_t)(65536 * opt.size)) >> 16;
+    return true;
+}
+
+bool build_atlas(const Options& opt, Atlas& atlas) {
+    auto font = find_font(opt.font);
+    if (!font) {
+        fprintf(stderr, "unknown font %s\n", opt.font.c_str());
+        return false;
+    }
+    atlas.depth = opt.depth == 8 ? lgfx::grayscale_8bit : lgfx::rgb565_2Byte;
+    auto codes = decode_utf8(opt.chars);
+    std::sort(codes.begin(), codes.end());
+    codes.erase(std::unique(codes.begin(), codes.end()), codes.end());
+    for (uint16_t code : codes) {
+        Glyph g;
+        std::string err;
+        if (!render_glyph(opt, font, code, g, atlas, err)) {
+            fprintf(stderr, "%s U+%04X: %s\n", opt.font.c_str(), code, err.c_str());
+            return false;
+        }
+        atlas.table.push_back({g.code, g.x, g.width, g.advance, (uint32_t)atlas.data.size()});
+        atlas.data.insert(atlas.data.end(), g.rle.begin(), g.rle.end());
+        atlas.glyphs.push_back(std::move(g));
+    }
+    return true;
+}
+
+std::string default_name(const Options& opt) {
+    std::string name = opt.font;
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    return name + (opt.depth == 8 ? "_gray" : "_565");
+}
+
+void write_header(FILE* fp, const Options& opt, const Atlas& atlas, const std::string& name) {
+    fprintf(fp, "// generated by tools/numeral_atlas --font %s --size %g --fg 0x%06X --bg 0x%06X --depth %d\n",
+            opt.font.c_str(), opt.size, opt.fg, opt.bg, opt.depth);
+    uint32_t raw = 0;
+    for (const auto& g : atlas.glyphs) raw += g.width * atlas.height * (opt.depth / 8);
+    fprintf(fp, "// %zu glyphs, %zu bytes (%u bytes uncompressed)\n", atlas.glyphs.size(), atlas.data.size(), raw);
+    fprintf(fp, "#pragma once\n\n#include <lgfx/v1/misc/numeral_atlas.hpp>\n\n");
+    fprintf(fp, "namespace atlas_%s\n{\n", name.c_str());
+    fprintf(fp, "  static constexpr uint8_t data[] =\n  {");
+    for (const auto& g : atlas.glyphs) {
+        fprintf(fp, "\n    // U+%04X", g.code);
+        for (size_t i = 0; i < g.rle.size(); ++i) {
+            fprintf(fp, "%s0x%02X,", (i % 16) ? " " : "\n    ", g.rle[i]);
+        }
+    }
+    fprintf(fp, "\n  };\n\n");
+    fprintf(fp, "  static constexpr lgfx::atlas_glyph_t glyphs[] =\n  {\n");
+    for (const auto& t : atlas.table) {
+        fprintf(fp, "    { 0x%04X, %d, %u, %u, %u },\n", t.code, t.x, t.width, t.advance, t.offset);
+    }
+    fprintf(fp, "  };\n}\n\n");
+    fprintf(fp, "static constexpr lgfx::numeral_atlas_t %s =\n", name.c_str());
+    fprintf(fp, "{ atlas_%s::data, atlas_%s::glyphs, %zu, %u, %u, lgfx::%s, 0x%06X, 0x%06X };\n",
+            name.c_str(), name.c_str(), atlas.table.size(), atlas.height, atlas.baseline,
+            opt.depth == 8 ? "grayscale_8bit" : "rgb565_2Byte", opt.fg, opt.bg);
+}
+
+// Compares drawAtlasString with drawString for a few strings, datums and clipped positions.
+int run_selftest() {
+    struct Config { const char* font; int depth; uint32_t fg, bg; lgfx::color_depth_t canvas; };
+    const Config configs[] = {
+        {"DejaVu72", 16, 0xFFFFFF, 0x000000, lgfx::rgb565_2Byte},
+        {"DejaVu40", 16, 0xF8A010, 0x102030, lgfx::rgb565_2Byte},
+        {"DejaVu18", 8, 0x000000, 0xFFFFFF, lgfx::grayscale_8bit},
+        {"Font2", 16, 0xFFFFFF, 0x000000, lgfx::rgb888_3Byte},
+        {"Font4", 16, 0x00FF00, 0x000000, lgfx::rgb565_2Byte},
+    };
+    const char* strings[] = {"0123456789", "-12.5", "88:88", "1/2%", "+3, 4"};
+    const lgfx::textdatum_t datums[] = {lgfx::top_left, lgfx::middle_center, lgfx::baseline_right, lgfx::bottom_left};
+    const int32_t positions[][2] = {{20, 30}, {-17, 10}, {200, -9}, {300, 100}};
+
+    int failed = 0;
+    int cases = 0;
+    for (const auto& cfg : configs) {
+        Options opt;
+        opt.font = cfg.font;
+        opt.depth = cfg.depth;
+        opt.fg = cfg.fg;
+        opt.bg = cfg.bg;
+        Atlas atlas;
+        if (!build_atlas(opt, atlas)) return 1;
+        auto view = atlas.view(opt.fg, opt.bg);
+
+        LGFX_Sprite expect, actual;
+        expect.setColorDepth(cfg.canvas);
+        actual.setColorDepth(cfg.canvas);
+        expect.createSprite(320, 160);
+        actual.createSprite(320, 160);
+        expect.setFont(find_font(cfg.font));
+        expect.setTextColor(cfg.fg, cfg.bg);
+        for (auto s : strings) {
+            for (auto datum : datums) {
+                for (const auto& pos : positions) {
+                    expect.fillSprite(0x405060u);
+                    actual.fillSprite(0x405060u);
+                    expect.setTextDatum(datum);
+                    size_t w0 = expect.drawString(s, pos[0], pos[1]);
+                    size_t w1 = actual.drawAtlasString(view, s, pos[0], pos[1], datum);
+                    ++cases;
+                    if (w0 != w1 || memcmp(expect.getBuffer(), actual.getBuffer(), expect.bufferLength())) {
+                        printf("MISMATCH %s depth %d \"%s\" datum %d at %d,%d\n", cfg.font, cfg.depth, s, datum, pos[0], pos[1]);
+                        ++failed;
+                    }
+                }
+            }
+        }
+    }
+    printf("%d of %d cases match drawString\n", cases - failed, cases);
+    return failed ? 1 : 0;
+}
+
+void usage() {
+    fprintf(stderr,
+            "usage: numeral_atlas [--font NAME] [--size S] [--fg RGB] [--bg RGB] [--depth 16|8]\n"
+            "                     [--chars TEXT] [--name NAME] [-o FILE]\n"
+            "       numeral_atlas --selftest\n"
+            "  --font NAME   M5GFX font, e.g. DejaVu72, DejaVu40, Font2 (default DejaVu72)\n"
+            "  --size S      text size (default 1)\n"
+            "  --fg / --bg   text and background color as 0xRRGGBB (default white on black)\n"
+            "  --depth 16|8  swap565 pixels for TFT panels, 8 bit grayscale for EPD (default 16)\n"
+            "  --chars TEXT  UTF-8 characters to include (default \"0123456789 +-.,:/%%\")\n"
+            "  --name NAME   variable name (default <font>_565 / <font>_gray)\n"
+            "  -o FILE       write the header to FILE instead of stdout\n"
+            "  --selftest    compare drawAtlasString with drawString and exit\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        bool has_value = i + 1 < argc;
+        if (a == "--selftest") opt.selftest = true;
+        else if (a == "--font" && has_value) opt.font = argv[++i];
+        else if (a == "--size" && has_value) opt.size = atof(argv[++i]);
+        else if (a == "--fg" && has_value) opt.fg = strtoul(argv[++i], nullptr, 0) & 0xFFFFFF;
+        else if (a == "--bg" && has_value) opt.bg = strtoul(argv[++i], nullptr, 0) & 0xFFFFFF;
+        else if (a == "--depth" && has_value) opt.depth = atoi(argv[++i]);
+        else if (a == "--chars" && has_value) opt.chars = argv[++i];
+        else if (a == "--name" && has_value) opt.name = argv[++i];
+        else if (a == "-o" && has_value) opt.output = argv[++i];
+        else { usage(); return 2; }
+    }
+    if (opt.selftest) return run_selftest();
+    if ((opt.depth != 16 && opt.depth != 8) || opt.size <= 0 || opt.fg == opt.bg || opt.chars.empty()) {
+        usage();
+        return 2;
+    }
+
+    Atlas atlas;
+    if (!build_atlas(opt, atlas)) return 1;
+
+    FILE* fp = stdout;
+    if (!opt.output.empty() && !(fp = fopen(opt.output.c_str(), "w"))) {
+        perror(opt.output.c_str());
+        return 1;
+    }
+    write_header(fp, opt, atlas, opt.name.empty() ? default_name(opt) : opt.name);
+    if (fp != stdout) fclose(fp);
+    return 0;
+}
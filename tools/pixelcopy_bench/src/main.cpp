@@ -0,0 +1,270 @@
+// pixelcopy_bench: throughput of the M5GFX pixel conversion paths for every source/destination
+// pair pushImage, pushSprite and pushAlphaImage use, compared with the scalar per-pixel loop.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <lgfx/v1/misc/pixelcopy.hpp>
+
+using namespace lgfx;
+
+namespace {
+
+typedef uint32_t (*copy_fn)(void*, uint32_t, uint32_t, pixelcopy_t*);
+
+struct Options {
+    bool verify = false;
+    uint32_t width = 320;
+    double seconds = 0.05;
+    std::string filter;
+};
+
+uint32_t rng_state = 0x12345678;
+
+uint32_t next_random() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+void fill_random(std::vector<uint8_t>& buf, bool alpha_extremes) {
+    for (size_t i = 0; i < buf.size(); ++i) buf[i] = next_random();
+    if (!alpha_extremes) return;
+    // make a third of the pixels fully transparent and a third opaque, alpha is the last byte
+    // of argb8888 and the first of bgra8888
+    for (size_t i = 0; i < buf.size(); i += 4) {
+        for (size_t j : {i, i + 3}) {
+            uint32_t r = next_random() % 3;
+            if (r == 0) buf[j] = 0;
+            else if (r == 1) buf[j] = 255;
+        }
+    }
+}
+
+// The per-pixel loops the kernels have to reproduce bit for bit. Kept scalar, as they run on the
+// ESP32 and as the library ran before the row kernels.
+#define SCALAR __attribute__((noinline, optimize("no-tree-vectorize")))
+template <typename TDst, typename TSrc>
+SCALAR void reference_rgb(void* dst, const void* src, uint32_t len, const void*, uint32_t) {
+    auto d = static_cast<TDst*>(dst);
+    auto s = static_cast<const TSrc*>(src);
+    for (uint32_t k = 0; k < len; ++k) d[k].set(color_convert<TDst, TSrc>(s[k].get()));
+}
+
+template <typename TDst, typename TPalette>
+SCALAR void reference_palette(void* dst, const void* src, uint32_t len, const void* palette, uint32_t bits) {
+    auto d = static_cast<TDst*>(dst);
+    auto s = static_cast<const uint8_t*>(src);
+    auto pal = static_cast<const TPalette*>(palette);
+    for (uint32_t k = 0; k < len; ++k) {
+        uint32_t i = k * bits;
+        uint32_t raw = (s[i >> 3] >> (-(int32_t)(i + bits) & 7)) & ((1 << bits) - 1);
+        d[k].set(color_convert<TDst, TPalette>(pal[raw].get()));
+    }
+}
+
+template <typename TDst, typename TSrc>
+SCALAR void reference_blend(void* dst, const void* src, uint32_t len, const void*, uint32_t) {
+    auto d = static_cast<TDst*>(dst);
+    auto s = static_cast<const TSrc*>(src);
+    for (uint32_t k = 0; k < len; ++k) {
+        uint_fast16_t a = s[k].a;
+        if (!a) continue;
+        if (a == 255) { d[k].set(s[k].R8(), s[k].G8(), s[k].B8()); continue; }
+        uint_fast16_t inv = 256 - a;
+        ++a;
+        d[k].set((d[k].R8() * inv + s[k].R8() * a) >> 8,
+                 (d[k].G8() * inv + s[k].G8() * a) >> 8,
+                 (d[k].B8() * inv + s[k].B8() * a) >> 8);
+    }
+}
+
+enum Path { PATH_FAST, PATH_AFFINE, PATH_PALETTE, PATH_BLEND };
+
+struct Case {
+    std::string name;
+    Path path;
+    copy_fn fn;
+    void (*reference)(void*, const void*, uint32_t, const void*, uint32_t);
+    uint32_t src_bytes;   // per pixel, 0 for packed palette indices
+    uint32_t dst_bytes;
+    uint32_t bits;        // palette index bits
+    uint32_t pal_bytes;
+};
+
+struct Result {
+    double mpx = 0;
+    double ref_mpx = 0;
+    bool match = true;
+};
+
+void setup_pc(pixelcopy_t& pc, const Case& c, const void* src, const void* pal, uint32_t len) {
+    pc = pixelcopy_t();
+    pc.src_data = src;
+    pc.palette = pal;
+    pc.src_bits = c.bits;
+    pc.src_mask = (1 << c.bits) - 1;
+    pc.src_bitwidth = len;
+    pc.src_width = len;
+    pc.src_height = 1;
+    pc.fp_copy = c.fn;
+}
+
+// Runs the case over one row the way the panels call fp_copy.
+void run_case(const Case& c, void* dst, const void* src, const void* pal, uint32_t len) {
+    pixelcopy_t pc;
+    setup_pc(pc, c, src, pal, len);
+    c.fn(dst, 0, len, &pc);
+}
+
+double measure(const Options& opt, const std::function<void()>& body) {
+    using clock = std::chrono::steady_clock;
+    uint32_t rows = 0;
+    auto start = clock::now();
+    double elapsed = 0;
+    do {
+        for (int i = 0; i < 16; ++i) body();
+        rows += 16;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < opt.seconds);
+    return rows * (double)opt.width / elapsed / 1e6;
+}
+
+Result bench_case(const Case& c, const Options& opt) {
+    Result res;
+    uint32_t max_len = opt.width;
+    std::vector<uint8_t> src(c.src_bytes ? max_len * c.src_bytes : (max_len * c.bits + 7) / 8 + 4);
+    std::vector<uint8_t> pal(c.pal_bytes << c.bits);
+    std::vector<uint8_t> dst(max_len * c.dst_bytes + 4), ref(max_len * c.dst_bytes + 4);
+    fill_random(src, c.path == PATH_BLEND);
+    fill_random(pal, false);
+
+    if (opt.verify) {
+        // every length from 1 to 67 covers the vector tails, then the full row
+        std::vector<uint32_t> lengths;
+        for (uint32_t len = 1; len <= 67 && len < max_len; ++len) lengths.push_back(len);
+        lengths.push_back(max_len);
+        for (uint32_t len : lengths) {
+            fill_random(src, c.path == PATH_BLEND);
+            fill_random(dst, false);
+            ref = dst;
+            run_case(c, dst.data(), src.data(), pal.data(), len);
+            c.reference(ref.data(), src.data(), len, pal.data(), c.bits);
+            if (memcmp(dst.data(), ref.data(), len * c.dst_bytes)) {
+                res.match = false;
+                break;
+            }
+        }
+        return res;
+    }
+
+    res.mpx = measure(opt, [&] { run_case(c, dst.data(), src.data(), pal.data(), opt.width); });
+    res.ref_mpx = measure(opt, [&] { c.reference(ref.data(), src.data(), opt.width, pal.data(), c.bits); });
+    return res;
+}
+
+template <typename T> const char* type_name();
+template <> const char* type_name<rgb332_t>() { return "rgb332"; }
+template <> const char* type_name<swap565_t>() { return "swap565"; }
+template <> const char* type_name<rgb565_t>() { return "rgb565"; }
+template <> const char* type_name<bgr888_t>() { return "bgr888"; }
+template <> const char* type_name<rgb888_t>() { return "rgb888"; }
+template <> const char* type_name<bgr666_t>() { return "bgr666"; }
+template <> const char* type_name<grayscale_t>() { return "gray8"; }
+
+template <typename TDst, typename TSrc>
+void add_rgb(std::vector<Case>& cases) {
+    std::string pair = std::string(type_name<TSrc>()) + ">" + type_name<TDst>();
+    cases.push_back({"fast    " + pair, PATH_FAST, pixelcopy_t::copy_rgb_fast<TDst, TSrc>,
+                     reference_rgb<TDst, TSrc>, sizeof(TSrc), sizeof(TDst), 0, 0});
+    cases.push_back({"affine  " + pair, PATH_AFFINE, pixelcopy_t::copy_rgb_affine<TDst, TSrc>,
+                     reference_rgb<TDst, TSrc>, sizeof(TSrc), sizeof(TDst), 0, 0});
+}
+
+template <typename TDst>
+void add_dst(std::vector<Case>& cases) {
+    add_rgb<TDst, rgb332_t>(cases);
+    add_rgb<TDst, swap565_t>(cases);
+    add_rgb<TDst, rgb565_t>(cases);
+    add_rgb<TDst, bgr888_t>(cases);
+    add_rgb<TDst, rgb888_t>(cases);
+    add_rgb<TDst, grayscale_t>(cases);
+    for (uint32_t bits : {1u, 2u, 4u, 8u}) {
+        cases.push_back({"palette " + std::to_string(bits) + "bit>" + type_name<TDst>(), PATH_PALETTE,
+                         pixelcopy_t::copy_palette_fast<TDst, bgr888_t>, reference_palette<TDst, bgr888_t>,
+                         0, sizeof(TDst), bits, sizeof(bgr888_t)});
+    }
+}
+
+// argb8888_t for pushAlphaImage from memory, bgra8888_t for ARGB sprites and PNG lines
+template <typename TDst>
+void add_blend(std::vector<Case>& cases) {
+    cases.push_back({std::string("blend   argb8888>") + type_name<TDst>(), PATH_BLEND,
+                     pixelcopy_t::blend_rgb_fast<TDst, argb8888_t>, reference_blend<TDst, argb8888_t>,
+                     sizeof(argb8888_t), sizeof(TDst), 0, 0});
+    cases.push_back({std::string("blend   bgra8888>") + type_name<TDst>(), PATH_BLEND,
+                     pixelcopy_t::blend_rgb_fast<TDst, bgra8888_t>, reference_blend<TDst, bgra8888_t>,
+                     sizeof(bgra8888_t), sizeof(TDst), 0, 0});
+}
+
+std::vector<Case> all_cases() {
+    std::vector<Case> cases;
+    add_dst<rgb332_t>(cases);
+    add_dst<swap565_t>(cases);
+    add_dst<rgb565_t>(cases);
+    add_dst<bgr888_t>(cases);
+    add_dst<bgr666_t>(cases);
+    add_dst<grayscale_t>(cases);
+    add_blend<rgb332_t>(cases);
+    add_blend<swap565_t>(cases);
+    add_blend<bgr888_t>(cases);
+    add_blend<bgr666_t>(cases);
+    return cases;
+}
+
+void usage() {
+    fprintf(stderr,
+            "usage: pixelcopy_bench [--verify] [--width N] [--time S] [filter]\n"
+            "  --verify   compare every case with the per-pixel loop instead of timing it\n"
+            "  --width N  row length in pixels (default 320)\n"
+            "  --time S   seconds per measurement (default 0.05)\n"
+            "  filter     only cases whose name contains this text\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--verify") opt.verify = true;
+        else if (a == "--width" && i + 1 < argc) opt.width = strtoul(argv[++i], nullptr, 0);
+        else if (a == "--time" && i + 1 < argc) opt.seconds = atof(argv[++i]);
+        else if (a[0] != '-') opt.filter = a;
+        else { usage(); return 2; }
+    }
+    if (opt.width < 1) { usage(); return 2; }
+
+    int failed = 0;
+    if (!opt.verify) printf("%-28s %10s %10s %7s\n", "case", "Mpx/s", "scalar", "speedup");
+    for (const auto& c : all_cases()) {
+        if (!opt.filter.empty() && c.name.find(opt.filter) == std::string::npos) continue;
+        Result r = bench_case(c, opt);
+        if (opt.verify) {
+            if (!r.match) {
+                printf("MISMATCH %s\n", c.name.c_str());
+                ++failed;
+            }
+            continue;
+        }
+        printf("%-28s %10.1f %10.1f %6.2fx\n", c.name.c_str(), r.mpx, r.ref_mpx, r.mpx / r.ref_mpx);
+    }
+    if (opt.verify) printf("%s\n", failed ? "verify failed" : "all cases match the per-pixel loop");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,518 @@
+// sprite_pack: decodes PNG / JPEG / QOI / BMP images with the M5GFX decoders into the panel's
+// native pixel format and writes them as an lgfx sprite pack (misc/sprite_pack.hpp) with an id
+// header, so the device draws them with LGFX_SpritePack::push instead of decoding.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <M5GFX.h>
+
+namespace {
+
+struct Input {
+    std::string name;
+    std::string path;
+    bool keyed = false;
+    uint32_t key = 0;   // rgb888
+};
+
+struct Options {
+    std::string depth = "rgb565";
+    std::string encoding = "auto";
+    std::string output;
+    std::string header;
+    std::string name = "assets";
+    bool embed = false;
+    bool selftest = false;
+    std::vector<Input> inputs;
+};
+
+struct DepthEntry {
+    const char* name;
+    lgfx::color_depth_t depth;
+};
+
+const DepthEntry depth_table[] = {
+    {"rgb565", lgfx::rgb565_2Byte},
+    {"rgb888", lgfx::rgb888_3Byte},
+    {"rgb332", lgfx::rgb332_1Byte},
+    {"gray8", lgfx::grayscale_8bit},
+};
+
+const char* const encoding_names[] = {"raw", "rle", "qoi"};
+
+// One decoded image in the pack format.
+struct Image {
+    std::string name;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    bool keyed = false;
+    uint32_t transparent = 0;     // native pixel value
+    std::vector<uint8_t> pixels;  // width * height native pixels
+    uint8_t encoding = lgfx::sprite_pack_raw;
+    std::vector<uint8_t> encoded;
+};
+
+std::vector<uint8_t> read_file(const std::string& path) {
+    std::vector<uint8_t> data;
+    FILE* fp = fopen(path.c_str(), "rb");
+    if (!fp) return data;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) data.insert(data.end(), buf, buf + n);
+    fclose(fp);
+    return data;
+}
+
+uint32_t be16(const uint8_t* p) { return p[0] << 8 | p[1]; }
+uint32_t be32(const uint8_t* p) { return (uint32_t)p[0] << 24 | p[1] << 16 | p[2] << 8 | p[3]; }
+int32_t le32(const uint8_t* p) { return (int32_t)((uint32_t)p[3] << 24 | p[2] << 16 | p[1] << 8 | p[0]); }
+
+enum Format { FORMAT_UNKNOWN, FORMAT_PNG, FORMAT_JPG, FORMAT_QOI, FORMAT_BMP };
+
+// Reads the image size from the file header; the decoders only draw.
+Format probe(const std::vector<uint8_t>& d, uint32_t& w, uint32_t& h) {
+    size_t n = d.size();
+    if (n >= 24 && !memcmp(d.data(), "\x89PNG", 4)) {
+        w = be32(&d[16]);
+        h = be32(&d[20]);
+        return FORMAT_PNG;
+    }
+    if (n >= 14 && !memcmp(d.data(), "qoif", 4)) {
+        w = be32(&d[4]);
+        h = be32(&d[8]);
+        return FORMAT_QOI;
+    }
+    if (n >= 26 && d[0] == 'B' && d[1] == 'M') {
+        w = abs(le32(&d[18]));
+        h = abs(le32(&d[22]));
+        return FORMAT_BMP;
+    }
+    if (n >= 4 && d[0] == 0xFF && d[1] == 0xD8) {
+        for (size_t i = 2; i + 9 < n; ) {
+            if (d[i] != 0xFF) return FORMAT_UNKNOWN;
+            uint8_t m = d[i + 1];
+            if (m >= 0xC0 && m <= 0xCF && m != 0xC4 && m != 0xC8 && m != 0xCC) {
+                h = be16(&d[i + 5]);
+                w = be16(&d[i + 7]);
+                return FORMAT_JPG;
+            }
+            i += 2 + be16(&d[i + 2]);
+        }
+    }
+    return FORMAT_UNKNOWN;
+}
+
+uint32_t pixel_at(const uint8_t* p, uint32_t bytes) {
+    uint32_t v = p[0];
+    if (bytes > 1) v |= p[1] << 8;
+    if (bytes > 2) v |= p[2] << 16;
+    return v;
+}
+
+void put_pixel(std::vector<uint8_t>& out, uint32_t v, uint32_t bytes) {
+    for (uint32_t b = 0; b < bytes; ++b) out.push_back(v >> (b * 8));
+}
+
+std::vector<uint8_t> encode_rle(const std::vector<uint8_t>& px, uint32_t bytes) {
+    std::vector<uint8_t> out;
+    size_t count = px.size() / bytes;
+    auto at = [&](size_t i) { return pixel_at(&px[i * bytes], bytes); };
+    auto run_length = [&](size_t i, size_t limit) {
+        size_t r = 1;
+        while (i + r < count && r < limit && at(i + r) == at(i)) ++r;
+        return r;
+    };
+    for (size_t i = 0; i < count; ) {
+        size_t r = run_length(i, 128);
+        if (r >= 2) {
+            out.push_back(r - 1);
+            put_pixel(out, at(i), bytes);
+            i += r;
+            continue;
+        }
+        size_t n = 1;
+        while (i + n < count && n < 128 && run_length(i + n, 2) < 2) ++n;
+        out.push_back(0x80 | (n - 1));
+        out.insert(out.end(), &px[i * bytes], &px[(i + n) * bytes]);
+        i += n;
+    }
+    return out;
+}
+
+std::vector<uint8_t> encode_qoi(const std::vector<uint8_t>& px, uint32_t bytes) {
+    std::vector<uint8_t> out;
+    size_t count = px.size() / bytes;
+    auto at = [&](size_t i) { return pixel_at(&px[i * bytes], bytes); };
+    uint32_t index[64] = {};
+    uint32_t prev = 0;
+    auto run_length = [&](size_t i, uint32_t value, size_t limit) {
+        size_t r = 0;
+        while (i + r < count && r < limit && at(i + r) == value) ++r;
+        return r;
+    };
+    for (size_t i = 0; i < count; ) {
+        uint32_t v = at(i);
+        if (v == prev) {
+            size_t r = run_length(i, v, 64);
+            out.push_back(r - 1);
+            i += r;
+            continue;
+        }
+        uint32_t slot = lgfx::sprite_pack_hash(v);
+        if (index[slot] == v) {
+            out.push_back(0x40 | slot);
+            prev = v;
+            ++i;
+            continue;
+        }
+        size_t r = run_length(i, v, 64);
+        if (r >= 2) {
+            out.push_back(0xC0 | (r - 1));
+            put_pixel(out, v, bytes);
+            index[slot] = prev = v;
+            i += r;
+            continue;
+        }
+        // literals up to the next pixel a shorter token can express
+        size_t n = 0;
+        do {
+            uint32_t p = at(i + n);
+            index[lgfx::sprite_pack_hash(p)] = prev = p;
+            ++n;
+        } while (i + n < count && n < 64 && at(i + n) != prev
+                 && index[lgfx::sprite_pack_hash(at(i + n))] != at(i + n)
+                 && run_length(i + n, at(i + n), 2) < 2);
+        out.push_back(0x80 | (n - 1));
+        out.insert(out.end(), &px[i * bytes], &px[(i + n) * bytes]);
+        i += n;
+    }
+    return out;
+}
+
+// encoding: -1 picks the smallest, raw on a tie.
+void encode(Image& img, uint32_t bytes, int encoding) {
+    std::vector<uint8_t> candidates[3] = {img.pixels, {}, {}};
+    if (encoding != lgfx::sprite_pack_raw) {
+        candidates[1] = encode_rle(img.pixels, bytes);
+        candidates[2] = encode_qoi(img.pixels, bytes);
+    }
+    int best = encoding;
+    if (best < 0) {
+        best = 0;
+        for (int e = 1; e < 3; ++e) {
+            if (candidates[e].size() < candidates[best].size()) best = e;
+        }
+    }
+    img.encoding = best;
+    img.encoded = std::move(candidates[best]);
+}
+
+bool decode(const Input& in, lgfx::color_depth_t depth, Image& img) {
+    auto data = read_file(in.path);
+    uint32_t w = 0, h = 0;
+    Format format = probe(data, w, h);
+    if (format == FORMAT_UNKNOWN || !w || !h || w > 0xFFFF || h > 0xFFFF) {
+        fprintf(stderr, "%s: not a PNG, JPEG, QOI or BMP image\n", in.path.c_str());
+        return false;
+    }
+    LGFX_Sprite sprite;
+    sprite.setColorDepth(depth);
+    if (!sprite.createSprite(w, h)) {
+        fprintf(stderr, "%s: out of memory\n", in.path.c_str());
+        return false;
+    }
+    // transparent areas of the image keep the key color
+    sprite.fillSprite(in.key);
+    bool ok = false;
+    switch (format) {
+    case FORMAT_PNG: ok = sprite.drawPng(data.data(), data.size(), 0, 0); break;
+    case FORMAT_JPG: ok = sprite.drawJpg(data.data(), data.size(), 0, 0); break;
+    case FORMAT_QOI: ok = sprite.drawQoi(data.data(), data.size(), 0, 0); break;
+    case FORMAT_BMP: ok = sprite.drawBmp(data.data(), data.size(), 0, 0); break;
+    default: break;
+    }
+    if (!ok) {
+        fprintf(stderr, "%s: decode failed\n", in.path.c_str());
+        return false;
+    }
+    auto conv = sprite.getColorConverter();
+    img.name = in.name;
+    img.width = w;
+    img.height = h;
+    img.keyed = in.keyed;
+    img.transparent = in.keyed ? conv->convert_rgb888(in.key) & conv->colormask : 0;
+    auto buf = static_cast<const uint8_t*>(sprite.getBuffer());
+    img.pixels.assign(buf, buf + w * h * (conv->bits >> 3));
+    return true;
+}
+
+std::vector<uint8_t> build_pack(const std::vector<Image>& images, lgfx::color_depth_t depth) {
+    auto align = [](std::vector<uint8_t>& v) { v.resize((v.size() + 3) & ~3u); };
+    size_t data_start = sizeof(lgfx::sprite_pack_header_t) + images.size() * sizeof(lgfx::sprite_pack_entry_t);
+    std::vector<uint8_t> pack(data_start);
+    std::vector<lgfx::sprite_pack_entry_t> entries(images.size());
+    for (size_t i = 0; i < images.size(); ++i) {
+        const auto& img = images[i];
+        align(pack);
+        auto& e = entries[i];
+        e.width = img.width;
+        e.height = img.height;
+        e.encoding = img.encoding;
+        e.flags = img.keyed ? lgfx::sprite_pack_entry_t::flag_transparent : 0;
+        e.reserved = 0;
+        e.transparent = img.transparent;
+        e.offset = pack.size();
+        e.size = img.encoded.size();
+        pack.insert(pack.end(), img.encoded.begin(), img.encoded.end());
+    }
+    align(pack);
+    lgfx::sprite_pack_header_t header = {};
+    header.magic = lgfx::sprite_pack_magic;
+    header.version = lgfx::sprite_pack_version;
+    header.count = images.size();
+    header.depth = depth;
+    header.size = pack.size();
+    memcpy(pack.data(), &header, sizeof(header));
+    memcpy(pack.data() + sizeof(header), entries.data(), entries.size() * sizeof(lgfx::sprite_pack_entry_t));
+    return pack;
+}
+
+std::string identifier(const std::string& s) {
+    std::string id;
+    for (char c : s) id += isalnum((unsigned char)c) ? toupper((unsigned char)c) : '_';
+    return id;
+}
+
+bool write_header(const Options& opt, const std::vector<Image>& images, const std::vector<uint8_t>& pack) {
+    FILE* fp = fopen(opt.header.c_str(), "w");
+    if (!fp) {
+        perror(opt.header.c_str());
+        return false;
+    }
+    fprintf(fp, "// Generated by tools/sprite_pack, do not edit.\n");
+    fprintf(fp, "// %s, %zu images, %zu bytes\n#pragma once\n\n#include <stdint.h>\n\n", opt.depth.c_str(), images.size(), pack.size());
+    std::string prefix = identifier(opt.name);
+    fprintf(fp, "enum : uint16_t\n{\n");
+    for (size_t i = 0; i < images.size(); ++i) {
+        const auto& img = images[i];
+        fprintf(fp, "  %s_%s = %zu,  // %ux%u %s\n", prefix.c_str(), identifier(img.name).c_str(), i,
+                img.width, img.height, encoding_names[img.encoding]);
+    }
+    fprintf(fp, "};\n");
+    if (opt.embed) {
+        fprintf(fp, "\nalignas(4) static constexpr uint8_t %s_pack[%zu] =\n{", opt.name.c_str(), pack.size());
+        for (size_t i = 0; i < pack.size(); ++i) {
+            fprintf(fp, "%s0x%02x,", (i % 16) ? " " : "\n  ", pack[i]);
+        }
+        fprintf(fp, "\n};\n");
+    }
+    fclose(fp);
+    return true;
+}
+
+const DepthEntry* find_depth(const std::string& name) {
+    for (const auto& d : depth_table) {
+        if (name == d.name) return &d;
+    }
+    return nullptr;
+}
+
+int find_encoding(const std::string& name) {
+    for (int e = 0; e < 3; ++e) {
+        if (name == encoding_names[e]) return e;
+    }
+    return -1;
+}
+
+// A synthetic image with flat areas, gradients and noise, so every token type is produced.
+Image synthetic_image(lgfx::color_depth_t depth, uint32_t& rng) {
+    auto next = [&] { rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5; return rng; };
+    LGFX_Sprite sprite;
+    sprite.setColorDepth(depth);
+    sprite.createSprite(67, 45);
+    sprite.fillSprite(0x000000u);
+    for (int i = 0; i < 8; ++i) {
+        sprite.fillRect(next() % 67, next() % 45, next() % 30, next() % 20, next() & 0xFFFFFF);
+    }
+    for (int x = 0; x < 67; ++x) sprite.drawFastVLine(x, 30, 6, (uint32_t)(x * 3) << 8);
+    for (int i = 0; i < 200; ++i) sprite.drawPixel(next() % 67, 38 + next() % 7, next() & 0xFFFFFF);
+    auto conv = sprite.getColorConverter();
+    Image img;
+    img.name = "synthetic";
+    img.width = 67;
+    img.height = 45;
+    img.keyed = true;
+    img.transparent = conv->convert_rgb888(0) & conv->colormask;
+    auto buf = static_cast<const uint8_t*>(sprite.getBuffer());
+    img.pixels.assign(buf, buf + 67 * 45 * (conv->bits >> 3));
+    return img;
+}
+
+// Draws every entry of a pack in every encoding at clipped and unclipped positions through
+// LGFX_SpritePack and through pushSprite of the decoded image, and compares the results.
+int selftest(const Options& opt) {
+    int failed = 0;
+    int cases = 0;
+    uint32_t rng = 0x2545F491;
+    for (const auto& d : depth_table) {
+        std::vector<Image> images;
+        for (const auto& in : opt.inputs) {
+            Image img;
+            if (!decode(in, d.depth, img)) return 1;
+            images.push_back(std::move(img));
+        }
+        images.push_back(synthetic_image(d.depth, rng));
+        uint32_t bytes = (d.depth & lgfx::color_depth_t::bit_mask) >> 3;
+
+        LGFX_Sprite expected, actual, source;
+        for (auto* s : {&expected, &actual}) {
+            s->setColorDepth(d.depth);
+            s->createSprite(160, 120);
+        }
+        source.setColorDepth(d.depth);
+
+        for (int encoding = 0; encoding < 3; ++encoding) {
+            for (auto& img : images) encode(img, bytes, encoding);
+            auto pack = build_pack(images, d.depth);
+            lgfx::LGFX_SpritePack sp;
+            if (!sp.open(pack.data(), pack.size())) {
+                printf("FAILED to open the %s %s pack\n", d.name, encoding_names[encoding]);
+                ++failed;
+                continue;
+            }
+            // small strips run the double buffered path several times per image
+            sp.setStripBytes(encoding == 1 ? 64 : 1024);
+            const int positions[][2] = {{0, 0}, {7, 5}, {-13, -9}, {150, 100}, {-40, 90}, {120, -30}};
+            for (size_t id = 0; id < images.size(); ++id) {
+                const auto& img = images[id];
+                source.deleteSprite();
+                source.setBuffer(const_cast<uint8_t*>(img.pixels.data()), img.width, img.height);
+                for (int clip = 0; clip < 2; ++clip) {
+                    for (const auto& pos : positions) {
+                        for (auto* s : {&expected, &actual}) {
+                            s->clearClipRect();
+                            s->fillScreen(0x123456u);
+                            if (clip) s->setClipRect(11, 17, 101, 63);
+                        }
+                        if (img.keyed) {
+                            lgfx::pixelcopy_t pc(img.pixels.data(), d.depth, d.depth, false, nullptr, img.transparent);
+                            expected.pushImage(pos[0], pos[1], img.width, img.height, &pc);
+                        } else {
+                            source.pushSprite(&expected, pos[0], pos[1]);
+                        }
+                        sp.push(&actual, id, pos[0], pos[1]);
+                        ++cases;
+                        if (memcmp(expected.getBuffer(), actual.getBuffer(), 160 * 120 * bytes)) {
+                            printf("MISMATCH %s %s %s at %d,%d%s\n", d.name, encoding_names[encoding],
+                                   img.name.c_str(), pos[0], pos[1], clip ? " clipped" : "");
+                            ++failed;
+                        }
+                    }
+                }
+                source.deleteSprite();
+            }
+        }
+
+        // load() from a file copies the pack into memory
+        for (auto& img : images) encode(img, bytes, -1);
+        auto pack = build_pack(images, d.depth);
+        FILE* fp = tmpfile();
+        fwrite(pack.data(), 1, pack.size(), fp);
+        rewind(fp);
+        lgfx::DataWrapperT<FILE> file(fp);
+        lgfx::LGFX_SpritePack sp;
+        ++cases;
+        if (!sp.load(&file) || sp.getCount() != images.size() || sp.getColorDepth() != d.depth) {
+            printf("FAILED to load the %s pack from a file\n", d.name);
+            ++failed;
+        }
+        fclose(fp);
+    }
+    printf("%d of %d cases match pushSprite\n", cases - failed, cases);
+    return failed ? 1 : 0;
+}
+
+void usage() {
+    fprintf(stderr,
+            "usage: sprite_pack [--depth rgb565|rgb888|rgb332|gray8] [--encoding auto|raw|rle|qoi]\n"
+            "                   [-o PACK] [--header FILE] [--name NAME] [--embed] name=image[:RRGGBB] ...\n"
+            "       sprite_pack --selftest name=image[:RRGGBB] ...\n"
+            "  --depth     panel pixel format of the pack (default rgb565)\n"
+            "  --encoding  per image encoding, auto takes the smallest (default auto)\n"
+            "  -o PACK     write the pack, e.g. for a data partition or an SD card\n"
+            "  --header    write the image ids, NAME_<IMAGE>\n"
+            "  --name      prefix of the ids and of the embedded array (default assets)\n"
+            "  --embed     also put the pack into the header as NAME_pack[]\n"
+            "  :RRGGBB     transparent color; transparent image areas are filled with it\n"
+            "  --selftest  draw the images and a synthetic one through the pack and compare\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        bool has_value = i + 1 < argc;
+        if (a == "--depth" && has_value) opt.depth = argv[++i];
+        else if (a == "--encoding" && has_value) opt.encoding = argv[++i];
+        else if (a == "-o" && has_value) opt.output = argv[++i];
+        else if (a == "--header" && has_value) opt.header = argv[++i];
+        else if (a == "--name" && has_value) opt.name = argv[++i];
+        else if (a == "--embed") opt.embed = true;
+        else if (a == "--selftest") opt.selftest = true;
+        else if (a[0] != '-' && a.find('=') != std::string::npos) {
+            Input in;
+            in.name = a.substr(0, a.find('='));
+            in.path = a.substr(a.find('=') + 1);
+            auto colon = in.path.rfind(':');
+            if (colon != std::string::npos && in.path.size() - colon == 7) {
+                in.keyed = true;
+                in.key = strtoul(in.path.c_str() + colon + 1, nullptr, 16);
+                in.path.resize(colon);
+            }
+            opt.inputs.push_back(in);
+        }
+        else { usage(); return 2; }
+    }
+    if (opt.selftest) return selftest(opt);
+
+    auto depth = find_depth(opt.depth);
+    int encoding = find_encoding(opt.encoding);
+    if (!depth || (encoding < 0 && opt.encoding != "auto") || opt.inputs.empty()
+     || opt.inputs.size() > 0xFFFF || (opt.output.empty() && opt.header.empty())) {
+        usage();
+        return 2;
+    }
+
+    std::vector<Image> images;
+    size_t raw_total = 0;
+    for (const auto& in : opt.inputs) {
+        Image img;
+        if (!decode(in, depth->depth, img)) return 1;
+        encode(img, (depth->depth & lgfx::color_depth_t::bit_mask) >> 3, encoding);
+        raw_total += img.pixels.size();
+        fprintf(stderr, "%-16s %4ux%-4u %s %7zu bytes\n", img.name.c_str(), img.width, img.height,
+                encoding_names[img.encoding], img.encoded.size());
+        images.push_back(std::move(img));
+    }
+    auto pack = build_pack(images, depth->depth);
+    fprintf(stderr, "pack: %zu bytes, %zu raw\n", pack.size(), raw_total);
+
+    if (!opt.output.empty()) {
+        FILE* fp = fopen(opt.output.c_str(), "wb");
+        if (!fp || fwrite(pack.data(), 1, pack.size(), fp) != pack.size()) {
+            perror(opt.output.c_str());
+            if (fp) fclose(fp);
+            return 1;
+        }
+        fclose(fp);
+    }
+    if (!opt.header.empty() && !write_header(opt, images, pack)) return 1;
+    return 0;
+}